@@ -0,0 +1,141 @@
+#pragma once
+
+#include <QFuture>
+#include <QPromise>
+#include <QList>
+#include <QQueue>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QSharedPointer>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include "interceptor.h"
+
+class QThread;
+
+namespace QtMyBatisORM {
+
+class Session;
+class ConnectionPool;
+class CacheManager;
+class MapperRegistry;
+
+/**
+ * Worker threads behind the asynchronous Session API
+ * 异步Session API的工作线程
+ *
+ * QSqlDatabase connections are thread-affine, so every worker thread opens its
+ * own pooled connection on first use. The workerCount core workers keep theirs
+ * until shutdown; workers added by ensureWorkers() retire and release theirs as
+ * soon as the queue is empty. Submitted work goes into one shared queue and is
+ * picked up by whichever worker is idle; callers only enqueue and never block
+ * on the connection pool.
+ * 每个工作线程在首次使用时打开并独占一个连接池连接，扩容出的线程空闲即退出并归还连接。
+ */
+class AsyncExecutor
+{
+public:
+    AsyncExecutor(QSharedPointer<ConnectionPool> connectionPool,
+                  QSharedPointer<CacheManager> cacheManager,
+                  QSharedPointer<MapperRegistry> mapperRegistry,
+                  int workerCount);
+    ~AsyncExecutor();
+
+    /**
+     * @brief Run work on a worker thread's Session
+     * @return Future resolved with the result, or carrying the exception thrown by the work
+     */
+    template<typename R>
+    QFuture<R> submit(std::function<R(Session&)> work);
+
+    /**
+     * @brief Run work on a worker thread without a future
+     * @param work Called on the worker with its Session; must not throw
+     * @param onError Called instead of work when no worker connection can be opened or on shutdown
+     */
+    void post(std::function<void(Session&)> work, std::function<void(std::exception_ptr)> onError);
+
+    /**
+     * @brief Grow the worker pool to at least count threads for the work queued next
+     *
+     * Workers beyond the core count retire once the queue is empty after they ran a
+     * task, or after WorkerKeepAliveMs without one, and release their connections.
+     */
+    void ensureWorkers(int count);
+
+    /**
+     * @brief Interceptors for the executors of workers that have not opened their session yet
+     */
+    void setInterceptors(const InterceptorChain& interceptors);
+
+    /**
+     * @brief Fail queued work, then stop the workers and release their connections
+     */
+    void shutdown();
+
+    // Live workers plus any not started yet
+    int workerCount() const;
+    int pendingTasks() const;
+
+private:
+    struct Task
+    {
+        std::function<void(Session&)> run;
+        std::function<void(std::exception_ptr)> fail;
+    };
+
+    void enqueue(Task task);
+    void startWorkers();  // Caller holds m_mutex
+    void runWorker();
+    void reapFinishedWorkers();  // Caller holds m_mutex
+
+    static constexpr int WorkerKeepAliveMs = 5000;
+
+    QSharedPointer<ConnectionPool> m_connectionPool;
+    QSharedPointer<CacheManager> m_cacheManager;
+    QSharedPointer<MapperRegistry> m_mapperRegistry;
+    int m_coreWorkers;
+    int m_workerCount;
+    int m_liveWorkers = 0;
+
+    QList<QThread*> m_threads;
+    QQueue<Task> m_tasks;
+    mutable QMutex m_mutex;
+    QWaitCondition m_taskAvailable;
+    bool m_shutdown = false;
+    InterceptorChain m_interceptors;
+};
+
+template<typename R>
+QFuture<R> AsyncExecutor::submit(std::function<R(Session&)> work)
+{
+    // QPromise只能移动，由共享指针在任务的两个出口之间共享
+    auto promise = std::make_shared<QPromise<R>>();
+    QFuture<R> future = promise->future();
+    promise->start();
+
+    Task task;
+    task.run = [promise, work](Session& session) {
+        try {
+            if constexpr (std::is_void_v<R>) {
+                work(session);
+            } else {
+                promise->addResult(work(session));
+            }
+        } catch (...) {
+            promise->setException(std::current_exception());
+        }
+        promise->finish();
+    };
+    task.fail = [promise](std::exception_ptr error) {
+        promise->setException(error);
+        promise->finish();
+    };
+
+    enqueue(std::move(task));
+    return future;
+}
+
+} // namespace QtMyBatisORM
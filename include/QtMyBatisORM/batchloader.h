@@ -0,0 +1,123 @@
+#pragma once
+
+#include <QObject>
+#include <QPointer>
+#include <QHash>
+#include <QString>
+#include <QVariant>
+#include <QVariantList>
+#include <QSharedPointer>
+#include <exception>
+#include "export.h"
+
+namespace QtMyBatisORM {
+
+class Session;
+class BatchLoader;
+
+/**
+ * Deferred result of BatchLoader::load
+ *
+ * Reading the value of a result that has not been fetched yet dispatches the
+ * loader first, so a handle can always be read on the loader's thread.
+ */
+class QTMYBATISORM_EXPORT LoaderResult
+{
+public:
+    LoaderResult() = default;
+
+    bool isReady() const;
+
+    /**
+     * @brief The row for the key, or a null QVariant when no row matched
+     * @throws The exception of the batched query that was meant to load the key
+     */
+    QVariant value() const;
+
+private:
+    friend class BatchLoader;
+
+    struct State
+    {
+        QVariant value;
+        std::exception_ptr error;
+        bool ready = false;
+    };
+
+    LoaderResult(QSharedPointer<State> state, BatchLoader* loader);
+
+    QSharedPointer<State> m_state;
+    QPointer<BatchLoader> m_loader;
+};
+
+/**
+ * DataLoader-style coalescing of lookups by key
+ * 按键查询合并器（DataLoader模式）
+ *
+ * Keys requested through load() are queued instead of queried one by one. The
+ * queue is fetched with a single Session::selectMapByKeys call when dispatch()
+ * is called, when a pending value is read, or, with auto-dispatch on a thread
+ * with an event loop, at the end of the current event-loop tick. Every key is
+ * memoized for the loader's lifetime, so repeated lookups within the scope do
+ * not reach the database again; writes through the owning Session clear the memo.
+ *
+ * @code
+ * BatchLoader* classes = session->loader("Class.findByIds", "ids", "id");
+ * QList<LoaderResult> pending;
+ * for (const QVariant& student : students) {
+ *     pending.append(classes->load(student.toMap().value("class_id")));
+ * }
+ * // first value() runs one IN query for all class ids
+ * QVariant firstClass = pending.first().value();
+ * @endcode
+ */
+class QTMYBATISORM_EXPORT BatchLoader : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @param statementId Statement whose <foreach collection="keyParam"> receives the keys
+     * @param keyColumn Result column matched against the requested keys
+     */
+    BatchLoader(Session* session, const QString& statementId, const QString& keyParam,
+                const QString& keyColumn, QObject* parent = nullptr);
+
+    LoaderResult load(const QVariant& key);
+    QVariantList loadMany(const QVariantList& keys);
+
+    // Seed the memo with an already known row
+    void prime(const QVariant& key, const QVariant& value);
+
+    // Fetch every queued key with one batched query
+    void dispatch();
+
+    // Forget memoized results (all, or one key)
+    void clear();
+    void clear(const QVariant& key);
+
+    // Dispatch automatically at the end of the current event-loop tick (default on)
+    void setAutoDispatch(bool enabled);
+    bool autoDispatch() const;
+
+    int pendingCount() const;
+    int dispatchCount() const;
+
+private:
+    static QString keyString(const QVariant& key);
+    void scheduleDispatch();
+
+    QPointer<Session> m_session;
+    QString m_statementId;
+    QString m_keyParam;
+    QString m_keyColumn;
+
+    QHash<QString, QSharedPointer<LoaderResult::State>> m_results; // Memo, including pending keys
+    QVariantList m_pendingKeys;
+    QList<QSharedPointer<LoaderResult::State>> m_pendingStates;
+    bool m_autoDispatch = true;
+    bool m_dispatchScheduled = false;
+    int m_dispatchCount = 0;
+};
+
+} // namespace QtMyBatisORM
@@ -27,6 +27,11 @@ public:
     
     void invalidateByPattern(const QString& pattern);
     
+    // Write version of each table, bumped by every cache-invalidating write to it.
+    // Derived values such as page counts embed the versions in their cache keys.
+    quint64 tableVersion(const QString& tableName) const;
+    void bumpTableVersion(const QString& tableName);
+    
     bool contains(const QString& key) const;
     int size() const;
     bool isEnabled() const;
@@ -52,6 +57,7 @@ private:
     QString generateCacheKey(const QString& statementId, const QVariantMap& parameters);
     
     QHash<QString, CacheEntry> m_cache;
+    QHash<QString, quint64> m_tableVersions;
     QTimer* m_cleanupTimer;
     
     int m_maxSize;
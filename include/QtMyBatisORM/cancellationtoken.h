@@ -0,0 +1,44 @@
+#pragma once
+
+#include <QSharedPointer>
+#include <functional>
+#include "export.h"
+
+namespace QtMyBatisORM {
+
+/**
+ * Cooperative cancellation of running statements
+ * 查询取消令牌
+ *
+ * Copies share one state, so a token handed to Session::setCancellationToken
+ * can be cancelled from any other thread. The statement running with it is
+ * interrupted (SQLite through the driver handle, MySQL with KILL QUERY on a
+ * side connection) and fails with TimeoutException, code QUERY_CANCELLED;
+ * statements started afterwards fail before they reach the database.
+ *
+ * A default-constructed token is inert and can never be cancelled.
+ */
+class QTMYBATISORM_EXPORT CancellationToken
+{
+public:
+    CancellationToken() = default;
+    static CancellationToken create();
+
+    void cancel();
+    bool isCancelled() const;
+    bool isValid() const;
+
+    /**
+     * @brief Interrupt hook of the statement currently running with the token
+     *
+     * Set by the executor around execution and called by cancel(); a null
+     * handler clears it. Clearing waits for a concurrent call to return.
+     */
+    void setInterruptHandler(std::function<void()> handler) const;
+
+private:
+    struct State;
+    QSharedPointer<State> m_state;
+};
+
+} // namespace QtMyBatisORM
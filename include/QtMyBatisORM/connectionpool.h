@@ -13,6 +13,8 @@
 
 namespace QtMyBatisORM {
 
+class PreparedStatementCache;
+
 /**
  * Connection info structure for tracking connection idle time and statistics
  * 连接信息结构，用于跟踪连接的空闲时间和统计信息
@@ -50,11 +52,24 @@ public:
     QSharedPointer<QSqlDatabase> getConnection();
     void returnConnection(QSharedPointer<QSqlDatabase> connection);
     
+    // Connections owned by one thread (async workers): opened in the calling thread, counted
+    // against maxConnections and never handed out through the shared available queue.
+    // Idle shared connections count too: with no spare capacity this throws POOL_EXHAUSTED
+    // instead of closing a connection owned by another thread.
+    // Must be released from the same thread.
+    // 线程独占连接：在调用线程中打开，计入最大连接数，不进入共享的可用队列
+    QSharedPointer<QSqlDatabase> getThreadConnection();
+    void releaseThreadConnection(QSharedPointer<QSqlDatabase> connection);
+    
     void close();
     int availableConnections() const;
     int usedConnections() const;
     int totalConnections() const;
     
+    // Connections that can still be opened without closing an idle one
+    // 不关闭空闲连接的前提下还能新建的连接数
+    int spareConnections() const;
+    
     // Monitoring and health check methods
     ConnectionPoolStats getStats() const;
     ConnectionPoolHealth getHealthReport() const;
@@ -64,6 +79,11 @@ public:
     // Connection pool optimization methods
     void monitorConnectionUsage();
     
+    // Prepared statements live as long as the pooled connection, not the session
+    // 预编译语句随连接池连接存活，而不是随Session
+    QSharedPointer<PreparedStatementCache> getPreparedStatementCache(QSharedPointer<QSqlDatabase> connection);
+    PreparedStatementStats getPreparedStatementStats() const;
+    
 private slots:
     void cleanupIdleConnections();
     
@@ -85,6 +105,7 @@ private:
     // Statistics information
     mutable ConnectionPoolStats m_stats;
     QHash<QSharedPointer<QSqlDatabase>, ConnectionInfo> m_connectionInfoMap;
+    QHash<QSharedPointer<QSqlDatabase>, QSharedPointer<PreparedStatementCache>> m_statementCaches;
 };
 
 } // namespace QtMyBatisORM
\ No newline at end of file
@@ -0,0 +1,353 @@
+#pragma once
+
+#if !(__cplusplus >= 202002L || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L))
+#error "QtMyBatisORM/coro.h requires C++20, link against QtMyBatisORM::Coro"
+#endif
+
+#include "asyncexecutor.h"
+#include "sessionfactory.h"
+#include "session.h"
+#include "qtmybatisexception.h"
+#include <QAbstractEventDispatcher>
+#include <QMetaObject>
+#include <QPointer>
+#include <QDebug>
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <utility>
+
+namespace QtMyBatisORM {
+namespace Coro {
+
+template<typename T = void>
+class Task;
+
+namespace detail {
+
+struct PromiseBase
+{
+    std::coroutine_handle<> continuation;
+    std::exception_ptr error;
+    bool detached = false;
+
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    void unhandled_exception() noexcept { error = std::current_exception(); }
+};
+
+inline void reportUnobserved(const std::exception_ptr& error) noexcept
+{
+    if (!error) {
+        return;
+    }
+    try {
+        std::rethrow_exception(error);
+    } catch (const QtMyBatisException& e) {
+        qWarning() << "[QtMyBatisORM::Coro] Unobserved exception in detached task:" << e.message();
+    } catch (const std::exception& e) {
+        qWarning() << "[QtMyBatisORM::Coro] Unobserved exception in detached task:" << e.what();
+    } catch (...) {
+        qWarning() << "[QtMyBatisORM::Coro] Unobserved exception in detached task";
+    }
+}
+
+template<typename Promise>
+struct FinalAwaiter
+{
+    bool await_ready() const noexcept { return false; }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+    {
+        Promise& promise = handle.promise();
+        if (promise.continuation) {
+            return promise.continuation;
+        }
+        // Task对象已被丢弃，协程帧自行销毁
+        if (promise.detached) {
+            reportUnobserved(promise.error);
+            handle.destroy();
+        }
+        return std::noop_coroutine();
+    }
+
+    void await_resume() const noexcept {}
+};
+
+template<typename T>
+struct TaskPromise : PromiseBase
+{
+    std::optional<T> value;
+
+    Task<T> get_return_object() noexcept;
+    FinalAwaiter<TaskPromise> final_suspend() noexcept { return {}; }
+    void return_value(T result) { value.emplace(std::move(result)); }
+};
+
+template<>
+struct TaskPromise<void> : PromiseBase
+{
+    Task<void> get_return_object() noexcept;
+    FinalAwaiter<TaskPromise> final_suspend() noexcept { return {}; }
+    void return_void() noexcept {}
+};
+
+} // namespace detail
+
+/**
+ * Eagerly started coroutine returning T
+ * 立即开始执行的协程返回类型
+ *
+ * A Task runs until its first co_await on a query and may itself be awaited by
+ * another coroutine. Dropping an unfinished Task detaches it: the coroutine keeps
+ * running and frees itself on completion, logging any exception nobody observed.
+ */
+template<typename T>
+class Task
+{
+public:
+    using promise_type = detail::TaskPromise<T>;
+
+    Task() = default;
+    explicit Task(std::coroutine_handle<promise_type> handle) noexcept : m_handle(handle) {}
+    Task(Task&& other) noexcept : m_handle(std::exchange(other.m_handle, {})) {}
+    Task& operator=(Task&& other) noexcept
+    {
+        if (this != &other) {
+            release();
+            m_handle = std::exchange(other.m_handle, {});
+        }
+        return *this;
+    }
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    ~Task() { release(); }
+
+    bool isDone() const noexcept { return !m_handle || m_handle.done(); }
+
+    bool await_ready() const noexcept { return isDone(); }
+    void await_suspend(std::coroutine_handle<> awaiting) noexcept { m_handle.promise().continuation = awaiting; }
+    T await_resume()
+    {
+        promise_type& promise = m_handle.promise();
+        if (promise.error) {
+            std::rethrow_exception(promise.error);
+        }
+        if constexpr (!std::is_void_v<T>) {
+            return std::move(*promise.value);
+        }
+    }
+
+private:
+    void release() noexcept
+    {
+        if (!m_handle) {
+            return;
+        }
+        if (m_handle.done()) {
+            m_handle.destroy();
+        } else {
+            m_handle.promise().detached = true;
+        }
+        m_handle = {};
+    }
+
+    std::coroutine_handle<promise_type> m_handle;
+};
+
+namespace detail {
+
+template<typename T>
+Task<T> TaskPromise<T>::get_return_object() noexcept
+{
+    return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept
+{
+    return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+} // namespace detail
+
+/**
+ * Awaitable for one unit of work on an AsyncExecutor worker
+ * 在异步工作线程上执行一次操作的等待体
+ *
+ * The result lives in the awaitable, which sits in the suspended coroutine frame.
+ * Completion is delivered as a queued call to the awaiting thread's event
+ * dispatcher, so the coroutine resumes on the thread that suspended it without
+ * a QFutureWatcher or any other per-call QObject.
+ * 完成后通过调用线程的事件分发器排队恢复协程，不为每次调用创建QFutureWatcher。
+ */
+template<typename R>
+class Query
+{
+public:
+    Query(QSharedPointer<AsyncExecutor> executor, std::function<R(Session&)> work)
+        : m_executor(std::move(executor))
+        , m_work(std::move(work))
+    {
+    }
+
+    Query(const Query&) = delete;
+    Query& operator=(const Query&) = delete;
+
+    bool await_ready() const noexcept { return false; }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        QPointer<QAbstractEventDispatcher> dispatcher = QAbstractEventDispatcher::instance();
+        if (!dispatcher) {
+            throw ConfigurationException(
+                QStringLiteral("co_await on a query requires a thread with a Qt event dispatcher"));
+        }
+
+        auto resume = [dispatcher, handle]() {
+            if (dispatcher) {
+                QMetaObject::invokeMethod(dispatcher.data(), [handle]() { handle.resume(); },
+                                          Qt::QueuedConnection);
+            } else {
+                qWarning() << "[QtMyBatisORM::Coro] Awaiting thread has no event dispatcher, coroutine abandoned";
+            }
+        };
+
+        m_executor->post(
+            [this, resume](Session& session) {
+                try {
+                    if constexpr (std::is_void_v<R>) {
+                        m_work(session);
+                    } else {
+                        m_value.emplace(m_work(session));
+                    }
+                } catch (...) {
+                    m_error = std::current_exception();
+                }
+                resume();
+            },
+            [this, resume](std::exception_ptr error) {
+                m_error = error;
+                resume();
+            });
+    }
+
+    R await_resume()
+    {
+        if (m_error) {
+            std::rethrow_exception(m_error);
+        }
+        if constexpr (!std::is_void_v<R>) {
+            return std::move(*m_value);
+        }
+    }
+
+private:
+    using Storage = std::conditional_t<std::is_void_v<R>, bool, R>;
+
+    QSharedPointer<AsyncExecutor> m_executor;
+    std::function<R(Session&)> m_work;
+    std::optional<Storage> m_value;
+    std::exception_ptr m_error;
+};
+
+/**
+ * Awaitable front end of a SessionFactory
+ * SessionFactory的协程接口
+ *
+ * Every call returns a Query to co_await from a coroutine running on a thread
+ * with an event loop; the statement executes on one of the factory's async
+ * workers and the coroutine continues on the original thread.
+ *
+ * @code
+ * Coro::Task<> loadStudents(QSharedPointer<Coro::AsyncSession> session)
+ * {
+ *     QVariantList rows = co_await session->selectList("Student.findAll");
+ *     int count = co_await session->update("Student.touch", {{"id", 1}});
+ * }
+ * @endcode
+ */
+class AsyncSession
+{
+public:
+    explicit AsyncSession(const QSharedPointer<SessionFactory>& factory)
+        : m_executor(factory->asyncExecutor())
+    {
+    }
+
+    static QSharedPointer<AsyncSession> create(const QSharedPointer<SessionFactory>& factory)
+    {
+        return QSharedPointer<AsyncSession>::create(factory);
+    }
+
+    Query<QVariant> selectOne(const QString& statementId, const QVariantMap& parameters = {}) const
+    {
+        return run<QVariant>([statementId, parameters](Session& session) {
+            return session.selectOne(statementId, parameters);
+        });
+    }
+
+    Query<QVariantList> selectList(const QString& statementId, const QVariantMap& parameters = {}) const
+    {
+        return run<QVariantList>([statementId, parameters](Session& session) {
+            return session.selectList(statementId, parameters);
+        });
+    }
+
+    Query<ResultSet> selectResultSet(const QString& statementId, const QVariantMap& parameters = {}) const
+    {
+        return run<ResultSet>([statementId, parameters](Session& session) {
+            return session.selectResultSet(statementId, parameters);
+        });
+    }
+
+    Query<int> insert(const QString& statementId, const QVariantMap& parameters = {}) const
+    {
+        return run<int>([statementId, parameters](Session& session) {
+            return session.insert(statementId, parameters);
+        });
+    }
+
+    Query<int> update(const QString& statementId, const QVariantMap& parameters = {}) const
+    {
+        return run<int>([statementId, parameters](Session& session) {
+            return session.update(statementId, parameters);
+        });
+    }
+
+    Query<int> remove(const QString& statementId, const QVariantMap& parameters = {}) const
+    {
+        return run<int>([statementId, parameters](Session& session) {
+            return session.remove(statementId, parameters);
+        });
+    }
+
+    Query<int> execute(const QString& sql, const QVariantMap& parameters = {}) const
+    {
+        return run<int>([sql, parameters](Session& session) {
+            return session.execute(sql, parameters);
+        });
+    }
+
+    Query<int> batchInsert(const QString& statementId, const QList<QVariantMap>& parametersList,
+                           BatchStrategy strategy = BatchStrategy::ExecBatch) const
+    {
+        return run<int>([statementId, parametersList, strategy](Session& session) {
+            return session.batchInsert(statementId, parametersList, strategy);
+        });
+    }
+
+    /**
+     * @brief Run arbitrary work, e.g. a transaction, on a worker Session
+     */
+    template<typename R>
+    Query<R> run(std::function<R(Session&)> work) const
+    {
+        return Query<R>(m_executor, std::move(work));
+    }
+
+private:
+    QSharedPointer<AsyncExecutor> m_executor;
+};
+
+} // namespace Coro
+} // namespace QtMyBatisORM
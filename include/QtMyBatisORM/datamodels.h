@@ -2,11 +2,18 @@
 
 #include <QString>
 #include <QVariantMap>
+#include <QVariantList>
 #include <QHash>
 #include <QDateTime>
+#include <QSharedPointer>
+#include <functional>
+#include <optional>
+#include "cancellationtoken.h"
 
 namespace QtMyBatisORM {
 
+class SqlNode;
+
 /**
  * Database configuration structure
  */
@@ -28,11 +35,13 @@ struct DatabaseConfig
     int minConnections = 2;         // Fixed value
     int maxIdleTime = 300;          // Fixed value (seconds)
     int maxWaitTime = 5000;         // JSON: max_wait_time (milliseconds)
+    int asyncWorkerCount = 2;       // JSON: async_worker_count (threads of the async API, one connection each)
     
     // Cache configuration
     bool cacheEnabled = true;
     int maxCacheSize = 1000;
     int cacheExpireTime = 600;      // seconds
+    int preparedStatementCacheSize = 64;  // JSON: prepared_statement_cache_size (per connection, 0 disables)
     
     // SQL file list
     QStringList sqlFiles;           // JSON: sql_files
@@ -50,6 +59,24 @@ enum class StatementType
     DDL  // CREATE, ALTER, DROP, etc.
 };
 
+/**
+ * Per-statement execution options enforced by the executor
+ */
+struct StatementOptions
+{
+    bool useCache = false;    // Read and store results through the CacheManager
+    bool flushCache = false;  // Invalidate related cache entries when the statement runs
+    int timeout = 0;          // Seconds, 0 leaves the driver default
+    int fetchSize = 0;        // > 0 streams the result forward-only
+    int maxRows = 0;          // > 0 stops reading after this many rows
+    
+    // Per call, set by the Session
+    int callTimeoutMs = 0;    // > 0 replaces timeout for this call
+    CancellationToken cancellation;
+    
+    int effectiveTimeoutMs() const { return callTimeoutMs > 0 ? callTimeoutMs : timeout * 1000; }
+};
+
 /**
  * SQL statement configuration
  */
@@ -57,13 +84,106 @@ struct StatementConfig
 {
     QString id;
     QString sql;
-    StatementType type;
+    StatementType type = StatementType::SELECT;
     QString parameterType;
     QString resultType;
-    bool useCache = false;
+    std::optional<bool> useCache;    // Unset: SELECT reads through the cache, writes and DDL don't
+    std::optional<bool> flushCache;  // Unset: INSERT/UPDATE/DELETE flush, SELECT and DDL don't
+    int timeout = 0;
+    int fetchSize = 0;
+    int maxRows = 0;
+    bool useGeneratedKeys = false;  // Batch inserts report the generated key of every row
+    QString keyProperty;
+    QString keyColumn;              // Column read back with RETURNING, defaults to keyProperty
     QHash<QString, QString> dynamicElements;  // Dynamic elements like if, foreach, etc.
+    QSharedPointer<const SqlNode> sqlNode;    // Compiled SQL tree, built when the mapper is loaded
+    
+    StatementOptions options() const
+    {
+        StatementOptions result;
+        result.useCache = useCache.value_or(type == StatementType::SELECT);
+        result.flushCache = flushCache.value_or(type == StatementType::INSERT
+                                                || type == StatementType::UPDATE
+                                                || type == StatementType::DELETE);
+        result.timeout = timeout;
+        result.fetchSize = fetchSize;
+        result.maxRows = maxRows;
+        return result;
+    }
+    
+    QString generatedKeyColumn() const
+    {
+        return keyColumn.isEmpty() ? keyProperty : keyColumn;
+    }
+};
+
+/**
+ * Batch execution strategy
+ */
+enum class BatchStrategy
+{
+    ExecBatch,       // One prepared statement per distinct SQL, column-wise binding, QSqlQuery::execBatch
+    MultiRowValues   // INSERT ... VALUES (...) rewritten into chunked multi-row VALUES lists
+};
+
+/**
+ * Result of a batch execution
+ */
+struct BatchResult
+{
+    int totalAffected = 0;
+    QList<int> chunkAffectedRows;  // Affected rows of each executed statement, in execution order
+    QVariantList generatedKeys;    // useGeneratedKeys statements: one key per inserted row, in row order
 };
 
+/**
+ * One page of a Session::selectPage query
+ */
+struct PageResult
+{
+    QVariantList items;
+    qint64 total = 0;   // Rows of the whole query
+    int page = 1;       // 1-based
+    int pageSize = 0;
+    
+    int pageCount() const { return pageSize > 0 ? int((total + pageSize - 1) / pageSize) : 0; }
+    bool hasNext() const { return page < pageCount(); }
+};
+
+/**
+ * How a Session executes insert/update/remove
+ */
+enum class ExecutorType
+{
+    Simple,  // Every statement executes immediately
+    Batch    // Writes are queued per statement and SQL, then executed with execBatch on flush or commit
+};
+
+/**
+ * Affected rows of one queued statement group of a BATCH session
+ */
+struct BatchStatementResult
+{
+    QString statementId;
+    QString sql;           // Rendered SQL shared by the group
+    int rowCount = 0;      // Parameter sets executed
+    int affectedRows = 0;
+};
+
+/**
+ * One independent statement of a parallel fan-out
+ */
+struct ParallelStatement
+{
+    QString statementId;
+    QVariantMap parameters;
+};
+
+/**
+ * Row callback for streaming queries; return false to stop reading further rows
+ */
+using RowCallback = std::function<bool(const QVariantMap& row)>;
+
 /**
  * Mapper configuration
  */
@@ -158,4 +278,26 @@ struct CacheStats
     }
 };
 
+/**
+ * Prepared statement cache statistics
+ * 预编译语句缓存统计
+ */
+struct PreparedStatementStats
+{
+    int hitCount = 0;           // Statements reused without re-parsing;复用次数
+    int missCount = 0;          // Statements prepared by the driver;重新编译次数
+    int evictionCount = 0;      // LRU evictions;驱逐次数
+    int currentSize = 0;        // Cached statements;当前缓存语句数
+    int maxSize = 0;            // Maximum cached statements (per connection)
+    double hitRate = 0.0;       // Hit rate;命中率
+    
+    // Calculate hit rate
+    void updateHitRate() {
+        int totalRequests = hitCount + missCount;
+        if (totalRequests > 0) {
+            hitRate = static_cast<double>(hitCount) / totalRequests;
+        }
+    }
+};
+
 } // namespace QtMyBatisORM
\ No newline at end of file
@@ -4,13 +4,13 @@
 #include <QObject>
 #include <QString>
 #include <QVariantMap>
-#include <QRegularExpression>
+#include "sqlnode.h"
 
 namespace QtMyBatisORM {
 
 /**
  * @brief Dynamic SQL processor for handling MyBatis-style dynamic SQL statements
- * 
+ *
  * Supports the following dynamic SQL elements:
  * - #{param} - Parameter substitution
  * - <if test="condition">content</if> - Conditional judgment
@@ -18,6 +18,11 @@ namespace QtMyBatisORM {
  * - <choose><when test="condition">content</when><otherwise>content</otherwise></choose> - Choice
  * - <where>content</where> - WHERE clause handling
  * - <set>content</set> - SET clause handling
+ * - <trim prefix="..." prefixOverrides="..." suffix="..." suffixOverrides="...">content</trim>
+ *
+ * SQL text is compiled once into an SqlNode tree and cached; each call only
+ * evaluates the tree against the parameters.
+ * SQL文本只编译一次并缓存语法树，每次调用仅对参数求值
  */
 class DynamicSqlProcessor : public QObject
 {
@@ -34,80 +39,36 @@ public:
      */
     QString process(const QString& sql, const QVariantMap& parameters);
 
-private:
     /**
-     * @brief Process if conditions
-     * @param condition Condition expression
-     * @param content If content
+     * @brief Evaluate an already compiled statement
+     * @param root Compiled SQL tree
      * @param parameters Parameter mapping
-     * @return Processed content
-     */
-    QString processIf(const QString& condition, const QString& content, const QVariantMap& parameters);
-
-    /**
-     * @brief Process foreach loops
-     * @param collection Collection name
-     * @param item Item name
-     * @param content Foreach content
-     * @param parameters Parameter mapping
-     * @param separator Separator
-     * @param open Opening character
-     * @param close Closing character
-     * @return Processed content
-     */
-    QString processForeach(const QString& collection, const QString& item, 
-                          const QString& content, const QVariantMap& parameters,
-                          const QString& separator, const QString& open,
-                          const QString& close);
-
-    /**
-     * @brief Process choose/when/otherwise structure
-     * @param content Choose content
-     * @param parameters Parameter mapping
-     * @return Processed content
-     */
-    QString processChoose(const QString& content, const QVariantMap& parameters);
-
-    /**
-     * @brief Process where clause
-     * @param content Where content
-     * @param parameters Parameter mapping
-     * @return Processed content
-     */
-    QString processWhere(const QString& content, const QVariantMap& parameters);
-
-    /**
-     * @brief Process set clause
-     * @param content Set content
-     * @param parameters Parameter mapping
-     * @return Processed content
+     * @return Processed SQL statement
      */
-    QString processSet(const QString& content, const QVariantMap& parameters);
+    static QString process(const SqlNodePtr& root, const QVariantMap& parameters);
 
     /**
-     * @brief Evaluate condition expression
-     * @param condition Condition expression
+     * @brief Process SQL through the shape cache
+     *
+     * The parameters are reduced to an SqlShape first; SQL already generated for
+     * the same statement and shape is returned without walking the text nodes,
+     * and because the text is identical it also hits the prepared statement cache.
+     * 按形状签名缓存生成的SQL，形状相同时跳过SQL生成
+     *
+     * @param sql SQL statement containing dynamic elements
      * @param parameters Parameter mapping
-     * @return Whether condition is true
+     * @return Processed SQL statement
      */
-    bool evaluateCondition(const QString& condition, const QVariantMap& parameters);
+    static QString processCached(const QString& sql, const QVariantMap& parameters);
 
     /**
-     * @brief Replace parameter placeholders
-     * @param content Content containing parameter placeholders
-     * @param parameters Parameter mapping
-     * @return Content after replacement
+     * @brief Compile SQL text into an SqlNode tree, reusing a cached tree when available
+     * @param sql SQL statement containing dynamic elements
+     * @return Compiled SQL tree shared by all callers
      */
-    QString replaceParameters(const QString& content, const QVariantMap& parameters);
-
-private:
-    QRegularExpression m_ifPattern;       ///< Regular expression for if tags
-    QRegularExpression m_foreachPattern;  ///< Regular expression for foreach tags
-    QRegularExpression m_choosePattern;   ///< Regular expression for choose tags
-    QRegularExpression m_wherePattern;    ///< Regular expression for where tags
-    QRegularExpression m_setPattern;      ///< Regular expression for set tags
+    static SqlNodePtr compile(const QString& sql);
 };
 
 } // namespace QtMyBatisORM
 
-#endif // QTMYBATISORM_DYNAMICSQLPROCESSOR_H
\ No newline at end of file
+#endif // QTMYBATISORM_DYNAMICSQLPROCESSOR_H
@@ -2,11 +2,17 @@
 
 #include <QObject>
 #include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlDriver>
 #include <QVariant>
 #include <QVariantMap>
 #include <QVariantList>
 #include <QSharedPointer>
 #include <QMutex>
+#include "datamodels.h"
+#include "resultset.h"
+#include "interceptor.h"
+#include "statementhandle.h"
 
 namespace QtMyBatisORM {
 
@@ -14,6 +20,8 @@ class StatementHandler;
 class ParameterHandler;
 class ResultHandler;
 class CacheManager;
+class PreparedStatementCache;
+struct BindingPlan;
 
 /**
  * SQL executor
@@ -36,41 +44,201 @@ public:
     QVariantList queryListWithCache(const QString& statementId, const QString& sql, 
                                    const QVariantMap& parameters = {});
     
+    // Compact results: shared column header, row-major cells
+    ResultSet queryResultSet(const QString& sql, const QVariantMap& parameters = {},
+                             const StatementOptions& options = {});
+    ResultSet queryResultSetWithCache(const QString& statementId, const QString& sql,
+                                      const QVariantMap& parameters = {});
+    
     int updateWithCacheInvalidation(const QString& statementId, const QString& sql, 
                                    const QVariantMap& parameters = {});
     
+    // Mapped statements: caching, flushing, timeout and row limits follow the statement's options
+    QVariant queryWithCache(const QString& statementId, const QString& sql,
+                           const QVariantMap& parameters, const StatementOptions& options);
+    QVariantList queryListWithCache(const QString& statementId, const QString& sql,
+                                   const QVariantMap& parameters, const StatementOptions& options);
+    ResultSet queryResultSetWithCache(const QString& statementId, const QString& sql,
+                                      const QVariantMap& parameters, const StatementOptions& options);
+    int updateWithCacheInvalidation(const QString& statementId, const QString& sql,
+                                   const QVariantMap& parameters, const StatementOptions& options);
+    
+    // Pre-resolved statements: a static statement's SQL, binding plan and invalidated tables come
+    // from the compiled statement instead of the shared SQL-keyed lookup caches
+    QVariant queryWithCache(const CompiledStatement& statement, const QVariantMap& parameters,
+                           const StatementOptions& options);
+    QVariantList queryListWithCache(const CompiledStatement& statement, const QVariantMap& parameters,
+                                   const StatementOptions& options);
+    int updateWithCacheInvalidation(const CompiledStatement& statement, const QVariantMap& parameters,
+                                   const StatementOptions& options);
+    
+    // Resolve-once analysis behind SessionFactory::statement()
+    static QSharedPointer<const CompiledStatement> compileStatement(const QString& statementId,
+                                                                    const StatementConfig& statement);
+    
+    // Insert that appends the generated key to generatedKeys: QSqlQuery::lastInsertId(), or
+    // RETURNING keyColumn on PostgreSQL. No extra query is issued.
+    int updateWithGeneratedKeys(const QString& statementId, const QString& sql, const QVariantMap& parameters,
+                                const StatementOptions& options, const QString& keyColumn,
+                                QVariantList& generatedKeys);
+    
+    // Batch execution: one prepare per distinct SQL or chunk, one cache invalidation.
+    // With interceptors registered every row runs through the chain as a single statement.
+    BatchResult updateBatch(const QString& statementId, const QString& sql,
+                            const QList<QVariantMap>& parametersList,
+                            BatchStrategy strategy = BatchStrategy::ExecBatch);
+    BatchResult updateBatch(const QString& statementId, const QString& sql,
+                            const QList<QVariantMap>& parametersList, BatchStrategy strategy,
+                            const StatementOptions& options);
+    
+    // updateBatch with every rendered INSERT ... VALUES turned into the dialect's upsert on conflictKeys
+    BatchResult upsertBatch(const QString& statementId, const QString& sql,
+                            const QList<QVariantMap>& parametersList, const QStringList& conflictKeys,
+                            BatchStrategy strategy = BatchStrategy::MultiRowValues);
+    BatchResult upsertBatch(const QString& statementId, const QString& sql,
+                            const QList<QVariantMap>& parametersList, const QStringList& conflictKeys,
+                            BatchStrategy strategy, const StatementOptions& options);
+    
+    // updateBatch filling BatchResult::generatedKeys. Multi-row VALUES chunks use RETURNING on
+    // SQLite 3.35+ (keyColumn, or rowid) and PostgreSQL, and the contiguous auto-increment range
+    // from LAST_INSERT_ID() on MySQL; otherwise rows are executed one by one with lastInsertId().
+    BatchResult insertBatchWithKeys(const QString& statementId, const QString& sql,
+                                    const QList<QVariantMap>& parametersList, BatchStrategy strategy,
+                                    const QString& keyColumn, const StatementOptions& options);
+    
+    // Pre-rendered batch of a BATCH session: every row binds to processedSql
+    int flushBatch(const QString& statementId, const QString& processedSql,
+                   const QList<QVariantMap>& parametersList, const StatementOptions& options);
+    
+    // Typed mapping: each row is written into the object returned by nextObject through a cached
+    // column-to-property plan; maxRows < 0 reads every row
+    int queryObjects(const QString& sql, const QVariantMap& parameters, const QMetaObject* metaObject,
+                     const std::function<void*()>& nextObject, int maxRows = -1,
+                     const StatementOptions& options = {});
+    
+    // One page of a select: the statement with a dialect LIMIT/OFFSET (or OFFSET/FETCH) appended, and
+    // its total from COUNT(*) over the wrapped statement. With useCache the total is cached against the
+    // write versions of the statement's tables, so it is only recounted after one of them changes.
+    PageResult queryPage(const QString& statementId, const QString& sql, const QVariantMap& parameters,
+                         int page, int pageSize, const StatementOptions& options = {});
+    
+    // Page statement queryPage runs for the dialect; SQL Server gets ORDER BY (SELECT NULL)
+    // when the statement has no top-level ORDER BY, since OFFSET/FETCH requires one. Throws
+    // SqlExecutionException when the statement has its own top-level LIMIT/OFFSET/FETCH.
+    static QString pageSql(const QString& sql, QSqlDriver::DbmsType dbms);
+    
+    // Keyset page: the statement wrapped as SELECT * FROM (...) WHERE (keys) > (lastKey) ORDER BY keys
+    // LIMIT pageSize; an empty lastKey reads the first page. Pages bypass the result cache.
+    QVariantList queryKeysetPage(const QString& statementId, const QString& sql, const QVariantMap& parameters,
+                                 const QStringList& keyColumns, const QVariantList& lastKey, int pageSize,
+                                 const StatementOptions& options = {});
+    
+    // Scalar fast path: first column of the first row, no record or map is built
+    QVariant queryValue(const QString& sql, const QVariantMap& parameters = {},
+                        const StatementOptions& options = {});
+    
+    // Forward-only streaming query: rows go straight to the callback and bypass the result cache
+    int queryCursor(const QString& sql, const QVariantMap& parameters, const RowCallback& callback,
+                    const StatementOptions& options = {});
+    
     void clearCache(const QString& pattern = QLatin1String(""));
     
+    // Driver limit on bind variables per statement, detected once per executor
+    int maxBindVariables();
+    
     void setDebugMode(bool enabled);
     [[nodiscard]] bool isDebugMode() const;
     
+    // Prepared statement reuse, shared with every executor on the same pooled connection
+    void setPreparedStatementCache(QSharedPointer<PreparedStatementCache> cache);
+    PreparedStatementStats getPreparedStatementStats() const;
+    
+    // Interceptors around prepare, parameterize and execution of single statements;
+    // an empty chain leaves one null check per phase. A non-empty chain bypasses the
+    // result cache, whose keys cannot see SQL rewritten in the Prepare phase.
+    void setInterceptors(const InterceptorChain& interceptors);
+    bool hasInterceptors() const;
+    
     // For testing purposes
     QString generateCacheKey(const QString& statementId, const QVariantMap& parameters);
     
 private:
+    // useCache statement whose results may be read from and stored in the CacheManager
+    bool readsResultCache(const QString& statementId, const StatementOptions& options) const;
+    
+    // compiled is the pre-resolved form of sql, or null for a statement passed as text
     QVariant queryInternal(const QString& sql, const QVariantMap& parameters, 
-                          const QString& statementId, bool useCache);
+                          const QString& statementId, const StatementOptions& options,
+                          const CompiledStatement* compiled = nullptr);
     QVariantList queryListInternal(const QString& sql, const QVariantMap& parameters, 
-                                  const QString& statementId, bool useCache);
+                                  const QString& statementId, const StatementOptions& options,
+                                  const CompiledStatement* compiled = nullptr);
     int updateInternal(const QString& sql, const QVariantMap& parameters, 
-                      const QString& statementId, bool invalidateCache);
+                      const QString& statementId, const StatementOptions& options,
+                      QVariantList* generatedKeys = nullptr, const CompiledStatement* compiled = nullptr);
+    ResultSet queryResultSetInternal(const QString& sql, const QVariantMap& parameters,
+                                     const StatementOptions& options, const CompiledStatement* compiled);
+    ResultSet queryResultSetCached(const QString& statementId, const QString& sql, const QVariantMap& parameters,
+                                   const StatementOptions& options, const CompiledStatement* compiled);
+    
+    // Prepare with the statement's options: forward-only for fetchSize/maxRows (or forwardOnly),
+    // set before the driver prepares the statement, and the MySQL timeout hint.
+    // processedSql is updated to the text actually prepared, including interceptor rewrites.
+    QSqlQuery prepareStatement(QString& processedSql, const QVariantMap& parameters,
+                               const StatementOptions& options, bool forwardOnly = false);
+    QSqlQuery prepareQuery(QString& processedSql, const StatementOptions& options, bool forwardOnly = false);
+    
+    // Parameterize and Query/Update phases of a statement prepared by prepareStatement
+    void bindParameters(QSqlQuery& query, QString& processedSql, const QVariantMap& parameters,
+                        const CompiledStatement* compiled = nullptr);
+    bool execStatement(QSqlQuery& query, QString& processedSql, const QVariantMap& parameters,
+                       InterceptPhase phase);
     
-    void invalidateCacheForStatement(const QString& statementId, const QString& sql);
-    QStringList extractTableNamesFromSql(const QString& sql);
+    // Deadline and cancellation of one statement, from construction until destruction:
+    // SQLite progress handler/sqlite3_interrupt, MySQL KILL QUERY from a watchdog thread
+    class QueryDeadline;
+    qint64 mysqlConnectionId();
+    BatchResult batchInternal(const QString& statementId, const QString& sql,
+                              const QList<QVariantMap>& parametersList, BatchStrategy strategy,
+                              const StatementOptions& options, const QStringList& conflictKeys,
+                              bool collectKeys = false, const QString& keyColumn = QString());
+    int executeBatch(const QString& processedSql, const QList<QVariantMap>& parametersList,
+                     const StatementOptions& options);
+    void executeMultiRowInsert(const QString& processedSql, const QList<QVariantMap>& parametersList,
+                               const StatementOptions& options, BatchResult& result,
+                               bool collectKeys = false, const QString& keyColumn = QString());
+    void executeRowsWithKeys(const QString& processedSql, const QList<QVariantMap>& parametersList,
+                             const StatementOptions& options, const QString& keyColumn, BatchResult& result);
+    QString returningColumn(const QString& keyColumn);
+    int mysqlAutoIncrementStep();
+    qint64 sqliteTotalChanges();
     
-    // Get processed SQL statement, preferentially from cache
-    QString getProcessedSql(const QString& sql, const QVariantMap& parameters);
+    void invalidateCacheForStatement(const QString& statementId, const QString& sql,
+                                     const CompiledStatement* compiled = nullptr);
+    static QStringList extractTableNamesFromSql(const QString& sql);
+    
+    // Get processed SQL statement: a compiled static statement's own text, otherwise from cache
+    QString getProcessedSql(const QString& sql, const QVariantMap& parameters,
+                            const CompiledStatement* compiled = nullptr);
     
     // Use object pool or fallback strategy to bind parameters
     void withParameterHandler(QSqlQuery &query, const QVariantMap &parameters);
+    void withBatchParameterHandler(QSqlQuery &query, const QList<QVariantMap> &parametersList);
+    void withMultiRowParameterHandler(QSqlQuery &query, const BindingPlan &rowPlan,
+                                      const QList<QVariantMap> &parametersList);
     
     QSharedPointer<QSqlDatabase> m_connection;
     QSharedPointer<StatementHandler> m_statementHandler;
     QSharedPointer<ParameterHandler> m_parameterHandler;
     QSharedPointer<ResultHandler> m_resultHandler;
     QSharedPointer<CacheManager> m_cacheManager;
-    QHash<QString, QString> m_processedSqlCache; // SQL processing cache
-    QMutex m_sqlCacheMutex; // Mutex to protect SQL cache
+    int m_maxBindVariables = 0; // Driver bind-variable limit, detected on first multi-row insert
+    qint64 m_mysqlConnectionId = 0; // Server thread id for KILL QUERY, detected on first deadline
+    int m_sqliteReturning = -1;     // SQLite 3.35+ RETURNING support, detected on first keyed batch
+    int m_autoIncrementStep = 0;    // MySQL auto_increment_increment, detected on first keyed batch
+    
+    // Null when no interceptor is registered
+    QSharedPointer<const InterceptorChain> m_interceptors;
     
     // Debug related
     bool m_debugMode;
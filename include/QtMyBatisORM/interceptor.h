@@ -0,0 +1,108 @@
+#pragma once
+
+#include <QList>
+#include <QSharedPointer>
+#include <QString>
+#include <QVariantMap>
+#include <functional>
+#include "export.h"
+
+class QSqlQuery;
+
+namespace QtMyBatisORM {
+
+class Executor;
+class Interceptor;
+
+using InterceptorChain = QList<QSharedPointer<Interceptor>>;
+
+/**
+ * Executor phase wrapped by the interceptor chain
+ */
+enum class InterceptPhase
+{
+    Prepare,       // SQL about to be prepared; sql() can be rewritten
+    Parameterize,  // Values about to be bound; parameters() can be changed
+    Query,         // Execution of a select
+    Update         // Execution of an insert, update or delete
+};
+
+/**
+ * One phase of one statement, passed down the interceptor chain
+ * 拦截器调用上下文
+ *
+ * proceed() runs the next interceptor, and after the last one the phase itself;
+ * an interceptor that returns without calling it skips the phase. Call it at
+ * most once. Valid only during Interceptor::intercept.
+ */
+class QTMYBATISORM_EXPORT Invocation
+{
+public:
+    InterceptPhase phase() const;
+
+    QString& sql();                // Rendered SQL; takes effect when changed in Prepare
+    QVariantMap& parameters();     // Statement parameters; take effect when changed in Parameterize
+    QSqlQuery* query() const;      // The statement's query, prepared once Prepare has proceeded
+
+    // Next interceptor, then the phase; false when the execution failed
+    bool proceed();
+
+private:
+    friend class Executor;
+    Invocation(const InterceptorChain& chain, InterceptPhase phase, QString& sql,
+               const QVariantMap& parameters, QSqlQuery* query, std::function<bool()> target);
+
+    const InterceptorChain& m_chain;
+    int m_index = 0;
+    InterceptPhase m_phase;
+    QString& m_sql;
+    QVariantMap m_parameters;
+    QSqlQuery* m_query;
+    std::function<bool()> m_target;
+};
+
+/**
+ * MyBatis-style plugin around the executor phases
+ * 执行器拦截器（插件）
+ *
+ * Register interceptors with SessionFactory::addInterceptor before opening
+ * sessions; they run in registration order, the first one outermost. They
+ * wrap every select and write. While a chain is registered, batch, upsert and
+ * BATCH-mode writes run row by row through it instead of as one execBatch or
+ * multi-row statement, and selects bypass the result cache, since its keys do
+ * not cover SQL rewritten in the Prepare phase. With no interceptor registered
+ * each phase costs one null-pointer check.
+ *
+ * @code
+ * class TimingInterceptor : public Interceptor
+ * {
+ * public:
+ *     bool intercept(Invocation& invocation) override
+ *     {
+ *         if (invocation.phase() != InterceptPhase::Query) {
+ *             return invocation.proceed();
+ *         }
+ *         QElapsedTimer timer;
+ *         timer.start();
+ *         const bool ok = invocation.proceed();
+ *         record(invocation.sql(), timer.nsecsElapsed());
+ *         return ok;
+ *     }
+ * };
+ * @endcode
+ */
+class QTMYBATISORM_EXPORT Interceptor
+{
+public:
+    virtual ~Interceptor() = default;
+
+    /**
+     * @brief Wraps one phase; return invocation.proceed() to continue
+     *
+     * Called on the thread running the statement, which for the async API is a
+     * worker thread; implementations shared between sessions must be thread-safe.
+     */
+    virtual bool intercept(Invocation& invocation) = 0;
+};
+
+} // namespace QtMyBatisORM
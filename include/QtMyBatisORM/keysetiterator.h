@@ -0,0 +1,81 @@
+#pragma once
+
+#include <QFuture>
+#include <QSharedPointer>
+#include <QString>
+#include <QStringList>
+#include <QVariantList>
+#include <QVariantMap>
+#include "export.h"
+
+namespace QtMyBatisORM {
+
+class AsyncExecutor;
+
+/**
+ * Keyset scan of a select with one page of read-ahead
+ * 键集分页扫描器（后台预读下一页）
+ *
+ * Pages are read with Session::selectKeysetPage, so each one seeks past the
+ * last key of the previous page instead of skipping OFFSET rows, and the scan
+ * stays linear however deep it goes. As soon as a page is handed out, the next
+ * one is requested on a worker of the AsyncExecutor, which owns its own pooled
+ * connection; the database read overlaps with processing the current page.
+ *
+ * The key columns must be result columns that are unique together; rows are
+ * returned in ascending key order. Not for use on an async worker thread.
+ *
+ * @code
+ * KeysetIterator students(factory->asyncExecutor(), "Student.findAll", {"id"});
+ * while (students.hasNext()) {
+ *     for (const QVariant& student : students.next()) {
+ *         // next page is being read meanwhile
+ *     }
+ * }
+ * @endcode
+ */
+class QTMYBATISORM_EXPORT KeysetIterator
+{
+public:
+    KeysetIterator(QSharedPointer<AsyncExecutor> executor, const QString& statementId,
+                   const QStringList& keyColumns, const QVariantMap& parameters = {}, int pageSize = 1000);
+    ~KeysetIterator();
+
+    KeysetIterator(const KeysetIterator&) = delete;
+    KeysetIterator& operator=(const KeysetIterator&) = delete;
+
+    /**
+     * @brief Whether next() has rows; waits for the page being read ahead
+     * @throws The exception of the page query; the next call reads the same page again
+     */
+    bool hasNext();
+
+    /**
+     * @brief The next page, empty once the scan is done
+     * @throws The exception of the page query; the next call reads the same page again
+     */
+    QVariantList next();
+
+    int pageSize() const;
+    int pagesRequested() const;  // Pages submitted so far, including the one read ahead
+
+private:
+    void requestPage(const QVariantList& lastKey);
+    void takePage();
+
+    QSharedPointer<AsyncExecutor> m_executor;
+    QString m_statementId;
+    QStringList m_keyColumns;
+    QVariantMap m_parameters;
+    int m_pageSize;
+
+    QFuture<QVariantList> m_pending;  // Page being read ahead
+    QVariantList m_pendingKey;        // Key the pending page starts after
+    bool m_pendingFailed = false;     // The pending page threw; the next call reads it again
+    bool m_prefetching = false;       // False once a short page ended the scan
+    QVariantList m_current;
+    bool m_hasCurrent = false;
+    int m_pagesRequested = 0;
+};
+
+} // namespace QtMyBatisORM
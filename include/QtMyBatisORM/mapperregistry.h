@@ -5,6 +5,7 @@
 #include <QString>
 #include <QSharedPointer>
 #include "datamodels.h"
+#include "statementhandle.h"
 
 namespace QtMyBatisORM {
 
@@ -33,6 +34,11 @@ public:
     MapperConfig getMapperConfig(const QString& mapperName) const;
     bool hasMapper(const QString& mapperName) const;
     
+    // Statement of a "namespace.id" reference; throws MappingException when it is not registered
+    StatementConfig resolveStatement(const QString& statementId) const;
+    // The statement resolved and compiled once, for repeated Session calls
+    StatementHandle statement(const QString& statementId) const;
+    
     // Validation functionality
     bool validateMapper(const QString& mapperName) const;
     bool validateAllMappers() const;
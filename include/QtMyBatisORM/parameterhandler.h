@@ -5,9 +5,39 @@
 #include <QVariantMap>
 #include <QSqlQuery>
 #include <QDateTime>
+#include <QStringList>
+#include <QVector>
+#include <QSharedPointer>
 
 namespace QtMyBatisORM {
 
+/**
+ * Placeholder layout of one processed SQL statement, computed once and cached
+ * 单条SQL的占位符布局，计算一次后缓存复用
+ *
+ * Placeholders are scanned the same way QSqlResult does, so position i here is
+ * the bind position i of the prepared query.
+ */
+struct BindingPlan
+{
+    enum class Mode
+    {
+        None,
+        Named,
+        Positional
+    };
+
+    Mode mode = Mode::None;
+    QStringList names;          // Unique named placeholders, in order of first appearance
+    QStringList placeholders;   // ":name" for each entry of names
+    QVector<int> positions;     // Bind position -> index into names
+    QVector<int> offsets;       // Bind position -> offset of its ':' in the SQL text
+    int positionalCount = 0;    // Number of '?' placeholders
+    bool hasDuplicateNames = false;
+
+    static BindingPlan build(const QString& sql);
+};
+
 /**
  * Parameter handler
  */
@@ -19,16 +49,47 @@ public:
     explicit ParameterHandler(QObject* parent = nullptr);
     
     void setParameters(QSqlQuery& query, const QVariantMap& parameters);
+    
+    /**
+     * @brief Bind with a plan computed in advance for the query's SQL, skipping the plan cache
+     * @param query Prepared query
+     * @param plan Binding plan of the SQL the query was prepared with
+     * @param parameters Parameter mapping
+     */
+    void setParameters(QSqlQuery& query, const BindingPlan& plan, const QVariantMap& parameters);
+    
+    /**
+     * @brief Bind one column-wise QVariantList per placeholder for QSqlQuery::execBatch()
+     * @param query Prepared query
+     * @param parametersList One parameter map per row
+     */
+    void setBatchParameters(QSqlQuery& query, const QList<QVariantMap>& parametersList);
+    
+    /**
+     * @brief Bind rows into a statement whose single-row placeholders were repeated per row
+     * @param query Prepared query using '?' placeholders only
+     * @param rowPlan Binding plan of the single-row statement
+     * @param parametersList One parameter map per row; row r fills positions r * rowPlan.positions.size() onwards
+     */
+    void setMultiRowParameters(QSqlQuery& query, const BindingPlan& rowPlan,
+                               const QList<QVariantMap>& parametersList);
     QVariant convertParameter(const QVariant& value, const QString& targetType = QLatin1String(""));
     
     // Parameter validation methods (public for testing and external validation)
     bool isValidParameterName(const QString& name);
     
+    /**
+     * @brief Binding plan for a processed SQL statement, shared across handlers
+     */
+    static QSharedPointer<const BindingPlan> bindingPlan(const QString& sql);
+    
 private:
-    void bindByIndex(QSqlQuery& query, const QVariantMap& parameters);
-    void bindByName(QSqlQuery& query, const QVariantMap& parameters);
+    void bindByIndex(QSqlQuery& query, const BindingPlan& plan, const QVariantMap& parameters);
+    void bindByName(QSqlQuery& query, const BindingPlan& plan, const QVariantMap& parameters);
+    QStringList positionalKeys(const QVariantMap& parameters);
     
     QVariant convertToSqlType(const QVariant& value);
+    QVariant toBindValue(const QVariant& value);
 };
 
 } // namespace QtMyBatisORM
\ No newline at end of file
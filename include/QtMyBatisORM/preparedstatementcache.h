@@ -0,0 +1,65 @@
+#pragma once
+
+#include <QCache>
+#include <QMutex>
+#include <QSqlQuery>
+#include <QSqlDatabase>
+#include <QString>
+#include <QPair>
+#include "datamodels.h"
+
+namespace QtMyBatisORM {
+
+/**
+ * Bounded LRU cache of prepared statements belonging to one pooled connection
+ * 单个连接池连接的预编译语句LRU缓存
+ *
+ * Statements are keyed by their processed SQL text and forward-only mode, which
+ * is fixed when the statement is prepared. A statement is checked out
+ * by acquire() and handed back by release(), so a query that is still being
+ * iterated is never re-executed underneath its reader.
+ * 语句按处理后的SQL文本与只进模式缓存（只进模式在prepare时确定）。acquire()取出语句，release()归还语句，
+ * 因此正在遍历结果的查询不会被重复执行覆盖。
+ */
+class PreparedStatementCache
+{
+public:
+    explicit PreparedStatementCache(int maxSize = 64);
+    ~PreparedStatementCache();
+
+    /**
+     * @brief Check out a prepared statement, preparing it on a cache miss
+     * @param sql Processed SQL text
+     * @param db Connection owning the statement
+     * @param forwardOnly Forward-only mode, set before the statement is prepared
+     * @return Prepared query ready for binding
+     */
+    QSqlQuery acquire(const QString& sql, QSqlDatabase& db, bool forwardOnly = false);
+
+    /**
+     * @brief Return a statement to the cache after it has been executed
+     * @param sql Processed SQL text the statement was prepared with
+     * @param query Statement to keep for reuse; moved into the cache unless it failed
+     */
+    void release(const QString& sql, QSqlQuery& query);
+
+    void clear();
+
+    int size() const;
+    int getMaxSize() const;
+    bool isEnabled() const;
+
+    PreparedStatementStats getStats() const;
+    void resetStats();
+
+private:
+    using StatementKey = QPair<QString, bool>;  // SQL text, forward-only
+
+    QCache<StatementKey, QSqlQuery> m_statements;
+    int m_maxSize;
+
+    mutable PreparedStatementStats m_stats;
+    mutable QMutex m_mutex;
+};
+
+} // namespace QtMyBatisORM
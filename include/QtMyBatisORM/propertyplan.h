@@ -0,0 +1,59 @@
+#pragma once
+
+#include <QMetaObject>
+#include <QMetaProperty>
+#include <QSharedPointer>
+#include <QSqlQuery>
+#include <QSqlRecord>
+#include <QString>
+#include <QVector>
+
+namespace QtMyBatisORM {
+
+/**
+ * Column index to QMetaProperty plan for typed result mapping
+ * 列下标到QMetaProperty的映射计划，用于类型化结果映射
+ *
+ * Built once per statement and target type, then used to write every row
+ * straight from QSqlQuery::value(int) into a Q_GADGET value or a QObject
+ * without an intermediate QVariantMap. Columns are matched to writable
+ * properties by exact name, then snake_case to camelCase ("student_number"
+ * to "studentNumber"), then case-insensitively; unmatched columns are ignored.
+ * 每个语句和目标类型只构建一次，之后每行直接写入对象，不经过QVariantMap。
+ */
+class PropertyPlan
+{
+public:
+    /**
+     * @brief Plan for a target type and processed SQL, built on first use and cached
+     * @param metaObject Target type's static meta-object
+     * @param sql Processed SQL the query was prepared with
+     * @param query Executed query, used for its record on a cache miss
+     */
+    static QSharedPointer<const PropertyPlan> forQuery(const QMetaObject* metaObject, const QString& sql,
+                                                       const QSqlQuery& query);
+
+    static QSharedPointer<const PropertyPlan> build(const QMetaObject* metaObject, const QSqlRecord& record);
+
+    /**
+     * @brief Write the current row of the query into the target
+     * @param target Q_GADGET value, or QObject* for QObject-derived types
+     */
+    void apply(const QSqlQuery& query, void* target) const;
+
+    int bindingCount() const { return m_bindings.size(); }
+
+private:
+    struct Binding
+    {
+        int column;
+        QMetaProperty property;
+    };
+
+    static int findProperty(const QMetaObject* metaObject, const QString& column);
+
+    bool m_isObject = false;
+    QVector<Binding> m_bindings;
+};
+
+} // namespace QtMyBatisORM
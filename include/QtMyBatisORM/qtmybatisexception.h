@@ -67,6 +67,16 @@ public:
     SqlExecutionException* clone() const override;
 };
 
+/**
+ * Statement interrupted by its deadline (code QUERY_TIMEOUT) or a CancellationToken (QUERY_CANCELLED)
+ */
+class TimeoutException : public SqlExecutionException
+{
+public:
+    explicit TimeoutException(const QString& message, const QString& code = QLatin1String("QUERY_TIMEOUT"));
+    TimeoutException* clone() const override;
+};
+
 /**
  * Connection exception
  */
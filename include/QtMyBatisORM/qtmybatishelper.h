@@ -6,8 +6,11 @@
 #include <QVariantList>
 #include <QString>
 #include <QSharedPointer>
+#include <QFuture>
 #include <functional>
 #include "export.h"
+#include "datamodels.h"
+#include "resultset.h"
 
 namespace QtMyBatisORM {
 
@@ -31,16 +34,40 @@ public:
     // Basic CRUD operations - automatically manages Session lifecycle internally
     static QVariant selectOne(const QString& statementId, const QVariantMap& parameters = {});
     static QVariantList selectList(const QString& statementId, const QVariantMap& parameters = {});
+    static ResultSet selectResultSet(const QString& statementId, const QVariantMap& parameters = {});
+    static PageResult selectPage(const QString& statementId, const QVariantMap& parameters, int page, int pageSize);
+    static int selectCursor(const QString& statementId, const QVariantMap& parameters, const RowCallback& callback);
     static int insert(const QString& statementId, const QVariantMap& parameters = {});
+    static QVariantList insertWithKeys(const QString& statementId, const QVariantMap& parameters = {});
     static int update(const QString& statementId, const QVariantMap& parameters = {});
     static int remove(const QString& statementId, const QVariantMap& parameters = {});
     static int execute(const QString& sql, const QVariantMap& parameters = {});
     
+    // Multi-get - keys bound to the statement's foreach collection in IN-list chunks
+    static QVariantList selectByKeys(const QString& statementId, const QString& keyParam, const QVariantList& keys,
+                                     const QVariantMap& parameters = {});
+    static QHash<QString, QVariantMap> selectMapByKeys(const QString& statementId, const QString& keyParam,
+                                                       const QVariantList& keys, const QString& mapKey,
+                                                       const QVariantMap& parameters = {});
+    
     // Batch operations
-    static int batchInsert(const QString& statementId, const QList<QVariantMap>& parametersList);
+    static int batchInsert(const QString& statementId, const QList<QVariantMap>& parametersList,
+                           BatchStrategy strategy = BatchStrategy::ExecBatch);
     static int batchUpdate(const QString& statementId, const QList<QVariantMap>& parametersList);
+    static int batchUpsert(const QString& statementId, const QList<QVariantMap>& rows, const QStringList& conflictKeys,
+                           BatchStrategy strategy = BatchStrategy::MultiRowValues);
     static int batchRemove(const QString& statementId, const QList<QVariantMap>& parametersList);
     
+    // Asynchronous operations - run on worker threads that each own one pooled connection
+    static QFuture<QVariant> selectOneAsync(const QString& statementId, const QVariantMap& parameters = {});
+    static QFuture<QVariantList> selectListAsync(const QString& statementId, const QVariantMap& parameters = {});
+    static QFuture<int> updateAsync(const QString& statementId, const QVariantMap& parameters = {});
+    static QFuture<int> batchInsertAsync(const QString& statementId, const QList<QVariantMap>& parametersList,
+                                         BatchStrategy strategy = BatchStrategy::ExecBatch);
+    
+    // Parallel fan-out - independent list queries on separate pooled connections, results in input order
+    static QList<QVariantList> executeParallel(const QList<ParallelStatement>& statements, int maxParallelism = 0);
+    
     // Transaction operations - ensures Session is properly closed
     static bool executeInTransaction(std::function<bool()> operation);
     static bool executeInTransaction(std::function<bool(QSharedPointer<Session>)> operation);
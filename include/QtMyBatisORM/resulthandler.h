@@ -6,6 +6,8 @@
 #include <QVariantList>
 #include <QVariantMap>
 #include <QDateTime>
+#include "datamodels.h"
+#include "resultset.h"
 
 namespace QtMyBatisORM {
 
@@ -19,8 +21,13 @@ class ResultHandler : public QObject
 public:
     explicit ResultHandler(QObject* parent = nullptr);
     
+    // maxRows > 0 stops reading after that many rows
     QVariant handleSingleResult(QSqlQuery& query);
-    QVariantList handleListResult(QSqlQuery& query);
+    QVariantList handleListResult(QSqlQuery& query, int maxRows = 0);
+    ResultSet handleResultSet(QSqlQuery& query, int maxRows = 0);
+    
+    // Streams rows to the callback one at a time, returns the number of rows delivered
+    int handleCursorResult(QSqlQuery& query, const RowCallback& callback, int maxRows = 0);
     
     QVariantMap recordToMap(const QSqlQuery& query);
     QVariant convertFromSqlType(const QVariant& value, const QString& targetType = QLatin1String(""));
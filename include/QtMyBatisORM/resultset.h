@@ -0,0 +1,78 @@
+#pragma once
+
+#include <QHash>
+#include <QMetaType>
+#include <QSharedPointer>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+#include <QVariantList>
+#include <QVariantMap>
+#include <QVector>
+#include "export.h"
+
+namespace QtMyBatisORM {
+
+/**
+ * Compact tabular query result
+ * 紧凑的表格型查询结果
+ *
+ * Column names are stored once in a header shared by all copies, and the
+ * cells live in a single row-major QVector<QVariant>. Rows cost one QVariant
+ * per cell instead of one QVariantMap per row, which keeps wide results of
+ * selectResultSet small while they sit in the CacheManager. selectList results
+ * are cached as their QVariantList, so a hit does not rebuild the row maps.
+ * 列名只保存一份并由所有副本共享，单元格按行优先顺序存放在同一个QVector中。
+ */
+class QTMYBATISORM_EXPORT ResultSet
+{
+public:
+    ResultSet();
+    explicit ResultSet(const QStringList& columnNames);
+
+    int rowCount() const;
+    int columnCount() const;
+    bool isEmpty() const;
+
+    const QStringList& columnNames() const;
+
+    /**
+     * @brief Position of a column by name
+     * @return Column index, or -1 if the result has no such column
+     */
+    int columnIndex(const QString& name) const;
+
+    QVariant value(int row, int column) const;
+    QVariant value(int row, const QString& column) const;
+
+    // Row-major cell storage, columnCount() cells per row
+    const QVector<QVariant>& cells() const { return m_cells; }
+
+    /**
+     * @brief Build the legacy map representation of one row
+     */
+    QVariantMap rowMap(int row) const;
+
+    /**
+     * @brief Convert to the legacy QVariantList of QVariantMap rows
+     */
+    QVariantList toVariantList() const;
+
+    // Building: cells are appended in row-major order
+    void reserve(int rows);
+    void appendValue(const QVariant& value);
+
+private:
+    struct Header
+    {
+        QStringList names;
+        QHash<QString, int> indexes;
+    };
+
+    QSharedPointer<const Header> m_header;
+    QVector<QVariant> m_cells;
+};
+
+} // namespace QtMyBatisORM
+
+Q_DECLARE_METATYPE(QtMyBatisORM::ResultSet)
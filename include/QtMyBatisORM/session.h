@@ -9,11 +9,25 @@
 #include <QTimer>
 #include <QStack>
 #include <QDateTime>
+#include <optional>
+#include <type_traits>
+#include "datamodels.h"
+#include "resultset.h"
+#include "statementhandle.h"
 
 namespace QtMyBatisORM {
 
 class Executor;
 class MapperRegistry;
+class BatchLoader;
+
+// Typed result rows: Q_GADGET types by value, QObject-derived types by shared pointer
+template<typename T>
+using TypedRow = std::conditional_t<std::is_base_of_v<QObject, T>, QSharedPointer<T>, T>;
+
+// Typed single result: empty when the query returns no row
+template<typename T>
+using OptionalTypedRow = std::conditional_t<std::is_base_of_v<QObject, T>, QSharedPointer<T>, std::optional<T>>;
 
 /**
  * Database session
@@ -31,17 +45,105 @@ public:
     // Basic CRUD operations
     QVariant selectOne(const QString& statementId, const QVariantMap& parameters = {});
     QVariantList selectList(const QString& statementId, const QVariantMap& parameters = {});
+    ResultSet selectResultSet(const QString& statementId, const QVariantMap& parameters = {});
+    
+    // One page (1-based) of a select plus the total row count, derived from the statement itself:
+    // LIMIT/OFFSET (OFFSET/FETCH on SQL Server and Oracle) is appended and COUNT(*) wraps the statement.
+    // A statement with its own top-level LIMIT/OFFSET/FETCH is rejected. With useCache the total is
+    // reused until one of the statement's tables is written through this factory.
+    PageResult selectPage(const QString& statementId, const QVariantMap& parameters, int page, int pageSize);
+    
+    // Keyset page: up to pageSize rows ordered by keyColumns whose key is greater than lastKey
+    // (the first page when lastKey is empty). The key columns must be result columns that together
+    // are unique; see KeysetIterator for scanning a whole statement with read-ahead.
+    QVariantList selectKeysetPage(const QString& statementId, const QStringList& keyColumns,
+                                  const QVariantList& lastKey, const QVariantMap& parameters, int pageSize);
+    
+    // Forward-only streaming query: each row is passed to the callback, nothing is materialized or cached.
+    // Returns the number of rows delivered; the callback returns false to stop early.
+    int selectCursor(const QString& statementId, const QVariantMap& parameters, const RowCallback& callback);
+    
+    // Typed mapping into Q_GADGET/Q_OBJECT types: rows are written straight into T through a
+    // column-to-property plan built once per statement. These bypass the result cache.
+    template<typename T>
+    QList<TypedRow<T>> selectList(const QString& statementId, const QVariantMap& parameters = {});
+    template<typename T>
+    OptionalTypedRow<T> selectOne(const QString& statementId, const QVariantMap& parameters = {});
+    
+    // Scalar fast path for COUNT/MAX style queries: first column of the first row
+    template<typename T>
+    T selectValue(const QString& statementId, const QVariantMap& parameters = {});
+    
+    // Multi-get: the statement's <foreach collection="keyParam"> receives the keys in IN-list chunks
+    // sized under the driver's bind-variable limit, so equal chunks share one prepared statement.
+    // Null and duplicate keys are dropped; rows of all chunks are returned in chunk order.
+    QVariantList selectByKeys(const QString& statementId, const QString& keyParam, const QVariantList& keys,
+                              const QVariantMap& parameters = {});
+    // Same as selectByKeys, with each row keyed by the string form of its mapKey column
+    QHash<QString, QVariantMap> selectMapByKeys(const QString& statementId, const QString& keyParam,
+                                                const QVariantList& keys, const QString& mapKey,
+                                                const QVariantMap& parameters = {});
+    // Chunks selectByKeys would use; reservedVariables are placeholders taken by other parameters
+    QList<QVariantList> splitKeys(const QVariantList& keys, int reservedVariables = 0);
+    
+    // Opt-in request coalescing: lookups made through the loader are fetched together with one
+    // selectMapByKeys call and memoized until a write through this session. Owned by the session,
+    // one loader per statement/key parameter/key column.
+    BatchLoader* loader(const QString& statementId, const QString& keyParam, const QString& keyColumn);
+    
     int insert(const QString& statementId, const QVariantMap& parameters = {});
+    // Insert returning its generated key (QSqlQuery::lastInsertId(), RETURNING keyColumn on PostgreSQL)
+    // without a follow-up query; executes immediately, also in BATCH mode
+    QVariantList insertWithKeys(const QString& statementId, const QVariantMap& parameters = {});
     int update(const QString& statementId, const QVariantMap& parameters = {});
     int remove(const QString& statementId, const QVariantMap& parameters = {});
     
+    // Pre-resolved statements (SessionFactory::statement): no id lookup, and for static statements
+    // no SQL rendering or binding plan lookup per call. Same semantics as the id-based calls.
+    QVariant selectOne(const StatementHandle& statement, const QVariantMap& parameters = {});
+    QVariantList selectList(const StatementHandle& statement, const QVariantMap& parameters = {});
+    int insert(const StatementHandle& statement, const QVariantMap& parameters = {});
+    int update(const StatementHandle& statement, const QVariantMap& parameters = {});
+    int remove(const StatementHandle& statement, const QVariantMap& parameters = {});
+    
     // Execute raw SQL statements
     int execute(const QString& sql, const QVariantMap& parameters = {});
     
     // Batch operations
-    int batchInsert(const QString& statementId, const QList<QVariantMap>& parametersList);
+    int batchInsert(const QString& statementId, const QList<QVariantMap>& parametersList,
+                    BatchStrategy strategy = BatchStrategy::ExecBatch);
+    // For useGeneratedKeys statements, BatchResult::generatedKeys holds one key per row
+    BatchResult batchInsertWithResult(const QString& statementId, const QList<QVariantMap>& parametersList,
+                                      BatchStrategy strategy = BatchStrategy::ExecBatch);
     int batchUpdate(const QString& statementId, const QList<QVariantMap>& parametersList);
     int batchRemove(const QString& statementId, const QList<QVariantMap>& parametersList);
+    // Insert-or-update from an INSERT INTO t (columns) VALUES (...) statement: SQLite/PostgreSQL
+    // ON CONFLICT (conflictKeys) DO UPDATE, MySQL ON DUPLICATE KEY UPDATE. Columns other than the
+    // conflict keys take the new row's values. Affected rows follow the driver (MySQL counts an update as 2).
+    int batchUpsert(const QString& statementId, const QList<QVariantMap>& rows, const QStringList& conflictKeys,
+                    BatchStrategy strategy = BatchStrategy::MultiRowValues);
+    
+    // BATCH mode: insert/update/remove return 0 and are queued; consecutive writes with the same
+    // statement id and rendered SQL share one group, and groups run in call order. Queued writes run
+    // with execBatch on flushStatements(), commit(), before any select, or once the queue reaches the
+    // flush threshold; rollback() discards them.
+    void setExecutorType(ExecutorType type);
+    ExecutorType executorType() const;
+    void setBatchFlushThreshold(int rows);  // 0 disables automatic flushing
+    int batchFlushThreshold() const;
+    int pendingBatchRows() const;
+    // Executes the queue and returns the report of every group run since the previous call,
+    // including groups flushed automatically or by commit()
+    QList<BatchStatementResult> flushStatements();
+    
+    // Query deadline and cancellation for every statement run by this session, on top of each
+    // statement's own timeout attribute. A statement past its deadline or whose token is cancelled
+    // is interrupted (SQLite in-process, MySQL with KILL QUERY) and throws TimeoutException with
+    // code QUERY_TIMEOUT or QUERY_CANCELLED; the session and its connection stay usable.
+    void setQueryTimeout(int milliseconds);  // 0 uses the statements' own timeout
+    int queryTimeout() const;
+    void setCancellationToken(const CancellationToken& token);  // A default token clears it
+    CancellationToken cancellationToken() const;
     
     // Transaction management
     void beginTransaction();
@@ -76,7 +178,28 @@ private slots:
     void onTransactionTimeout();
     
 private:
+    int selectObjects(const QString& statementId, const QVariantMap& parameters,
+                      const QMetaObject* metaObject, const std::function<void*()>& nextObject, int maxRows);
+    QVariant selectScalar(const QString& statementId, const QVariantMap& parameters);
+    
+    struct QueuedBatch
+    {
+        QString statementId;
+        QString sql;
+        StatementOptions options;
+        QList<QVariantMap> rows;
+    };
+    
+    int queueStatement(const QString& statementId, const StatementConfig& statement,
+                       const QVariantMap& parameters);
+    void executeQueuedBatches();
+    void discardQueuedBatches();
+    void clearLoaders();
     QString getStatementSql(const QString& statementId);
+    StatementConfig getStatementConfig(const QString& statementId);
+    StatementOptions statementOptions(const StatementConfig& statement) const;
+    StatementOptions withSessionOptions(StatementOptions options) const;
+    const CompiledStatement& compiledStatement(const StatementHandle& statement) const;
     void checkClosed();
     void checkTransactionTimeout();
     QString generateSavepointName();
@@ -99,6 +222,57 @@ private:
     // 嵌套事务支持
     QStack<QString> m_savepointStack;
     int m_savepointCounter;
+    
+    QHash<QString, BatchLoader*> m_loaders;
+    
+    // BATCH executor state
+    ExecutorType m_executorType = ExecutorType::Simple;
+    QList<QueuedBatch> m_batchQueue;
+    int m_batchQueuedRows = 0;
+    int m_batchFlushThreshold = 1000;
+    QList<BatchStatementResult> m_batchResults;
+    
+    // Per-call deadline and cancellation
+    int m_queryTimeoutMs = 0;
+    CancellationToken m_cancellationToken;
 };
 
-} // namespace QtMyBatisORM
\ No newline at end of file
+template<typename T>
+QList<TypedRow<T>> Session::selectList(const QString& statementId, const QVariantMap& parameters)
+{
+    QList<TypedRow<T>> rows;
+    selectObjects(statementId, parameters, &T::staticMetaObject, [&rows]() -> void* {
+        if constexpr (std::is_base_of_v<QObject, T>) {
+            rows.append(QSharedPointer<T>::create());
+            return static_cast<QObject*>(rows.last().data());
+        } else {
+            rows.append(T());
+            return &rows.last();
+        }
+    }, -1);
+    return rows;
+}
+
+template<typename T>
+OptionalTypedRow<T> Session::selectOne(const QString& statementId, const QVariantMap& parameters)
+{
+    OptionalTypedRow<T> row;
+    selectObjects(statementId, parameters, &T::staticMetaObject, [&row]() -> void* {
+        if constexpr (std::is_base_of_v<QObject, T>) {
+            row = QSharedPointer<T>::create();
+            return static_cast<QObject*>(row.data());
+        } else {
+            row.emplace();
+            return &*row;
+        }
+    }, 1);
+    return row;
+}
+
+template<typename T>
+T Session::selectValue(const QString& statementId, const QVariantMap& parameters)
+{
+    return qvariant_cast<T>(selectScalar(statementId, parameters));
+}
+
+} // namespace QtMyBatisORM
@@ -3,7 +3,13 @@
 #include <QObject>
 #include <QSharedPointer>
 #include <QSet>
+#include <QFuture>
+#include <QVariant>
+#include <QVariantMap>
+#include <QVariantList>
 #include "datamodels.h"
+#include "interceptor.h"
+#include "statementhandle.h"
 
 namespace QtMyBatisORM {
 
@@ -11,6 +17,7 @@ class Session;
 class ConnectionPool;
 class MapperRegistry;
 class CacheManager;
+class AsyncExecutor;
 
 /**
  * Session factory
@@ -23,15 +30,50 @@ public:
     static QSharedPointer<SessionFactory> create(const DatabaseConfig& config);
     
     QSharedPointer<Session> openSession();
+    // Session whose insert/update/delete are queued until flushStatements() or commit()
+    QSharedPointer<Session> openSession(ExecutorType type);
     void closeSession(QSharedPointer<Session> session);
     
     template<typename T>
     T* getMapper(QSharedPointer<Session> session);
     
+    // Resolve a "namespace.id" statement once for the handle overloads of Session; throws
+    // MappingException when it is not registered. Keep the handle instead of re-resolving per call.
+    StatementHandle statement(const QString& statementId) const;
+    
     void close();
     bool isClosed() const;
     
+    // Asynchronous API: statements run on worker threads that each own one pooled connection,
+    // so the calling thread (e.g. a GUI event loop) never blocks on the pool or the database
+    QFuture<QVariant> selectOneAsync(const QString& statementId, const QVariantMap& parameters = {});
+    QFuture<QVariantList> selectListAsync(const QString& statementId, const QVariantMap& parameters = {});
+    QFuture<int> updateAsync(const QString& statementId, const QVariantMap& parameters = {});
+    QFuture<int> batchInsertAsync(const QString& statementId, const QList<QVariantMap>& parametersList,
+                                  BatchStrategy strategy = BatchStrategy::ExecBatch);
+    
+    // Run independent list queries concurrently, one pooled connection per worker thread,
+    // and block until all are done. Results keep the order of the statements; the first
+    // failure is rethrown once every statement has finished. Workers added for the fan-out
+    // release their connections once the queue drains. Must not be called from an async worker.
+    // 并行执行互不依赖的查询，耗时约等于最慢的一条
+    QList<QVariantList> executeParallel(const QList<ParallelStatement>& statements, int maxParallelism = 0);
+    
+    // Session::selectByKeys with the key chunks fanned out through executeParallel
+    QVariantList selectByKeys(const QString& statementId, const QString& keyParam, const QVariantList& keys,
+                              const QVariantMap& parameters = {}, int maxParallelism = 0);
+    
+    // Worker threads behind the async API, for awaitable front ends
+    QSharedPointer<AsyncExecutor> asyncExecutor() const;
+    
     int getActiveSessionCount() const;
+    PreparedStatementStats getPreparedStatementStats() const;
+    
+    // Plugins around prepare, parameterize, query and update, outermost first. Apply to sessions
+    // opened afterwards and to async workers that have not run a statement yet, so register them
+    // right after create().
+    void addInterceptor(QSharedPointer<Interceptor> interceptor);
+    InterceptorChain interceptors() const;
     
 private:
     explicit SessionFactory(const DatabaseConfig& config, QObject* parent = nullptr);
@@ -41,8 +83,10 @@ private:
     QSharedPointer<ConnectionPool> m_connectionPool;
     QSharedPointer<MapperRegistry> m_mapperRegistry;
     QSharedPointer<CacheManager> m_cacheManager;
+    QSharedPointer<AsyncExecutor> m_asyncExecutor;
     
     QSet<QObject*> m_activeSessions;
+    InterceptorChain m_interceptors;
     bool m_closed;
 };
 
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <QString>
+#include <QVariant>
+#include <QSharedPointer>
+
+namespace QtMyBatisORM {
+
+class DynamicContext;
+
+/**
+ * @brief Compiled test attribute of <if> and <when>
+ *
+ * Supports the OGNL subset used by MyBatis mappers:
+ * - literals: 'text', "text", 42, 3.5, true, false, null
+ * - property paths: name, user.address.city, item.id (maps, hashes, QObject and Q_GADGET values)
+ * - methods: size(), isEmpty(), length(), trim()
+ * - comparisons: == != < <= > >= and eq neq lt lte gt gte
+ * - boolean operators: and or not && || ! and parentheses
+ *
+ * Expressions are parsed once into an evaluation tree when the statement is
+ * compiled; evaluation resolves paths against the DynamicContext directly.
+ * 加载时将test表达式解析为求值树，执行时直接对参数求值
+ */
+class SqlExpression
+{
+public:
+    class Node;
+
+    /**
+     * @brief Parse an expression
+     * @throws MappingException if the expression is not valid
+     */
+    static SqlExpression parse(const QString& expression);
+
+    /**
+     * @brief Evaluate as a condition using OGNL truthiness
+     *
+     * null is false, booleans are themselves, numbers are true when non-zero
+     * and any other value is true.
+     */
+    bool evaluate(const DynamicContext& context) const;
+
+    /**
+     * @brief Evaluate to a value
+     */
+    QVariant value(const DynamicContext& context) const;
+
+    const QString& text() const { return m_text; }
+
+private:
+    QString m_text;
+    QSharedPointer<const Node> m_root;
+};
+
+} // namespace QtMyBatisORM
@@ -0,0 +1,290 @@
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QVariantMap>
+#include <QVector>
+#include <QHash>
+#include <QSharedPointer>
+#include "sqlexpression.h"
+
+namespace QtMyBatisORM {
+
+/**
+ * @brief Evaluation state for one pass over a compiled SQL tree
+ *
+ * Collects the generated SQL text while the nodes are applied against the
+ * caller's parameters. Inside a <foreach>, the item name is bound to the
+ * current element and to its indexed placeholder.
+ * 动态SQL求值上下文，在遍历语法树时收集生成的SQL文本，并记录foreach当前元素
+ */
+class DynamicContext
+{
+public:
+    explicit DynamicContext(const QVariantMap& parameters);
+
+    const QVariantMap& parameters() const { return m_parameters; }
+
+    void appendSql(const QString& sql) { m_sql += sql; }
+    const QString& sql() const { return m_sql; }
+    void truncateSql(qsizetype size) { m_sql.truncate(size); }
+
+    /**
+     * @brief Empty context sharing the parameters and item bindings, for nodes that post-process their output
+     */
+    DynamicContext nested() const;
+
+    void bindItem(const QString& name, const QString& placeholder, const QVariant& value);
+    void unbindItem() { m_items.removeLast(); }
+
+    /**
+     * @brief Placeholder name bound to a <foreach> item, or nullptr outside of one
+     */
+    const QString* itemPlaceholder(const QString& name) const;
+
+    /**
+     * @brief Resolve a name against the innermost <foreach> items, then the parameters
+     */
+    bool lookup(const QString& name, QVariant& value) const;
+
+private:
+    struct ItemBinding
+    {
+        QString name;
+        QString placeholder;
+        QVariant value;
+    };
+
+    const QVariantMap& m_parameters;
+    QVector<ItemBinding> m_items;
+    QString m_sql;
+};
+
+/**
+ * @brief Compact signature of the SQL a tree generates for one parameter set
+ *
+ * Records which branches are taken, which #{param} references resolve and how
+ * often each <foreach> repeats. Two parameter sets with equal shapes produce
+ * identical SQL text, so the shape can key a cache of generated statements.
+ * 动态SQL的形状签名：分支取值位图加集合长度，形状相同则生成的SQL相同
+ */
+class SqlShape
+{
+public:
+    void addFlag(bool taken);
+    void addCount(qsizetype count);
+
+    const QByteArray& key() const { return m_key; }
+
+private:
+    QByteArray m_key;
+    int m_bitPos = 8;  // Bits used in the last byte; 8 starts a new byte
+};
+
+/**
+ * @brief Immutable node of a compiled dynamic SQL statement
+ *
+ * Trees are built once when a mapper is loaded and evaluated in a single
+ * linear pass for every execution.
+ * 编译后的动态SQL语法树节点，加载时构建一次，执行时线性求值
+ */
+class SqlNode
+{
+public:
+    virtual ~SqlNode() = default;
+
+    virtual void apply(DynamicContext& context) const = 0;
+
+    /**
+     * @brief Record the decisions apply() would make, without generating SQL
+     */
+    virtual void appendShape(DynamicContext& context, SqlShape& shape) const = 0;
+
+    /**
+     * @brief Whether the node contains conditional or repeated elements
+     *
+     * Plain text is static: its #{param} references do not change the shape
+     * of the generated SQL.
+     */
+    virtual bool isDynamic() const = 0;
+};
+
+using SqlNodePtr = QSharedPointer<const SqlNode>;
+
+/**
+ * @brief Literal SQL text with pre-split #{param} references
+ */
+class TextSqlNode : public SqlNode
+{
+public:
+    explicit TextSqlNode(const QString& text);
+
+    void apply(DynamicContext& context) const override;
+    void appendShape(DynamicContext& context, SqlShape& shape) const override;
+    bool isDynamic() const override { return false; }
+
+    /**
+     * @brief Names of the #{param} references in text, in order of first appearance
+     */
+    static QStringList parameterReferences(const QString& text);
+
+private:
+    struct Segment
+    {
+        QString text;
+        bool isParameter = false;
+    };
+
+    QVector<Segment> m_segments;
+    bool m_hasParameters = false;
+};
+
+/**
+ * @brief Sequence of child nodes
+ */
+class MixedSqlNode : public SqlNode
+{
+public:
+    explicit MixedSqlNode(const QVector<SqlNodePtr>& children);
+
+    void apply(DynamicContext& context) const override;
+    void appendShape(DynamicContext& context, SqlShape& shape) const override;
+    bool isDynamic() const override;
+
+    const QVector<SqlNodePtr>& children() const { return m_children; }
+
+private:
+    QVector<SqlNodePtr> m_children;
+};
+
+/**
+ * @brief <if test="..."> and <when test="...">
+ */
+class IfSqlNode : public SqlNode
+{
+public:
+    IfSqlNode(const SqlExpression& test, SqlNodePtr contents);
+
+    void apply(DynamicContext& context) const override;
+    void appendShape(DynamicContext& context, SqlShape& shape) const override;
+    bool isDynamic() const override { return true; }
+
+    bool test(const DynamicContext& context) const;
+
+private:
+    SqlExpression m_test;
+    SqlNodePtr m_contents;
+};
+
+/**
+ * @brief <choose><when/>...<otherwise/></choose>
+ */
+class ChooseSqlNode : public SqlNode
+{
+public:
+    ChooseSqlNode(const QVector<QSharedPointer<const IfSqlNode>>& whens, SqlNodePtr otherwise);
+
+    void apply(DynamicContext& context) const override;
+    void appendShape(DynamicContext& context, SqlShape& shape) const override;
+    bool isDynamic() const override { return true; }
+
+private:
+    QVector<QSharedPointer<const IfSqlNode>> m_whens;
+    SqlNodePtr m_otherwise;
+};
+
+/**
+ * @brief <foreach collection="..." item="..." open="..." close="..." separator="..." padToBucket="...">
+ *
+ * #{item} references in the body expand to indexed placeholders (:ids_0,
+ * :ids_1, ...) that ParameterHandler resolves to the collection elements;
+ * characters a placeholder cannot hold become '_' (row.tags gives :row_tags_0).
+ * With padToBucket="true" the list is padded to the next power of two by
+ * repeating the last element, so IN lists of any length share a few statements.
+ * foreach元素绑定为带下标的占位符；开启padToBucket时按2的幂补齐，重复最后一个元素
+ */
+class ForEachSqlNode : public SqlNode
+{
+public:
+    ForEachSqlNode(const QString& collection, const QString& item,
+                   const QString& open, const QString& close,
+                   const QString& separator, SqlNodePtr contents, bool padToBucket = false);
+
+    void apply(DynamicContext& context) const override;
+    void appendShape(DynamicContext& context, SqlShape& shape) const override;
+    bool isDynamic() const override { return true; }
+
+private:
+    QVariantList collection(const DynamicContext& context) const;
+    qsizetype iterationCount(qsizetype size) const;
+
+    QString m_collection;
+    QString m_placeholderPrefix;  // Collection name with non-placeholder characters as '_', plus '_'
+    QString m_item;
+    QString m_open;
+    QString m_close;
+    QString m_separator;
+    SqlNodePtr m_contents;
+    bool m_padToBucket;
+};
+
+/**
+ * @brief <trim>, and the <where>/<set> specialisations built on it
+ */
+class TrimSqlNode : public SqlNode
+{
+public:
+    TrimSqlNode(SqlNodePtr contents,
+                const QString& prefix, const QStringList& prefixOverrides,
+                const QString& suffix, const QStringList& suffixOverrides);
+
+    static QSharedPointer<TrimSqlNode> where(SqlNodePtr contents);
+    static QSharedPointer<TrimSqlNode> set(SqlNodePtr contents);
+
+    void apply(DynamicContext& context) const override;
+    void appendShape(DynamicContext& context, SqlShape& shape) const override;
+    bool isDynamic() const override;
+
+private:
+    SqlNodePtr m_contents;
+    QString m_prefix;
+    QStringList m_prefixOverrides;
+    QString m_suffix;
+    QStringList m_suffixOverrides;
+};
+
+/**
+ * @brief Compiles MyBatis-style SQL text into an SqlNode tree
+ *
+ * Recognises <if>, <choose>/<when>/<otherwise>, <foreach>, <where>, <set> and
+ * <trim>. Any other '<' is kept as literal SQL text.
+ * 将MyBatis风格的SQL文本编译为语法树
+ */
+class SqlNodeBuilder
+{
+public:
+    static SqlNodePtr build(const QString& sql);
+
+private:
+    struct ParsedNode
+    {
+        QString tag;
+        SqlNodePtr node;
+    };
+
+    explicit SqlNodeBuilder(const QString& sql);
+
+    QVector<ParsedNode> parseContents(const QString& closingTag);
+    bool matchClosingTag(const QString& tagName);
+    bool matchOpeningTag(QString& tagName, QHash<QString, QString>& attributes, bool& selfClosing);
+    ParsedNode buildElement(const QString& tagName, const QHash<QString, QString>& attributes,
+                            const QVector<ParsedNode>& contents);
+
+    static SqlNodePtr toNode(const QVector<ParsedNode>& contents);
+
+    const QString& m_sql;
+    int m_pos;
+};
+
+} // namespace QtMyBatisORM
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <QSharedPointer>
+#include <QString>
+#include <QStringList>
+#include "datamodels.h"
+#include "export.h"
+
+namespace QtMyBatisORM {
+
+struct BindingPlan;
+
+/**
+ * Mapped statement resolved and analysed once, immutable afterwards
+ * 预先解析的语句：SQL、绑定计划、缓存策略与表集合只计算一次
+ *
+ * A static statement (no <if>, <foreach>, ...) is rendered with every #{param}
+ * as its named placeholder, so running it needs neither the SQL shape cache nor
+ * the binding plan cache. Dynamic statements still render per call.
+ */
+struct CompiledStatement
+{
+    QString id;                 // Statement id as resolved, also the result cache key prefix
+    StatementConfig config;
+    StatementOptions options;   // Cache policy, timeout and row limits of the statement
+    bool dynamic = false;
+    QString processedSql;       // Rendered SQL of a static statement
+    QSharedPointer<const BindingPlan> bindingPlan;  // Placeholder layout of processedSql
+    QStringList tables;         // Tables whose cached results a write invalidates
+    QStringList tablePatterns;  // Invalidation pattern of each table
+    QString namespacePattern;   // Result cache keys of the statement's namespace
+};
+
+/**
+ * Pre-resolved statement for Session calls without a per-call id lookup
+ * 预解析语句句柄
+ *
+ * Obtained once from SessionFactory::statement() and kept for the lifetime of
+ * the factory; copies share the compiled statement and may be used from any
+ * thread. A default-constructed handle is invalid.
+ *
+ * @code
+ * const StatementHandle findById = factory->statement("Student.findById");
+ * QVariant student = session->selectOne(findById, {{"id", 42}});
+ * @endcode
+ */
+class QTMYBATISORM_EXPORT StatementHandle
+{
+public:
+    StatementHandle() = default;
+    explicit StatementHandle(QSharedPointer<const CompiledStatement> statement);
+
+    bool isValid() const;
+    QString id() const;
+    StatementType type() const;
+
+    // Null for an invalid handle
+    const CompiledStatement* compiled() const;
+
+private:
+    QSharedPointer<const CompiledStatement> m_statement;
+};
+
+} // namespace QtMyBatisORM
@@ -5,10 +5,12 @@
 #include <QSqlDatabase>
 #include <QString>
 #include <QVariantMap>
+#include <QSharedPointer>
 
 namespace QtMyBatisORM {
 
 class DynamicSqlProcessor;
+class PreparedStatementCache;
 
 /**
  * SQL statement handler
@@ -20,16 +22,24 @@ class StatementHandler : public QObject
 public:
     explicit StatementHandler(QObject* parent = nullptr);
     
-    QSqlQuery prepare(const QString& sql, QSqlDatabase& db);
+    // forwardOnly is applied before prepare(); drivers may not honour a later change
+    QSqlQuery prepare(const QString& sql, QSqlDatabase& db, bool forwardOnly = false);
+    // Hands the query back to the connection cache; it must not be used afterwards
+    void release(const QString& sql, QSqlQuery& query);
     void setParameters(QSqlQuery& query, const QVariantMap& parameters);
     
     QString processSql(const QString& sql, const QVariantMap& parameters);
     
+    // Per-connection prepared statement cache (optional)
+    void setPreparedStatementCache(QSharedPointer<PreparedStatementCache> cache);
+    QSharedPointer<PreparedStatementCache> preparedStatementCache() const;
+    
 private:
     void bindParameter(QSqlQuery& query, const QString& placeholder, const QVariant& value);
     QStringList extractPlaceholders(const QString& sql);
     
     DynamicSqlProcessor* m_dynamicProcessor;
+    QSharedPointer<PreparedStatementCache> m_statementCache;
 };
 
 } // namespace QtMyBatisORM
\ No newline at end of file
@@ -31,6 +31,7 @@ private:
     StatementType parseStatementType(const QString& tagName);
     QHash<QString, QString> parseDynamicElements(const QDomElement& element);
     QString extractSqlText(const QDomElement& element);
+    QString extractSqlContent(const QDomElement& element);
     QString readResourceFile(const QString& resourcePath);
     void validateMapper(const MapperConfig& config);
 };
@@ -218,6 +218,18 @@ void CacheManager::invalidateByPattern(const QString& pattern)
     }
 }
 
+quint64 CacheManager::tableVersion(const QString& tableName) const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_tableVersions.value(tableName, 0);
+}
+
+void CacheManager::bumpTableVersion(const QString& tableName)
+{
+    QMutexLocker locker(&m_mutex);
+    ++m_tableVersions[tableName];
+}
+
 bool CacheManager::contains(const QString& key) const
 {
     if (!m_enabled) {
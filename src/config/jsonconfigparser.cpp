@@ -74,11 +74,13 @@ DatabaseConfig JSONConfigParser::parseFromJsonObject(const QJsonObject& jsonObj)
     config.minConnections = dbConfig.value(QStringLiteral("min_connection_count")).toInt(2);
     config.maxWaitTime = dbConfig.value(QStringLiteral("max_wait_time")).toInt(5000);
     config.maxIdleTime = dbConfig.value(QStringLiteral("max_idle_time")).toInt(300);
+    config.asyncWorkerCount = dbConfig.value(QStringLiteral("async_worker_count")).toInt(2);
 
     // 解析缓存配置
     config.cacheEnabled = dbConfig.value(QStringLiteral("cache_enabled")).toBool(true);
     config.maxCacheSize = dbConfig.value(QStringLiteral("max_cache_size")).toInt(1000);
     config.cacheExpireTime = dbConfig.value(QStringLiteral("cache_expire_time")).toInt(600);
+    config.preparedStatementCacheSize = dbConfig.value(QStringLiteral("prepared_statement_cache_size")).toInt(64);
     
     // 解析SQL文件列表
     QJsonArray sqlFilesArray = dbConfig.value(QStringLiteral("sql_files")).toArray();
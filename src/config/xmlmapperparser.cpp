@@ -1,12 +1,42 @@
 #include "QtMyBatisORM/xmlmapperparser.h"
 #include "QtMyBatisORM/qtmybatisexception.h"
+#include "QtMyBatisORM/dynamicsqlprocessor.h"
 #include <QResource>
 #include <QDomDocument>
 #include <QDomElement>
 #include <QDomNodeList>
+#include <QDomNamedNodeMap>
 
 namespace QtMyBatisORM {
 
+namespace {
+
+bool parseBoolAttribute(const QDomElement& element, const QString& name, bool defaultValue)
+{
+    if (!element.hasAttribute(name)) {
+        return defaultValue;
+    }
+    return element.attribute(name).trimmed().compare(QLatin1String("true"), Qt::CaseInsensitive) == 0;
+}
+
+int parseIntAttribute(const QDomElement& element, const QString& name, const QString& statementId)
+{
+    if (!element.hasAttribute(name)) {
+        return 0;
+    }
+    bool ok = false;
+    const int value = element.attribute(name).trimmed().toInt(&ok);
+    if (!ok || value < 0) {
+        throw ConfigurationException(
+            QStringLiteral("Invalid %1 \"%2\" in statement %3: expected a non-negative integer")
+            .arg(name, element.attribute(name), statementId)
+        );
+    }
+    return value;
+}
+
+} // namespace
+
 XMLMapperParser::XMLMapperParser(QObject* parent)
     : QObject(parent)
 {
@@ -108,13 +138,33 @@ StatementConfig XMLMapperParser::parseStatement(const QDomElement& element)
     config.type = parseStatementType(element.tagName());
     config.parameterType = element.attribute(QStringLiteral("parameterType"));
     config.resultType = element.attribute(QStringLiteral("resultType"));
-    config.useCache = element.attribute("useCache", "false") == QStringLiteral("true");
+    
+    // 未设置的属性由StatementConfig::options()按语句类型取MyBatis默认值：查询使用缓存，增删改刷新缓存
+    if (element.hasAttribute(QStringLiteral("useCache"))) {
+        config.useCache = parseBoolAttribute(element, QStringLiteral("useCache"), false);
+    }
+    if (element.hasAttribute(QStringLiteral("flushCache"))) {
+        config.flushCache = parseBoolAttribute(element, QStringLiteral("flushCache"), false);
+    }
+    config.timeout = parseIntAttribute(element, QStringLiteral("timeout"), config.id);
+    config.fetchSize = parseIntAttribute(element, QStringLiteral("fetchSize"), config.id);
+    config.maxRows = parseIntAttribute(element, QStringLiteral("maxRows"), config.id);
+    config.useGeneratedKeys = parseBoolAttribute(element, QStringLiteral("useGeneratedKeys"), false);
+    config.keyProperty = element.attribute(QStringLiteral("keyProperty"));
+    config.keyColumn = element.attribute(QStringLiteral("keyColumn"));
     
     // 解析动态SQL元素
     config.dynamicElements = parseDynamicElements(element);
     
-    // 提取SQL文本，包括动态元素的占位符
+    // 提取SQL文本（保留动态元素标签），并在加载时编译为语法树
     config.sql = extractSqlText(element);
+    try {
+        config.sqlNode = DynamicSqlProcessor::compile(config.sql);
+    } catch (const MappingException& e) {
+        throw ConfigurationException(
+            QStringLiteral("Invalid dynamic SQL in statement %1: %2").arg(config.id, e.message())
+        );
+    }
     
     return config;
 }
@@ -167,9 +217,20 @@ QHash<QString, QString> XMLMapperParser::parseDynamicElements(const QDomElement&
 
 QString XMLMapperParser::extractSqlText(const QDomElement& element)
 {
+    return extractSqlContent(element).trimmed();
+}
+
+QString XMLMapperParser::extractSqlContent(const QDomElement& element)
+{
+    static const QStringList dynamicTags = {
+        QStringLiteral("if"), QStringLiteral("foreach"), QStringLiteral("choose"),
+        QStringLiteral("when"), QStringLiteral("otherwise"), QStringLiteral("where"),
+        QStringLiteral("set"), QStringLiteral("trim")
+    };
+
     QString sql;
     
-    // 遍历所有子节点，提取文本内容和动态元素占位符
+    // 遍历所有子节点，提取文本内容；动态元素按原样保留标签，供SqlNodeBuilder编译
     QDomNodeList childNodes = element.childNodes();
     for (int i = 0; i < childNodes.count(); ++i) {
         QDomNode node = childNodes.at(i);
@@ -180,23 +241,29 @@ QString XMLMapperParser::extractSqlText(const QDomElement& element)
         }
         else if (node.isElement()) {
             QDomElement childElement = node.toElement();
+            const QString tagName = childElement.tagName();
             
-            if (childElement.tagName() == QStringLiteral("if")) {
-                // if元素，添加占位符
-                sql += QStringLiteral(" ${if_%1} ").arg(i);
-            }
-            else if (childElement.tagName() == QStringLiteral("foreach")) {
-                // foreach元素，添加占位符
-                sql += QStringLiteral(" ${foreach_%1} ").arg(i);
+            if (dynamicTags.contains(tagName)) {
+                sql += QStringLiteral("<") + tagName;
+                QDomNamedNodeMap attributes = childElement.attributes();
+                for (int j = 0; j < attributes.count(); ++j) {
+                    QDomAttr attr = attributes.item(j).toAttr();
+                    QString value = attr.value();
+                    value.replace(QLatin1Char('&'), QLatin1String("&amp;"));
+                    value.replace(QLatin1Char('"'), QLatin1String("&quot;"));
+                    sql += QStringLiteral(" %1=\"%2\"").arg(attr.name(), value);
+                }
+                sql += QStringLiteral(">") + extractSqlContent(childElement)
+                     + QStringLiteral("</") + tagName + QStringLiteral(">");
             }
             else {
                 // 其他元素，递归提取文本
-                sql += extractSqlText(childElement);
+                sql += extractSqlContent(childElement);
             }
         }
     }
     
-    return sql.trimmed();
+    return sql;
 }
 
 QString XMLMapperParser::readResourceFile(const QString& resourcePath)
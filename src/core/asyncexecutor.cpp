@@ -0,0 +1,219 @@
+#include "QtMyBatisORM/asyncexecutor.h"
+#include "QtMyBatisORM/session.h"
+#include "QtMyBatisORM/executor.h"
+#include "QtMyBatisORM/connectionpool.h"
+#include "QtMyBatisORM/cachemanager.h"
+#include "QtMyBatisORM/mapperregistry.h"
+#include "QtMyBatisORM/qtmybatisexception.h"
+#include <QMutexLocker>
+#include <QThread>
+#include <QDebug>
+
+namespace QtMyBatisORM {
+
+AsyncExecutor::AsyncExecutor(QSharedPointer<ConnectionPool> connectionPool,
+                             QSharedPointer<CacheManager> cacheManager,
+                             QSharedPointer<MapperRegistry> mapperRegistry,
+                             int workerCount)
+    : m_connectionPool(connectionPool)
+    , m_cacheManager(cacheManager)
+    , m_mapperRegistry(mapperRegistry)
+    , m_coreWorkers(qMax(1, workerCount))
+    , m_workerCount(m_coreWorkers)
+{
+}
+
+AsyncExecutor::~AsyncExecutor()
+{
+    shutdown();
+}
+
+void AsyncExecutor::post(std::function<void(Session&)> work, std::function<void(std::exception_ptr)> onError)
+{
+    Task task;
+    task.run = std::move(work);
+    task.fail = std::move(onError);
+    enqueue(std::move(task));
+}
+
+void AsyncExecutor::enqueue(Task task)
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (m_shutdown) {
+        locker.unlock();
+        task.fail(std::make_exception_ptr(
+            ConnectionException(QStringLiteral("Async executor is shut down"), "ASYNC_EXECUTOR_SHUTDOWN")));
+        return;
+    }
+
+    m_tasks.enqueue(std::move(task));
+
+    // 工作线程在首次提交时启动
+    startWorkers();
+
+    m_taskAvailable.wakeOne();
+}
+
+void AsyncExecutor::ensureWorkers(int count)
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (m_shutdown || count <= m_workerCount) {
+        return;
+    }
+
+    m_workerCount = count;
+    if (m_liveWorkers > 0) {
+        startWorkers();
+    }
+}
+
+void AsyncExecutor::setInterceptors(const InterceptorChain& interceptors)
+{
+    QMutexLocker locker(&m_mutex);
+    m_interceptors = interceptors;
+}
+
+void AsyncExecutor::startWorkers()
+{
+    reapFinishedWorkers();
+
+    for (; m_liveWorkers < m_workerCount; ++m_liveWorkers) {
+        QThread* thread = QThread::create([this]() { runWorker(); });
+        thread->setObjectName(QStringLiteral("QtMyBatisORM-Async-%1").arg(m_liveWorkers + 1));
+        m_threads.append(thread);
+        thread->start();
+    }
+}
+
+void AsyncExecutor::reapFinishedWorkers()
+{
+    // 已退出的扩容线程在这里回收
+    for (auto it = m_threads.begin(); it != m_threads.end();) {
+        if ((*it)->isFinished()) {
+            (*it)->wait();
+            delete *it;
+            it = m_threads.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void AsyncExecutor::runWorker()
+{
+    // 连接、Executor和Session都在本线程中创建和销毁
+    QSharedPointer<QSqlDatabase> connection;
+    QSharedPointer<Session> session;
+    InterceptorChain interceptors;
+    bool ranTask = false;
+
+    for (;;) {
+        Task task;
+        {
+            QMutexLocker locker(&m_mutex);
+            bool retired = false;
+            while (m_tasks.isEmpty() && !m_shutdown) {
+                if (m_liveWorkers <= m_coreWorkers) {
+                    m_taskAvailable.wait(&m_mutex);
+                } else if (ranTask || !m_taskAvailable.wait(&m_mutex, WorkerKeepAliveMs)) {
+                    // 扩容出的工作线程在队列清空后退出，连接归还给连接池
+                    if (m_tasks.isEmpty() && !m_shutdown && m_liveWorkers > m_coreWorkers) {
+                        --m_liveWorkers;
+                        m_workerCount = m_liveWorkers;
+                        retired = true;
+                        break;
+                    }
+                }
+            }
+            if (retired || m_tasks.isEmpty()) {
+                break;
+            }
+            task = m_tasks.dequeue();
+            ranTask = true;
+            if (!session) {
+                interceptors = m_interceptors;
+            }
+        }
+
+        if (!session) {
+            try {
+                connection = m_connectionPool->getThreadConnection();
+
+                QSharedPointer<Executor> executor = QSharedPointer<Executor>::create(connection, m_cacheManager);
+                executor->setPreparedStatementCache(m_connectionPool->getPreparedStatementCache(connection));
+                executor->setInterceptors(interceptors);
+                session = QSharedPointer<Session>::create(connection, executor, m_mapperRegistry);
+            } catch (...) {
+                // 取不到连接时让本次任务失败，下一个任务再重试
+                if (connection) {
+                    m_connectionPool->releaseThreadConnection(connection);
+                    connection.clear();
+                }
+                task.fail(std::current_exception());
+                continue;
+            }
+        }
+
+        task.run(*session);
+
+        // 任务遗留的未提交事务不能带入下一个任务
+        if (session->isInTransaction()) {
+            try {
+                session->rollback();
+            } catch (const QtMyBatisException& e) {
+                qWarning() << "[AsyncExecutor] Failed to roll back abandoned transaction:" << e.message();
+            }
+        }
+    }
+
+    if (session) {
+        session->close();
+        session.reset();
+    }
+    if (connection) {
+        m_connectionPool->releaseThreadConnection(connection);
+    }
+}
+
+void AsyncExecutor::shutdown()
+{
+    QQueue<Task> cancelled;
+    QList<QThread*> threads;
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_shutdown) {
+            return;
+        }
+        m_shutdown = true;
+        cancelled.swap(m_tasks);
+        threads.swap(m_threads);
+        m_taskAvailable.wakeAll();
+    }
+
+    for (Task& task : cancelled) {
+        task.fail(std::make_exception_ptr(
+            ConnectionException(QStringLiteral("Async executor is shut down"), "ASYNC_EXECUTOR_SHUTDOWN")));
+    }
+
+    // 等待正在执行的任务完成，工作线程在退出前归还自己的连接
+    for (QThread* thread : threads) {
+        thread->wait();
+        delete thread;
+    }
+}
+
+int AsyncExecutor::workerCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_workerCount;
+}
+
+int AsyncExecutor::pendingTasks() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_tasks.size();
+}
+
+} // namespace QtMyBatisORM
@@ -0,0 +1,212 @@
+#include "QtMyBatisORM/batchloader.h"
+#include "QtMyBatisORM/session.h"
+#include "QtMyBatisORM/qtmybatisexception.h"
+
+#include <QAbstractEventDispatcher>
+#include <QMetaObject>
+#include <utility>
+
+namespace QtMyBatisORM {
+
+LoaderResult::LoaderResult(QSharedPointer<State> state, BatchLoader* loader)
+    : m_state(std::move(state))
+    , m_loader(loader)
+{
+}
+
+bool LoaderResult::isReady() const
+{
+    return !m_state || m_state->ready;
+}
+
+QVariant LoaderResult::value() const
+{
+    if (!m_state) {
+        return QVariant();
+    }
+
+    // 尚未加载时立即执行合并查询
+    if (!m_state->ready && m_loader) {
+        m_loader->dispatch();
+    }
+    if (!m_state->ready) {
+        throw SessionException(
+            QStringLiteral("BatchLoader was destroyed before the key was loaded"),
+            "SESSION_LOADER_ERROR"
+        );
+    }
+    if (m_state->error) {
+        std::rethrow_exception(m_state->error);
+    }
+    return m_state->value;
+}
+
+BatchLoader::BatchLoader(Session* session, const QString& statementId, const QString& keyParam,
+                         const QString& keyColumn, QObject* parent)
+    : QObject(parent)
+    , m_session(session)
+    , m_statementId(statementId)
+    , m_keyParam(keyParam)
+    , m_keyColumn(keyColumn)
+{
+}
+
+LoaderResult BatchLoader::load(const QVariant& key)
+{
+    if (key.isNull()) {
+        QSharedPointer<LoaderResult::State> state = QSharedPointer<LoaderResult::State>::create();
+        state->ready = true;
+        return LoaderResult(state, this);
+    }
+
+    // 同一作用域内的重复键直接复用已有结果（或等待中的结果）
+    const QString text = keyString(key);
+    auto it = m_results.constFind(text);
+    if (it != m_results.constEnd()) {
+        return LoaderResult(it.value(), this);
+    }
+
+    QSharedPointer<LoaderResult::State> state = QSharedPointer<LoaderResult::State>::create();
+    m_results.insert(text, state);
+    m_pendingKeys.append(key);
+    m_pendingStates.append(state);
+    scheduleDispatch();
+
+    return LoaderResult(state, this);
+}
+
+QVariantList BatchLoader::loadMany(const QVariantList& keys)
+{
+    QList<LoaderResult> pending;
+    pending.reserve(keys.size());
+    for (const QVariant& key : keys) {
+        pending.append(load(key));
+    }
+    dispatch();
+
+    QVariantList values;
+    values.reserve(pending.size());
+    for (const LoaderResult& result : pending) {
+        values.append(result.value());
+    }
+    return values;
+}
+
+void BatchLoader::prime(const QVariant& key, const QVariant& value)
+{
+    if (key.isNull()) {
+        return;
+    }
+
+    const QString text = keyString(key);
+    if (m_results.contains(text)) {
+        return;
+    }
+
+    QSharedPointer<LoaderResult::State> state = QSharedPointer<LoaderResult::State>::create();
+    state->value = value;
+    state->ready = true;
+    m_results.insert(text, state);
+}
+
+void BatchLoader::dispatch()
+{
+    m_dispatchScheduled = false;
+    if (m_pendingKeys.isEmpty()) {
+        return;
+    }
+
+    const QVariantList keys = std::exchange(m_pendingKeys, {});
+    const QList<QSharedPointer<LoaderResult::State>> states = std::exchange(m_pendingStates, {});
+    ++m_dispatchCount;
+
+    try {
+        if (!m_session) {
+            throw SessionException(
+                QStringLiteral("BatchLoader for %1 has no session").arg(m_statementId),
+                "SESSION_LOADER_ERROR"
+            );
+        }
+
+        // 所有等待中的键合并为一次按键批量查询
+        const QHash<QString, QVariantMap> rows =
+            m_session->selectMapByKeys(m_statementId, m_keyParam, keys, m_keyColumn);
+        for (int i = 0; i < keys.size(); ++i) {
+            auto row = rows.constFind(keyString(keys.at(i)));
+            if (row != rows.constEnd()) {
+                states.at(i)->value = row.value();
+            }
+            states.at(i)->ready = true;
+        }
+    } catch (...) {
+        // 错误交给每个调用方的value()；失败的键不做记忆，之后的load会重新查询
+        const std::exception_ptr error = std::current_exception();
+        for (int i = 0; i < keys.size(); ++i) {
+            states.at(i)->error = error;
+            states.at(i)->ready = true;
+            m_results.remove(keyString(keys.at(i)));
+        }
+    }
+}
+
+void BatchLoader::clear()
+{
+    // 等待中的键保留，它们的调用方仍持有结果句柄
+    QHash<QString, QSharedPointer<LoaderResult::State>> pending;
+    for (int i = 0; i < m_pendingKeys.size(); ++i) {
+        pending.insert(keyString(m_pendingKeys.at(i)), m_pendingStates.at(i));
+    }
+    m_results = pending;
+}
+
+void BatchLoader::clear(const QVariant& key)
+{
+    const QString text = keyString(key);
+    auto it = m_results.find(text);
+    if (it != m_results.end() && it.value()->ready) {
+        m_results.erase(it);
+    }
+}
+
+void BatchLoader::setAutoDispatch(bool enabled)
+{
+    m_autoDispatch = enabled;
+}
+
+bool BatchLoader::autoDispatch() const
+{
+    return m_autoDispatch;
+}
+
+int BatchLoader::pendingCount() const
+{
+    return m_pendingKeys.size();
+}
+
+int BatchLoader::dispatchCount() const
+{
+    return m_dispatchCount;
+}
+
+QString BatchLoader::keyString(const QVariant& key)
+{
+    // 与selectMapByKeys的结果键一致：整数1与字符串"1"视为同一个键
+    return key.toString();
+}
+
+void BatchLoader::scheduleDispatch()
+{
+    if (!m_autoDispatch || m_dispatchScheduled || !QAbstractEventDispatcher::instance(thread())) {
+        return;
+    }
+
+    // 当前事件循环轮次内的所有load合并，下一轮开始时统一查询
+    m_dispatchScheduled = true;
+    QMetaObject::invokeMethod(this, [this]() {
+        if (m_dispatchScheduled) {
+            dispatch();
+        }
+    }, Qt::QueuedConnection);
+}
+
+} // namespace QtMyBatisORM
@@ -0,0 +1,59 @@
+#include "QtMyBatisORM/cancellationtoken.h"
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <atomic>
+#include <utility>
+
+namespace QtMyBatisORM {
+
+struct CancellationToken::State
+{
+    std::atomic<bool> cancelled{false};
+    QMutex mutex;
+    std::function<void()> interrupt;
+};
+
+CancellationToken CancellationToken::create()
+{
+    CancellationToken token;
+    token.m_state = QSharedPointer<State>::create();
+    return token;
+}
+
+void CancellationToken::cancel()
+{
+    if (!m_state) {
+        return;
+    }
+
+    m_state->cancelled.store(true, std::memory_order_release);
+
+    // 在锁内调用，保证执行器清除处理函数后不会再被调用
+    QMutexLocker locker(&m_state->mutex);
+    if (m_state->interrupt) {
+        m_state->interrupt();
+    }
+}
+
+bool CancellationToken::isCancelled() const
+{
+    return m_state && m_state->cancelled.load(std::memory_order_acquire);
+}
+
+bool CancellationToken::isValid() const
+{
+    return !m_state.isNull();
+}
+
+void CancellationToken::setInterruptHandler(std::function<void()> handler) const
+{
+    if (!m_state) {
+        return;
+    }
+
+    QMutexLocker locker(&m_state->mutex);
+    m_state->interrupt = std::move(handler);
+}
+
+} // namespace QtMyBatisORM
@@ -3,168 +3,1915 @@
 #include "QtMyBatisORM/parameterhandler.h"
 #include "QtMyBatisORM/resulthandler.h"
 #include "QtMyBatisORM/cachemanager.h"
+#include "QtMyBatisORM/preparedstatementcache.h"
+#include "QtMyBatisORM/dynamicsqlprocessor.h"
+#include "QtMyBatisORM/sqlnode.h"
 #include "QtMyBatisORM/qtmybatisexception.h"
 #include "QtMyBatisORM/objectpool.h"
+#include "QtMyBatisORM/propertyplan.h"
 
 #include <QSqlQuery>
 #include <QSqlError>
+#include <QSqlDriver>
 #include <QCryptographicHash>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QRegularExpression>
 #include <QElapsedTimer>
+#include <QVersionNumber>
+#include <QSet>
+#include <QDeadlineTimer>
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QAtomicInt>
+#include <atomic>
+#include <memory>
+
+#ifdef QTMYBATISORM_HAVE_SQLITE3
+#include <sqlite3.h>
+#endif
 
 namespace QtMyBatisORM {
 
 // 参数处理器对象池
 static ObjectPool<ParameterHandler> g_parameterHandlerPool(10, 20);
 
-Executor::Executor(QSharedPointer<QSqlDatabase> connection, 
-                  QSharedPointer<CacheManager> cacheManager,
-                  QObject* parent)
-    : QObject(parent)
-    , m_connection(connection)
-    , m_cacheManager(cacheManager)
-    , m_debugMode(false)
+namespace {
+
+/**
+ * Single-row INSERT ... VALUES (...) split around its value tuple,
+ * with the tuple's named placeholders turned into '?'
+ */
+struct ValuesTemplate
 {
-    m_statementHandler = QSharedPointer<StatementHandler>::create();
-    m_parameterHandler = QSharedPointer<ParameterHandler>::create();
-    m_resultHandler = QSharedPointer<ResultHandler>::create();
+    QString head;   // Up to and excluding the opening '(' of the tuple
+    QString tuple;  // "(?, ?, ...)"
+    QString tail;   // Everything after the closing ')'
+};
+
+bool isWordChar(QChar ch)
+{
+    return ch.isLetterOrNumber() || ch == QLatin1Char('_');
+}
+
+bool isQuoteChar(QChar ch)
+{
+    return ch == QLatin1Char('\'') || ch == QLatin1Char('"') || ch == QLatin1Char('`');
+}
+
+bool splitValuesClause(const QString& sql, const BindingPlan& plan, ValuesTemplate& out)
+{
+    const QStringView view(sql);
+    const int n = sql.size();
+    
+    int start = 0;
+    while (start < n && sql.at(start).isSpace()) {
+        ++start;
+    }
+    if (!view.mid(start).startsWith(QLatin1String("INSERT"), Qt::CaseInsensitive)
+        && !view.mid(start).startsWith(QLatin1String("REPLACE"), Qt::CaseInsensitive)) {
+        return false;
+    }
+    
+    // 查找引号外的VALUES关键字
+    int valuesPos = -1;
+    QChar closingQuote;
+    for (int i = start; i < n; ++i) {
+        const QChar ch = sql.at(i);
+        if (!closingQuote.isNull()) {
+            if (ch == closingQuote) {
+                closingQuote = QChar();
+            }
+            continue;
+        }
+        if (isQuoteChar(ch)) {
+            closingQuote = ch;
+            continue;
+        }
+        if ((i == 0 || !isWordChar(sql.at(i - 1)))
+            && view.mid(i, 6).compare(QLatin1String("VALUES"), Qt::CaseInsensitive) == 0
+            && (i + 6 >= n || !isWordChar(sql.at(i + 6)))) {
+            valuesPos = i;
+            break;
+        }
+    }
+    if (valuesPos < 0) {
+        return false;
+    }
+    
+    int open = valuesPos + 6;
+    while (open < n && sql.at(open).isSpace()) {
+        ++open;
+    }
+    if (open >= n || sql.at(open) != QLatin1Char('(')) {
+        return false;
+    }
+    
+    // 查找匹配的右括号
+    int close = -1;
+    int depth = 0;
+    closingQuote = QChar();
+    for (int i = open; i < n; ++i) {
+        const QChar ch = sql.at(i);
+        if (!closingQuote.isNull()) {
+            if (ch == closingQuote) {
+                closingQuote = QChar();
+            }
+        } else if (isQuoteChar(ch)) {
+            closingQuote = ch;
+        } else if (ch == QLatin1Char('(')) {
+            ++depth;
+        } else if (ch == QLatin1Char(')') && --depth == 0) {
+            close = i;
+            break;
+        }
+    }
+    if (close < 0) {
+        return false;
+    }
+    
+    // 已经是多行VALUES的语句不再改写
+    int next = close + 1;
+    while (next < n && sql.at(next).isSpace()) {
+        ++next;
+    }
+    if (next < n && sql.at(next) == QLatin1Char(',')) {
+        return false;
+    }
+    
+    // 所有占位符都必须位于值元组内
+    if (plan.offsets.isEmpty()) {
+        return false;
+    }
+    for (int offset : plan.offsets) {
+        if (offset < open || offset > close) {
+            return false;
+        }
+    }
+    
+    out.head = sql.left(open);
+    out.tail = sql.mid(close + 1);
+    out.tuple.clear();
+    
+    int last = open;
+    for (int pos = 0; pos < plan.offsets.size(); ++pos) {
+        const int offset = plan.offsets.at(pos);
+        out.tuple += view.mid(last, offset - last);
+        out.tuple += QLatin1Char('?');
+        last = offset + 1 + plan.names.at(plan.positions.at(pos)).size();
+    }
+    out.tuple += view.mid(last, close + 1 - last);
     
-    // 初始化SQL处理缓存
-    m_processedSqlCache.reserve(200); // 预分配更多空间以提高性能
+    return true;
 }
 
-QVariant Executor::query(const QString& sql, const QVariantMap& parameters)
+QString buildMultiRowSql(const ValuesTemplate& values, int rowCount)
 {
-    return queryInternal(sql, parameters, QString(), false);
+    QString sql;
+    sql.reserve(values.head.size() + (values.tuple.size() + 1) * rowCount + values.tail.size());
+    sql += values.head;
+    for (int row = 0; row < rowCount; ++row) {
+        if (row > 0) {
+            sql += QLatin1Char(',');
+        }
+        sql += values.tuple;
+    }
+    sql += values.tail;
+    return sql;
 }
 
-QVariantList Executor::queryList(const QString& sql, const QVariantMap& parameters)
+/**
+ * Identifier without its quoting: "name", `name` or [name]
+ */
+QString unquoteIdentifier(QStringView identifier)
+{
+    identifier = identifier.trimmed();
+    if (identifier.size() >= 2) {
+        const QChar first = identifier.front();
+        const QChar last = identifier.back();
+        if ((isQuoteChar(first) && last == first)
+            || (first == QLatin1Char('[') && last == QLatin1Char(']'))) {
+            return identifier.mid(1, identifier.size() - 2).toString();
+        }
+    }
+    return identifier.toString();
+}
+
+/**
+ * INSERT INTO t (columns) VALUES (...) rewritten into the dialect's upsert:
+ * SQLite/PostgreSQL ON CONFLICT (keys) DO UPDATE, MySQL ON DUPLICATE KEY UPDATE.
+ * Every inserted column except the conflict keys is overwritten with the new value.
+ * keyParameters receives the named placeholder bound to each conflict key, or stays
+ * empty when a key's value is an expression.
+ */
+QString buildUpsertSql(const QString& sql, const QStringList& conflictKeys, QSqlDriver::DbmsType dbms,
+                       QStringList* keyParameters = nullptr)
+{
+    auto fail = [&sql](const QString& reason) {
+        return SqlExecutionException(QStringLiteral("Cannot build upsert: %1. SQL: %2").arg(reason, sql));
+    };
+    
+    if (dbms != QSqlDriver::SQLite && dbms != QSqlDriver::PostgreSQL && dbms != QSqlDriver::MySqlServer) {
+        throw fail(QStringLiteral("the database driver has no supported upsert syntax"));
+    }
+    if (conflictKeys.isEmpty()) {
+        throw fail(QStringLiteral("conflict keys are required"));
+    }
+    
+    static const QRegularExpression insertHead(
+        QStringLiteral("^\\s*INSERT\\s+INTO\\s+(?:[`\"\\[]?[\\w.]+[`\"\\]]?)\\s*\\("),
+        QRegularExpression::CaseInsensitiveOption);
+    static const QRegularExpression existingClause(
+        QStringLiteral("\\bON\\s+(?:CONFLICT|DUPLICATE)\\b"), QRegularExpression::CaseInsensitiveOption);
+    
+    const QRegularExpressionMatch head = insertHead.match(sql);
+    if (!head.hasMatch()) {
+        throw fail(QStringLiteral("the statement is not INSERT INTO table (columns) VALUES (...)"));
+    }
+    if (existingClause.match(sql).hasMatch()) {
+        throw fail(QStringLiteral("the statement already has a conflict clause"));
+    }
+    
+    // 列清单
+    QStringList columns;
+    const int open = head.capturedEnd() - 1;
+    int close = -1;
+    int last = open + 1;
+    QChar closingQuote;
+    for (int i = last; i < sql.size(); ++i) {
+        const QChar ch = sql.at(i);
+        if (!closingQuote.isNull()) {
+            if (ch == closingQuote) {
+                closingQuote = QChar();
+            }
+        } else if (isQuoteChar(ch)) {
+            closingQuote = ch;
+        } else if (ch == QLatin1Char(',') || ch == QLatin1Char(')')) {
+            columns.append(QStringView(sql).mid(last, i - last).trimmed().toString());
+            last = i + 1;
+            if (ch == QLatin1Char(')')) {
+                close = i;
+                break;
+            }
+        }
+    }
+    
+    int valuesPos = close + 1;
+    while (valuesPos < sql.size() && sql.at(valuesPos).isSpace()) {
+        ++valuesPos;
+    }
+    if (close < 0 || QStringView(sql).mid(valuesPos, 6).compare(QLatin1String("VALUES"), Qt::CaseInsensitive) != 0) {
+        throw fail(QStringLiteral("the statement is not INSERT INTO table (columns) VALUES (...)"));
+    }
+    
+    QSet<QString> keys;
+    for (const QString& key : conflictKeys) {
+        keys.insert(unquoteIdentifier(key).toLower());
+    }
+    
+    // VALUES元组中与列一一对应的值表达式
+    QStringList valueItems;
+    int tuplePos = valuesPos + 6;
+    while (tuplePos < sql.size() && sql.at(tuplePos).isSpace()) {
+        ++tuplePos;
+    }
+    if (tuplePos < sql.size() && sql.at(tuplePos) == QLatin1Char('(')) {
+        int depth = 0;
+        int itemStart = tuplePos + 1;
+        closingQuote = QChar();
+        for (int i = tuplePos; i < sql.size(); ++i) {
+            const QChar ch = sql.at(i);
+            if (!closingQuote.isNull()) {
+                if (ch == closingQuote) {
+                    closingQuote = QChar();
+                }
+            } else if (isQuoteChar(ch)) {
+                closingQuote = ch;
+            } else if (ch == QLatin1Char('(')) {
+                ++depth;
+            } else if ((ch == QLatin1Char(',') && depth == 1) || (ch == QLatin1Char(')') && --depth == 0)) {
+                valueItems.append(QStringView(sql).mid(itemStart, i - itemStart).trimmed().toString());
+                itemStart = i + 1;
+                if (depth == 0) {
+                    break;
+                }
+            }
+        }
+    }
+    
+    static const QRegularExpression namedPlaceholder(QStringLiteral("^:(\\w+)$"));
+    QStringList keyParameterNames;
+    bool plainKeys = valueItems.size() == columns.size();
+    
+    QStringList assignments;
+    for (int i = 0; i < columns.size(); ++i) {
+        const QString& column = columns.at(i);
+        if (keys.contains(unquoteIdentifier(column).toLower())) {
+            const QRegularExpressionMatch placeholder = plainKeys
+                ? namedPlaceholder.match(valueItems.at(i)) : QRegularExpressionMatch();
+            plainKeys = placeholder.hasMatch();
+            if (plainKeys) {
+                keyParameterNames.append(placeholder.captured(1));
+            }
+            continue;
+        }
+        assignments.append(dbms == QSqlDriver::MySqlServer
+            ? QStringLiteral("%1 = VALUES(%1)").arg(column)
+            : QStringLiteral("%1 = excluded.%1").arg(column));
+    }
+    
+    QString result = sql.trimmed();
+    while (result.endsWith(QLatin1Char(';'))) {
+        result.chop(1);
+    }
+    
+    if (dbms == QSqlDriver::MySqlServer) {
+        // MySQL按表上所有唯一键判断冲突；conflictKeys只用于排除不更新的列
+        if (assignments.isEmpty()) {
+            assignments.append(QStringLiteral("%1 = %1").arg(conflictKeys.first()));
+        }
+        result += QLatin1String(" ON DUPLICATE KEY UPDATE ") + assignments.join(QLatin1String(", "));
+    } else {
+        result += QLatin1String(" ON CONFLICT (") + conflictKeys.join(QLatin1String(", ")) + QLatin1Char(')');
+        result += assignments.isEmpty()
+            ? QStringLiteral(" DO NOTHING")
+            : QLatin1String(" DO UPDATE SET ") + assignments.join(QLatin1String(", "));
+    }
+    
+    if (keyParameters) {
+        *keyParameters = plainKeys && keyParameterNames.size() == keys.size() ? keyParameterNames : QStringList();
+    }
+    return result;
+}
+
+/**
+ * Rows sharing conflict key values reduced to the last of them, kept rows in input order.
+ * Rows with a key value that has no string form are never merged.
+ */
+QList<QVariantMap> lastRowPerConflictKey(const QList<QVariantMap>& rows, const QStringList& keyParameters)
+{
+    QHash<QString, qsizetype> lastRow;
+    lastRow.reserve(rows.size());
+    QList<QString> rowKeys;
+    rowKeys.reserve(rows.size());
+    for (qsizetype i = 0; i < rows.size(); ++i) {
+        QString rowKey;
+        for (const QString& name : keyParameters) {
+            const QVariant value = rows.at(i).value(name);
+            const QString text = value.toString();
+            if (value.isNull() || (text.isEmpty() && value.typeId() != QMetaType::QString)) {
+                // NULL不触发冲突，没有字符串形式的值无法可靠比较
+                rowKey.clear();
+                break;
+            }
+            rowKey += QString::number(value.typeId()) + QLatin1Char(':') + text + QChar(0x1f);
+        }
+        rowKeys.append(rowKey);
+        if (!rowKey.isEmpty()) {
+            lastRow.insert(rowKey, i);
+        }
+    }
+    if (lastRow.size() == rows.size()) {
+        return rows;
+    }
+    
+    QList<QVariantMap> kept;
+    kept.reserve(lastRow.size());
+    for (qsizetype i = 0; i < rows.size(); ++i) {
+        if (rowKeys.at(i).isEmpty() || lastRow.value(rowKeys.at(i)) == i) {
+            kept.append(rows.at(i));
+        }
+    }
+    return kept;
+}
+
+/**
+ * Options of the legacy *WithCache entry points: cached reads, flushing writes
+ */
+StatementOptions cachedReadOptions()
+{
+    StatementOptions options;
+    options.useCache = true;
+    return options;
+}
+
+StatementOptions cachedWriteOptions()
+{
+    StatementOptions options;
+    options.flushCache = true;
+    return options;
+}
+
+/**
+ * Position right after a leading SELECT keyword, or -1
+ */
+int selectKeywordEnd(const QString& sql)
+{
+    int start = 0;
+    while (start < sql.size() && sql.at(start).isSpace()) {
+        ++start;
+    }
+    const int end = start + 6;
+    if (QStringView(sql).mid(start, 6).compare(QLatin1String("SELECT"), Qt::CaseInsensitive) != 0
+        || (end < sql.size() && isWordChar(sql.at(end)))) {
+        return -1;
+    }
+    return end;
+}
+
+/**
+ * Statement text without surrounding whitespace and trailing semicolons
+ */
+QString trimStatement(const QString& sql)
+{
+    QString result = sql.trimmed();
+    while (result.endsWith(QLatin1Char(';'))) {
+        result.chop(1);
+        result = result.trimmed();
+    }
+    return result;
+}
+
+/**
+ * Whether the clause starts a keyword outside parentheses and quotes. A keyword follows whitespace
+ * or ')', so parameter names such as #{limit} never match.
+ */
+bool hasTopLevelClause(const QString& sql, const QRegularExpression& clause)
+{
+    int depth = 0;
+    QChar closingQuote;
+    for (int i = 0; i < sql.size(); ++i) {
+        const QChar ch = sql.at(i);
+        if (!closingQuote.isNull()) {
+            if (ch == closingQuote) {
+                closingQuote = QChar();
+            }
+        } else if (isQuoteChar(ch)) {
+            closingQuote = ch;
+        } else if (ch == QLatin1Char('(')) {
+            ++depth;
+        } else if (ch == QLatin1Char(')')) {
+            --depth;
+        } else if (depth == 0 && ch.isLetter()
+                   && (i == 0 || sql.at(i - 1).isSpace() || sql.at(i - 1) == QLatin1Char(')'))
+                   && clause.match(sql, i, QRegularExpression::NormalMatch,
+                                   QRegularExpression::AnchorAtOffsetMatchOption).hasMatch()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Whether ORDER BY appears outside parentheses and quotes
+ */
+bool hasTopLevelOrderBy(const QString& sql)
+{
+    static const QRegularExpression orderBy(QStringLiteral("ORDER\\s+BY\\b"),
+                                            QRegularExpression::CaseInsensitiveOption);
+    return hasTopLevelClause(sql, orderBy);
+}
+
+/**
+ * Whether the statement limits its own rows with LIMIT, OFFSET or FETCH outside parentheses and quotes
+ */
+bool hasTopLevelRowLimit(const QString& sql)
+{
+    static const QRegularExpression rowLimit(QStringLiteral("(LIMIT|OFFSET|FETCH)\\b"),
+                                             QRegularExpression::CaseInsensitiveOption);
+    return hasTopLevelClause(sql, rowLimit);
+}
+
+/**
+ * Statement without its trailing ORDER BY, when nothing after it can be a subquery, tag or literal.
+ * A statement that limits its own rows is returned unchanged: its ORDER BY selects which rows are kept.
+ */
+QString withoutTrailingOrderBy(const QString& sql)
+{
+    if (hasTopLevelRowLimit(sql)) {
+        return sql;
+    }
+    
+    static const QRegularExpression trailingOrderBy(
+        QStringLiteral("\\s+ORDER\\s+BY\\s+[^()<>'\"]*$"), QRegularExpression::CaseInsensitiveOption);
+    QString result = sql;
+    result.remove(trailingOrderBy);
+    return result;
+}
+
+/**
+ * SQL Server and Oracle page with OFFSET/FETCH instead of LIMIT/OFFSET
+ */
+bool usesOffsetFetch(QSqlDriver::DbmsType dbms)
+{
+    return dbms == QSqlDriver::MSSqlServer || dbms == QSqlDriver::Oracle;
+}
+
+/**
+ * Page and count statements derived from a select, per dialect
+ */
+struct PagingSql
+{
+    QString pageSql;   // Statement + LIMIT/OFFSET bound to #{_pageLimit}/#{_pageOffset}
+    QString countSql;  // SELECT COUNT(*) over the statement without its trailing ORDER BY
+};
+
+PagingSql buildPagingSql(const QString& sql, QSqlDriver::DbmsType dbms)
+{
+    // 分页改写只依赖语句文本和方言，每条语句构建一次
+    static QMutex cacheMutex;
+    static QHash<QString, PagingSql> pagingCache;
+    
+    const QString cacheKey = QString::number(dbms) + QLatin1Char('\n') + sql;
+    {
+        QMutexLocker locker(&cacheMutex);
+        auto it = pagingCache.constFind(cacheKey);
+        if (it != pagingCache.constEnd()) {
+            return it.value();
+        }
+        
+        // 防止缓存无限增长
+        if (pagingCache.size() > 1000) {
+            pagingCache.clear();
+        }
+    }
+    
+    const QString base = trimStatement(sql);
+    
+    // 语句自带的LIMIT/OFFSET/FETCH会与分页子句冲突，计数也会统计到限制之外的行
+    if (hasTopLevelRowLimit(base)) {
+        throw SqlExecutionException(
+            QStringLiteral("Paged statements must not limit their own rows (LIMIT/OFFSET/FETCH); "
+                           "selectPage adds the page clause. SQL: %1").arg(base)
+        );
+    }
+    
+    PagingSql result;
+    if (usesOffsetFetch(dbms)) {
+        // SQL Server的OFFSET/FETCH必须跟在ORDER BY之后，没有排序时按任意顺序分页
+        const QString ordered = dbms == QSqlDriver::MSSqlServer && !hasTopLevelOrderBy(base)
+            ? QString(base + QLatin1String(" ORDER BY (SELECT NULL)"))
+            : base;
+        result.pageSql = ordered + QLatin1String(" OFFSET #{_pageOffset} ROWS FETCH NEXT #{_pageLimit} ROWS ONLY");
+    } else {
+        result.pageSql = base + QLatin1String(" LIMIT #{_pageLimit} OFFSET #{_pageOffset}");
+    }
+    
+    // 计数不需要排序
+    result.countSql = QLatin1String("SELECT COUNT(*) FROM (") + withoutTrailingOrderBy(base)
+                      + QLatin1String(") qmb_count");
+    
+    {
+        QMutexLocker locker(&cacheMutex);
+        pagingCache.insert(cacheKey, result);
+    }
+    return result;
+}
+
+/**
+ * Keyset page of a select: the statement wrapped, filtered to rows after #{_keyset0..n},
+ * ordered by the key columns and limited to #{_pageLimit}
+ */
+QString buildKeysetSql(const QString& sql, const QStringList& keyColumns, bool afterKey,
+                       QSqlDriver::DbmsType dbms)
+{
+    static QMutex cacheMutex;
+    static QHash<QString, QString> keysetCache;
+    
+    const QString cacheKey = QString::number(dbms) + QLatin1Char(afterKey ? '>' : '^')
+                             + keyColumns.join(QLatin1Char(',')) + QLatin1Char('\n') + sql;
+    {
+        QMutexLocker locker(&cacheMutex);
+        auto it = keysetCache.constFind(cacheKey);
+        if (it != keysetCache.constEnd()) {
+            return it.value();
+        }
+        
+        // 防止缓存无限增长
+        if (keysetCache.size() > 1000) {
+            keysetCache.clear();
+        }
+    }
+    
+    // 包装后的外层条件会被SQLite、MySQL和PostgreSQL下推到内层，仍可使用键列上的索引
+    QString result = QLatin1String("SELECT * FROM (") + withoutTrailingOrderBy(trimStatement(sql))
+                     + QLatin1String(") qmb_keyset");
+    
+    if (afterKey) {
+        QStringList placeholders;
+        for (int i = 0; i < keyColumns.size(); ++i) {
+            placeholders.append(QStringLiteral("#{_keyset%1}").arg(i));
+        }
+        
+        result += QLatin1String(" WHERE ");
+        if (keyColumns.size() == 1) {
+            result += keyColumns.first() + QLatin1String(" > ") + placeholders.first();
+        } else if (dbms == QSqlDriver::SQLite || dbms == QSqlDriver::MySqlServer
+                   || dbms == QSqlDriver::PostgreSQL) {
+            // 行值比较
+            result += QLatin1Char('(') + keyColumns.join(QLatin1String(", ")) + QLatin1String(") > (")
+                      + placeholders.join(QLatin1String(", ")) + QLatin1Char(')');
+        } else {
+            // 不支持行值比较的方言展开为 (k1 > a) OR (k1 = a AND k2 > b) ...
+            QStringList terms;
+            for (int i = 0; i < keyColumns.size(); ++i) {
+                QStringList conditions;
+                for (int j = 0; j < i; ++j) {
+                    conditions.append(keyColumns.at(j) + QLatin1String(" = ") + placeholders.at(j));
+                }
+                conditions.append(keyColumns.at(i) + QLatin1String(" > ") + placeholders.at(i));
+                terms.append(QLatin1Char('(') + conditions.join(QLatin1String(" AND ")) + QLatin1Char(')'));
+            }
+            result += terms.join(QLatin1String(" OR "));
+        }
+    }
+    
+    result += QLatin1String(" ORDER BY ") + keyColumns.join(QLatin1String(", "));
+    result += usesOffsetFetch(dbms)
+        ? QLatin1String(" OFFSET 0 ROWS FETCH NEXT #{_pageLimit} ROWS ONLY")
+        : QLatin1String(" LIMIT #{_pageLimit}");
+    
+    {
+        QMutexLocker locker(&cacheMutex);
+        keysetCache.insert(cacheKey, result);
+    }
+    return result;
+}
+
+} // namespace
+
+/**
+ * Deadline and cancellation of the statement executed while it is alive
+ *
+ * Inactive (no allocation, no thread) when the options carry neither a
+ * timeout nor a cancellation token. SQLite is interrupted in-process through
+ * the driver handle when built WITH_SQLITE_INTERRUPT (Qt with -system-sqlite);
+ * MySQL gets KILL QUERY from a watchdog thread on a side
+ * connection, which leaves the pooled connection usable. Other drivers only
+ * get the cancellation check before the statement starts.
+ */
+class Executor::QueryDeadline
 {
-    return queryListInternal(sql, parameters, QString(), false);
+public:
+    QueryDeadline(Executor* executor, const StatementOptions& options)
+        : m_cancellation(options.cancellation)
+        , m_timeoutMs(options.effectiveTimeoutMs())
+    {
+        if (m_timeoutMs <= 0 && !m_cancellation.isValid()) {
+            return;
+        }
+        
+        if (m_cancellation.isCancelled()) {
+            throw TimeoutException(QStringLiteral("Statement was cancelled before it started"), "QUERY_CANCELLED");
+        }
+        
+        m_active = true;
+        m_deadline = m_timeoutMs > 0 ? QDeadlineTimer(m_timeoutMs) : QDeadlineTimer(QDeadlineTimer::Forever);
+        
+        const QSqlDatabase& db = *executor->m_connection;
+        switch (db.driver()->dbmsType()) {
+        case QSqlDriver::SQLite:
+            armSqlite(db);
+            break;
+        case QSqlDriver::MySqlServer:
+            armMySql(db, executor->mysqlConnectionId());
+            break;
+        default:
+            break;
+        }
+    }
+    
+    ~QueryDeadline()
+    {
+        if (!m_active) {
+            return;
+        }
+        
+        // 先清除取消回调（等待并发的cancel返回），回调引用了本对象
+        m_cancellation.setInterruptHandler(nullptr);
+        
+#ifdef QTMYBATISORM_HAVE_SQLITE3
+        if (m_sqlite && !m_deadline.isForever()) {
+            sqlite3_progress_handler(m_sqlite, 0, nullptr, nullptr);
+        }
+#endif
+        
+        // 连接归还连接池前，确保KILL QUERY已结束
+        if (m_watchdog) {
+            {
+                QMutexLocker locker(&m_mutex);
+                m_done = true;
+                m_wake.wakeAll();
+            }
+            m_watchdog->wait();
+        }
+    }
+    
+    QueryDeadline(const QueryDeadline&) = delete;
+    QueryDeadline& operator=(const QueryDeadline&) = delete;
+    
+    /**
+     * @brief Turns the failure of an interrupted statement into TimeoutException
+     *
+     * Called from the executor's catch block; returns when the statement failed
+     * for some other reason.
+     */
+    void throwIfInterrupted() const
+    {
+        if (!m_active) {
+            return;
+        }
+        
+        if (m_cancellation.isCancelled()) {
+            throw TimeoutException(QStringLiteral("Statement was cancelled"), "QUERY_CANCELLED");
+        }
+        if (m_interrupted.load(std::memory_order_acquire) || m_deadline.hasExpired()) {
+            throw TimeoutException(QStringLiteral("Statement exceeded its deadline of %1 ms").arg(m_timeoutMs));
+        }
+    }
+    
+private:
+    void armSqlite(const QSqlDatabase& db)
+    {
+#ifdef QTMYBATISORM_HAVE_SQLITE3
+        const QVariant handle = db.driver()->handle();
+        if (!handle.isValid() || qstrcmp(handle.typeName(), "sqlite3*") != 0) {
+            return;
+        }
+        m_sqlite = *static_cast<sqlite3* const*>(handle.constData());
+        if (!m_sqlite) {
+            return;
+        }
+        
+        // 进度回调每1000条虚拟机指令检查一次截止时间
+        if (!m_deadline.isForever()) {
+            sqlite3_progress_handler(m_sqlite, 1000, &QueryDeadline::sqliteProgress, this);
+        }
+        
+        sqlite3* sqlite = m_sqlite;
+        m_cancellation.setInterruptHandler([this, sqlite]() {
+            m_interrupted.store(true, std::memory_order_release);
+            sqlite3_interrupt(sqlite);
+        });
+#else
+        // 未链接SQLite库时无法中断，仅保留执行前的取消检查
+        Q_UNUSED(db)
+#endif
+    }
+    
+#ifdef QTMYBATISORM_HAVE_SQLITE3
+    static int sqliteProgress(void* context)
+    {
+        auto* self = static_cast<QueryDeadline*>(context);
+        if (self->m_deadline.hasExpired()) {
+            self->m_interrupted.store(true, std::memory_order_release);
+            return 1; // 非零返回值使当前语句以SQLITE_INTERRUPT失败
+        }
+        return 0;
+    }
+#endif
+    
+    void armMySql(const QSqlDatabase& db, qint64 connectionId)
+    {
+        if (connectionId <= 0) {
+            return;
+        }
+        
+        m_watchdog.reset(QThread::create([this, connectionName = db.connectionName(), connectionId]() {
+            {
+                QMutexLocker locker(&m_mutex);
+                while (!m_done && !m_cancelRequested) {
+                    if (!m_wake.wait(&m_mutex, m_deadline)) {
+                        break; // 到达截止时间
+                    }
+                }
+                if (m_done) {
+                    return;
+                }
+            }
+            killQuery(connectionName, connectionId);
+            m_interrupted.store(true, std::memory_order_release);
+        }));
+        
+        m_cancellation.setInterruptHandler([this]() {
+            QMutexLocker locker(&m_mutex);
+            m_cancelRequested = true;
+            m_wake.wakeAll();
+        });
+        
+        m_watchdog->start();
+    }
+    
+    static void killQuery(const QString& connectionName, qint64 connectionId)
+    {
+        // 旁路连接在看门狗线程中克隆并使用，执行完即移除
+        static QAtomicInt sequence;
+        const QString sideName = QStringLiteral("qtmybatis_kill_%1").arg(sequence.fetchAndAddRelaxed(1));
+        {
+            QSqlDatabase side = QSqlDatabase::cloneDatabase(connectionName, sideName);
+            if (side.open()) {
+                QSqlQuery kill(side);
+                if (!kill.exec(QStringLiteral("KILL QUERY %1").arg(connectionId))) {
+                    qWarning() << "KILL QUERY failed:" << kill.lastError().text();
+                }
+            }
+        }
+        QSqlDatabase::removeDatabase(sideName);
+    }
+    
+    CancellationToken m_cancellation;
+    int m_timeoutMs;
+    bool m_active = false;
+    QDeadlineTimer m_deadline;
+    std::atomic<bool> m_interrupted{false};
+    
+#ifdef QTMYBATISORM_HAVE_SQLITE3
+    sqlite3* m_sqlite = nullptr;
+#endif
+    
+    std::unique_ptr<QThread> m_watchdog;
+    QMutex m_mutex;
+    QWaitCondition m_wake;
+    bool m_done = false;
+    bool m_cancelRequested = false;
+};
+
+Executor::Executor(QSharedPointer<QSqlDatabase> connection, 
+                  QSharedPointer<CacheManager> cacheManager,
+                  QObject* parent)
+    : QObject(parent)
+    , m_connection(connection)
+    , m_cacheManager(cacheManager)
+    , m_debugMode(false)
+{
+    m_statementHandler = QSharedPointer<StatementHandler>::create();
+    m_parameterHandler = QSharedPointer<ParameterHandler>::create();
+    m_resultHandler = QSharedPointer<ResultHandler>::create();
+}
+
+QVariant Executor::query(const QString& sql, const QVariantMap& parameters)
+{
+    return queryInternal(sql, parameters, QString(), StatementOptions());
+}
+
+QVariantList Executor::queryList(const QString& sql, const QVariantMap& parameters)
+{
+    return queryListInternal(sql, parameters, QString(), StatementOptions());
+}
+
+int Executor::update(const QString& sql, const QVariantMap& parameters)
+{
+    return updateInternal(sql, parameters, QString(), cachedWriteOptions());
+}
+
+QVariant Executor::queryWithCache(const QString& statementId, const QString& sql, 
+                                 const QVariantMap& parameters)
+{
+    return queryWithCache(statementId, sql, parameters, cachedReadOptions());
+}
+
+QVariantList Executor::queryListWithCache(const QString& statementId, const QString& sql, 
+                                         const QVariantMap& parameters)
+{
+    return queryListWithCache(statementId, sql, parameters, cachedReadOptions());
+}
+
+ResultSet Executor::queryResultSetWithCache(const QString& statementId, const QString& sql,
+                                            const QVariantMap& parameters)
+{
+    return queryResultSetWithCache(statementId, sql, parameters, cachedReadOptions());
+}
+
+int Executor::updateWithCacheInvalidation(const QString& statementId, const QString& sql, 
+                                          const QVariantMap& parameters)
+{
+    return updateInternal(sql, parameters, statementId, cachedWriteOptions());
+}
+
+QVariant Executor::queryWithCache(const QString& statementId, const QString& sql,
+                                 const QVariantMap& parameters, const StatementOptions& options)
+{
+    return queryInternal(sql, parameters, statementId, options);
+}
+
+QVariantList Executor::queryListWithCache(const QString& statementId, const QString& sql,
+                                         const QVariantMap& parameters, const StatementOptions& options)
+{
+    // 列表结果按QVariantList缓存，命中时只复制隐式共享的列表，不重新构造每一行
+    return queryListInternal(sql, parameters, statementId, options);
+}
+
+ResultSet Executor::queryResultSetWithCache(const QString& statementId, const QString& sql,
+                                            const QVariantMap& parameters, const StatementOptions& options)
+{
+    return queryResultSetCached(statementId, sql, parameters, options, nullptr);
+}
+
+ResultSet Executor::queryResultSetCached(const QString& statementId, const QString& sql,
+                                         const QVariantMap& parameters, const StatementOptions& options,
+                                         const CompiledStatement* compiled)
+{
+    if (options.flushCache && m_cacheManager) {
+        invalidateCacheForStatement(statementId, sql, compiled);
+    }
+    
+    if (!readsResultCache(statementId, options)) {
+        return queryResultSetInternal(sql, parameters, options, compiled);
+    }
+    
+    // 生成缓存键：与selectList缓存的QVariantList分开保存
+    const QString cacheKey = generateCacheKey(statementId, parameters) + QLatin1String("#resultset");
+    
+    // 尝试从缓存获取结果
+    QVariant cachedResult = m_cacheManager->get(cacheKey);
+    if (cachedResult.metaType() == QMetaType::fromType<ResultSet>()) {
+        // 记录缓存命中调试信息
+        if (m_debugMode) {
+            qDebug() << QString("[Cache] Cache hit - StatementId: %1, CacheKey: %2")
+                        .arg(statementId, cacheKey);
+        }
+        return cachedResult.value<ResultSet>();
+    }
+    
+    // 记录缓存未命中调试信息
+    if (m_debugMode) {
+        qDebug() << QString("[Cache] Cache miss - StatementId: %1, CacheKey: %2")
+                    .arg(statementId, cacheKey);
+    }
+    
+    // 缓存中没有，执行查询
+    ResultSet result = queryResultSetInternal(sql, parameters, options, compiled);
+    
+    // 将结果存入缓存
+    if (!result.isEmpty()) {
+        m_cacheManager->put(cacheKey, QVariant::fromValue(result));
+        // 记录缓存存储调试信息
+        if (m_debugMode) {
+            qDebug() << QString("[Cache] Cache stored - StatementId: %1, CacheKey: %2, Records: %3")
+                        .arg(statementId, cacheKey).arg(result.rowCount());
+        }
+    }
+    
+    return result;
+}
+
+int Executor::updateWithCacheInvalidation(const QString& statementId, const QString& sql,
+                                          const QVariantMap& parameters, const StatementOptions& options)
+{
+    return updateInternal(sql, parameters, statementId, options);
+}
+
+QVariant Executor::queryWithCache(const CompiledStatement& statement, const QVariantMap& parameters,
+                                 const StatementOptions& options)
+{
+    return queryInternal(statement.config.sql, parameters, statement.id, options, &statement);
+}
+
+QVariantList Executor::queryListWithCache(const CompiledStatement& statement, const QVariantMap& parameters,
+                                         const StatementOptions& options)
+{
+    return queryListInternal(statement.config.sql, parameters, statement.id, options, &statement);
+}
+
+int Executor::updateWithCacheInvalidation(const CompiledStatement& statement, const QVariantMap& parameters,
+                                          const StatementOptions& options)
+{
+    return updateInternal(statement.config.sql, parameters, statement.id, options, nullptr, &statement);
+}
+
+QSharedPointer<const CompiledStatement> Executor::compileStatement(const QString& statementId,
+                                                                   const StatementConfig& statement)
+{
+    QSharedPointer<CompiledStatement> compiled = QSharedPointer<CompiledStatement>::create();
+    compiled->id = statementId;
+    compiled->config = statement;
+    compiled->options = statement.options();
+    
+    const SqlNodePtr root = statement.sqlNode ? statement.sqlNode : DynamicSqlProcessor::compile(statement.sql);
+    compiled->dynamic = root->isDynamic();
+    if (!compiled->dynamic) {
+        // 静态语句生成的SQL与参数值无关：按所有 #{param} 均已提供渲染一次，
+        // 调用时缺少的参数在绑定时报错，而不是原样保留在SQL中
+        QVariantMap references;
+        for (const QString& name : TextSqlNode::parameterReferences(statement.sql)) {
+            references.insert(name, QVariant());
+        }
+        compiled->processedSql = DynamicSqlProcessor::process(root, references);
+        compiled->bindingPlan = QSharedPointer<const BindingPlan>::create(BindingPlan::build(compiled->processedSql));
+    }
+    
+    compiled->tables = extractTableNamesFromSql(statement.sql);
+    for (const QString& tableName : std::as_const(compiled->tables)) {
+        compiled->tablePatterns.append(QStringLiteral(".*%1.*").arg(tableName));
+    }
+    const QString mapperNamespace = statementId.section(QLatin1Char('.'), 0, 0);
+    compiled->namespacePattern = QStringLiteral("^cache_%1\\.").arg(QRegularExpression::escape(mapperNamespace));
+    
+    return compiled;
+}
+
+int Executor::updateWithGeneratedKeys(const QString& statementId, const QString& sql,
+                                      const QVariantMap& parameters, const StatementOptions& options,
+                                      const QString& keyColumn, QVariantList& generatedKeys)
+{
+    // PostgreSQL的lastInsertId()只返回OID，改为随语句读取主键列
+    if (!keyColumn.isEmpty() && m_connection && m_connection->isOpen()
+        && m_connection->driver()->dbmsType() == QSqlDriver::PostgreSQL) {
+        return updateInternal(trimStatement(sql) + QLatin1String(" RETURNING ") + keyColumn,
+                              parameters, statementId, options, &generatedKeys);
+    }
+    return updateInternal(sql, parameters, statementId, options, &generatedKeys);
+}
+
+BatchResult Executor::updateBatch(const QString& statementId, const QString& sql,
+                                  const QList<QVariantMap>& parametersList, BatchStrategy strategy)
+{
+    return batchInternal(statementId, sql, parametersList, strategy, cachedWriteOptions(), {});
+}
+
+BatchResult Executor::updateBatch(const QString& statementId, const QString& sql,
+                                  const QList<QVariantMap>& parametersList, BatchStrategy strategy,
+                                  const StatementOptions& options)
+{
+    return batchInternal(statementId, sql, parametersList, strategy, options, {});
+}
+
+BatchResult Executor::upsertBatch(const QString& statementId, const QString& sql,
+                                  const QList<QVariantMap>& parametersList, const QStringList& conflictKeys,
+                                  BatchStrategy strategy)
+{
+    return batchInternal(statementId, sql, parametersList, strategy, cachedWriteOptions(), conflictKeys);
+}
+
+BatchResult Executor::upsertBatch(const QString& statementId, const QString& sql,
+                                  const QList<QVariantMap>& parametersList, const QStringList& conflictKeys,
+                                  BatchStrategy strategy, const StatementOptions& options)
+{
+    return batchInternal(statementId, sql, parametersList, strategy, options, conflictKeys);
+}
+
+BatchResult Executor::insertBatchWithKeys(const QString& statementId, const QString& sql,
+                                          const QList<QVariantMap>& parametersList, BatchStrategy strategy,
+                                          const QString& keyColumn, const StatementOptions& options)
+{
+    return batchInternal(statementId, sql, parametersList, strategy, options, {}, true, keyColumn);
+}
+
+BatchResult Executor::batchInternal(const QString& statementId, const QString& sql,
+                                    const QList<QVariantMap>& parametersList, BatchStrategy strategy,
+                                    const StatementOptions& options, const QStringList& conflictKeys,
+                                    bool collectKeys, const QString& keyColumn)
+{
+    if (!m_connection || !m_connection->isOpen()) {
+        throw ConnectionException(QStringLiteral("Database connection is not available"));
+    }
+    
+    BatchResult result;
+    if (parametersList.isEmpty()) {
+        return result;
+    }
+    
+    QElapsedTimer timer;
+    timer.start();
+    
+    // 截止时间覆盖整批（含动态SQL拆出的多条语句），而不是每条语句各自计时
+    QueryDeadline deadline(this, options);
+    
+    try {
+        const bool upsert = !conflictKeys.isEmpty();
+        auto runBatch = [&](const QString& processedSql, const QList<QVariantMap>& rows) {
+            // 冲突子句追加在VALUES之后，多行VALUES改写会原样保留
+            QStringList keyParameters;
+            const QString batchSql = upsert
+                ? buildUpsertSql(processedSql, conflictKeys, m_connection->driver()->dbmsType(), &keyParameters)
+                : processedSql;
+            if (strategy == BatchStrategy::MultiRowValues) {
+                // 同一条语句不能两次更新同一行（PostgreSQL直接报错），冲突键相同的行只保留最后一行；
+                // 非键列都取新值，最终结果与逐行执行相同
+                executeMultiRowInsert(batchSql,
+                                      keyParameters.isEmpty() ? rows : lastRowPerConflictKey(rows, keyParameters),
+                                      options, result, collectKeys, keyColumn);
+            } else if (collectKeys) {
+                // execBatch不返回逐行结果，逐行执行以读取生成键
+                executeRowsWithKeys(batchSql, rows, options, keyColumn, result);
+            } else {
+                const int affected = executeBatch(batchSql, rows, options);
+                result.chunkAffectedRows.append(affected);
+                result.totalAffected += affected;
+            }
+        };
+        
+        QString processedSql;
+        
+        if (!DynamicSqlProcessor::compile(sql)->isDynamic()) {
+            // 静态SQL：整批共用一条预编译语句
+            processedSql = getProcessedSql(sql, parametersList.first());
+            runBatch(processedSql, parametersList);
+        } else {
+            // 动态SQL：生成相同SQL的连续行合并为一批，保持原有执行顺序
+            QList<QVariantMap> run;
+            for (const QVariantMap& parameters : parametersList) {
+                const QString rowSql = getProcessedSql(sql, parameters);
+                if (!run.isEmpty() && rowSql != processedSql) {
+                    runBatch(processedSql, run);
+                    run.clear();
+                }
+                processedSql = rowSql;
+                run.append(parameters);
+            }
+            runBatch(processedSql, run);
+        }
+        
+        // 记录调试日志
+        if (m_debugMode) {
+            logSqlExecutionFlow(QStringLiteral("batch (%1 rows, %2 statements)")
+                               .arg(parametersList.size()).arg(result.chunkAffectedRows.size()),
+                               sql, parametersList.first(), processedSql, timer.elapsed(),
+                               QVariant(result.totalAffected));
+        }
+        
+        // 整批只做一次缓存失效
+        if (options.flushCache && m_cacheManager && result.totalAffected > 0) {
+            invalidateCacheForStatement(statementId, sql);
+        }
+        
+        return result;
+        
+    } catch (const QtMyBatisException&) {
+        // 失败前写入的行在外层事务提交后仍然生效，抛出前同样失效
+        if (options.flushCache && m_cacheManager) {
+            invalidateCacheForStatement(statementId, sql);
+        }
+        deadline.throwIfInterrupted();
+        throw; // 重新抛出已知异常
+    } catch (const std::exception& e) {
+        if (options.flushCache && m_cacheManager) {
+            invalidateCacheForStatement(statementId, sql);
+        }
+        throw SqlExecutionException(
+            QStringLiteral("Unexpected error during batch execution: %1").arg(QString::fromLatin1(e.what()))
+        );
+    }
+}
+
+int Executor::flushBatch(const QString& statementId, const QString& processedSql,
+                         const QList<QVariantMap>& parametersList, const StatementOptions& options)
+{
+    if (!m_connection || !m_connection->isOpen()) {
+        throw ConnectionException(QStringLiteral("Database connection is not available"));
+    }
+    
+    if (parametersList.isEmpty()) {
+        return 0;
+    }
+    
+    QElapsedTimer timer;
+    timer.start();
+    
+    QueryDeadline deadline(this, options);
+    
+    try {
+        // SQL已由Session按形状渲染并分组，整组共用一条预编译语句
+        const int affectedRows = executeBatch(processedSql, parametersList, options);
+        
+        if (m_debugMode) {
+            logSqlExecutionFlow(QStringLiteral("flush (%1 rows)").arg(parametersList.size()),
+                               processedSql, parametersList.first(), processedSql, timer.elapsed(),
+                               QVariant(affectedRows));
+        }
+        
+        if (options.flushCache && m_cacheManager && affectedRows > 0) {
+            invalidateCacheForStatement(statementId, processedSql);
+        }
+        
+        return affectedRows;
+        
+    } catch (const QtMyBatisException&) {
+        // 失败前写入的行在外层事务提交后仍然生效，抛出前同样失效
+        if (options.flushCache && m_cacheManager) {
+            invalidateCacheForStatement(statementId, processedSql);
+        }
+        deadline.throwIfInterrupted();
+        throw; // 重新抛出已知异常
+    } catch (const std::exception& e) {
+        if (options.flushCache && m_cacheManager) {
+            invalidateCacheForStatement(statementId, processedSql);
+        }
+        throw SqlExecutionException(
+            QStringLiteral("Unexpected error during batch execution: %1").arg(QString::fromLatin1(e.what()))
+        );
+    }
+}
+
+int Executor::executeBatch(const QString& processedSql, const QList<QVariantMap>& parametersList,
+                           const StatementOptions& options)
+{
+    if (m_interceptors) {
+        // 每行作为单条写操作经过Prepare、Parameterize和Update阶段，拦截器不会被批量执行绕过
+        int affectedRows = 0;
+        for (const QVariantMap& parameters : parametersList) {
+            QString rowSql = processedSql;
+            QSqlQuery query = prepareStatement(rowSql, parameters, options);
+            bindParameters(query, rowSql, parameters);
+            if (!execStatement(query, rowSql, parameters, InterceptPhase::Update)) {
+                throw SqlExecutionException(
+                    QStringLiteral("Failed to execute batch: %1. SQL: %2")
+                    .arg(query.lastError().text())
+                    .arg(rowSql)
+                );
+            }
+            affectedRows += query.numRowsAffected();
+            m_statementHandler->release(rowSql, query);
+        }
+        return affectedRows;
+    }
+    
+    QSqlQuery query = m_statementHandler->prepare(processedSql, *m_connection);
+    
+    const QSqlDriver* driver = m_connection->driver();
+    const bool nativeBatch = driver->hasFeature(QSqlDriver::BatchOperations);
+    const bool isSqlite = driver->dbmsType() == QSqlDriver::SQLite;
+    
+    int affectedRows = 0;
+    
+    if (nativeBatch || isSqlite) {
+        // QSQLite没有原生批量接口，execBatch逐行执行且只报告最后一行的受影响行数，
+        // 因此用total_changes()的差值统计整批结果
+        const qint64 changesBefore = nativeBatch ? 0 : sqliteTotalChanges();
+        
+        withBatchParameterHandler(query, parametersList);
+        
+        if (!query.execBatch()) {
+            throw SqlExecutionException(
+                QStringLiteral("Failed to execute batch: %1. SQL: %2")
+                .arg(query.lastError().text())
+                .arg(processedSql)
+            );
+        }
+        
+        affectedRows = nativeBatch ? query.numRowsAffected()
+                                   : static_cast<int>(sqliteTotalChanges() - changesBefore);
+    } else {
+        // 其他驱动的execBatch同样是逐行执行，这里直接复用同一条语句逐行执行以累计受影响行数
+        for (const QVariantMap& parameters : parametersList) {
+            withParameterHandler(query, parameters);
+            if (!query.exec()) {
+                throw SqlExecutionException(
+                    QStringLiteral("Failed to execute batch: %1. SQL: %2")
+                    .arg(query.lastError().text())
+                    .arg(processedSql)
+                );
+            }
+            affectedRows += query.numRowsAffected();
+        }
+    }
+    
+    m_statementHandler->release(processedSql, query);
+    return affectedRows;
+}
+
+void Executor::executeMultiRowInsert(const QString& processedSql, const QList<QVariantMap>& parametersList,
+                                     const StatementOptions& options, BatchResult& result,
+                                     bool collectKeys, const QString& keyColumn)
+{
+    const QSharedPointer<const BindingPlan> plan = ParameterHandler::bindingPlan(processedSql);
+    
+    // 生成键：RETURNING逐行返回，MySQL由第一行的自增值推算，其余驱动只能逐行执行
+    QString returning;
+    const bool contiguousKeys = collectKeys && m_connection->driver()->dbmsType() == QSqlDriver::MySqlServer;
+    if (collectKeys && !contiguousKeys) {
+        returning = returningColumn(keyColumn);
+    }
+    
+    // 拦截器按行处理参数，多行VALUES无法逐行经过Parameterize阶段，同样逐行执行
+    ValuesTemplate values;
+    if (m_interceptors || plan->mode != BindingPlan::Mode::Named || plan->positionalCount > 0
+        || !splitValuesClause(processedSql, *plan, values)
+        || (collectKeys && !contiguousKeys && returning.isEmpty())) {
+        if (collectKeys) {
+            executeRowsWithKeys(processedSql, parametersList, options, keyColumn, result);
+            return;
+        }
+        // 不是单行 INSERT ... VALUES (...) 语句，回退到execBatch
+        const int affected = executeBatch(processedSql, parametersList, options);
+        result.chunkAffectedRows.append(affected);
+        result.totalAffected += affected;
+        return;
+    }
+    
+    if (!returning.isEmpty()) {
+        QString tail = trimStatement(values.tail);
+        if (!tail.isEmpty()) {
+            tail.prepend(QLatin1Char(' '));
+        }
+        values.tail = tail + QLatin1String(" RETURNING ") + returning;
+    }
+    const int keyStep = contiguousKeys ? mysqlAutoIncrementStep() : 0;
+    
+    // 每块的行数受驱动绑定变量上限约束，同时限制单条语句的长度
+    static const int maxRowsPerChunk = 1000;
+    const int positionCount = plan->positions.size();
+    const int rowsPerChunk = qBound(1, maxBindVariables() / positionCount, maxRowsPerChunk);
+    
+    QString fullChunkSql;
+    for (int start = 0; start < parametersList.size(); start += rowsPerChunk) {
+        const int rowCount = qMin(rowsPerChunk, int(parametersList.size()) - start);
+        
+        // 满块的SQL相同，只构建一次，预编译语句也可复用
+        QString chunkSql;
+        if (rowCount == rowsPerChunk && !fullChunkSql.isEmpty()) {
+            chunkSql = fullChunkSql;
+        } else {
+            chunkSql = buildMultiRowSql(values, rowCount);
+            if (rowCount == rowsPerChunk) {
+                fullChunkSql = chunkSql;
+            }
+        }
+        
+        QSqlQuery query = m_statementHandler->prepare(chunkSql, *m_connection);
+        withMultiRowParameterHandler(query, *plan, parametersList.mid(start, rowCount));
+        
+        if (!query.exec()) {
+            throw SqlExecutionException(
+                QStringLiteral("Failed to execute multi-row insert: %1. SQL: %2")
+                .arg(query.lastError().text())
+                .arg(processedSql)
+            );
+        }
+        
+        int affected = 0;
+        if (!returning.isEmpty()) {
+            // RETURNING的每一行对应一条插入的记录
+            while (query.next()) {
+                result.generatedKeys.append(query.value(0));
+                ++affected;
+            }
+        } else {
+            affected = query.numRowsAffected();
+            if (contiguousKeys) {
+                // 多行INSERT的LAST_INSERT_ID()是第一行的值，同一语句内的自增值连续
+                const qint64 firstKey = query.lastInsertId().toLongLong();
+                for (int row = 0; row < rowCount; ++row) {
+                    result.generatedKeys.append(firstKey > 0 ? QVariant(firstKey + qint64(row) * keyStep) : QVariant());
+                }
+            }
+        }
+        m_statementHandler->release(chunkSql, query);
+        
+        result.chunkAffectedRows.append(affected);
+        result.totalAffected += affected;
+    }
+}
+
+void Executor::executeRowsWithKeys(const QString& processedSql, const QList<QVariantMap>& parametersList,
+                                   const StatementOptions& options, const QString& keyColumn, BatchResult& result)
+{
+    // 同一条预编译语句逐行执行，每行读取驱动报告的生成键（PostgreSQL以RETURNING读取）
+    const bool returning = !keyColumn.isEmpty()
+        && m_connection->driver()->dbmsType() == QSqlDriver::PostgreSQL;
+    const QString rowSql = returning
+        ? QString(trimStatement(processedSql) + QLatin1String(" RETURNING ") + keyColumn)
+        : processedSql;
+    
+    // 有拦截器时每行单独经过整条拦截器链
+    QSqlQuery query;
+    if (!m_interceptors) {
+        query = m_statementHandler->prepare(rowSql, *m_connection);
+    }
+    
+    int affectedRows = 0;
+    for (const QVariantMap& parameters : parametersList) {
+        QString statementSql = rowSql;
+        if (m_interceptors) {
+            query = prepareStatement(statementSql, parameters, options);
+            bindParameters(query, statementSql, parameters);
+        } else {
+            withParameterHandler(query, parameters);
+        }
+        if (!execStatement(query, statementSql, parameters, InterceptPhase::Update)) {
+            throw SqlExecutionException(
+                QStringLiteral("Failed to execute batch: %1. SQL: %2")
+                .arg(query.lastError().text())
+                .arg(statementSql)
+            );
+        }
+        if (returning) {
+            result.generatedKeys.append(query.next() ? query.value(0) : QVariant());
+        } else {
+            result.generatedKeys.append(query.lastInsertId());
+        }
+        affectedRows += query.numRowsAffected();
+        if (m_interceptors) {
+            m_statementHandler->release(statementSql, query);
+        }
+    }
+    
+    if (!m_interceptors) {
+        m_statementHandler->release(rowSql, query);
+    }
+    result.chunkAffectedRows.append(affectedRows);
+    result.totalAffected += affectedRows;
+}
+
+QString Executor::returningColumn(const QString& keyColumn)
+{
+    switch (m_connection->driver()->dbmsType()) {
+    case QSqlDriver::SQLite:
+        // RETURNING自SQLite 3.35.0起支持；未指定键列时返回rowid（INTEGER PRIMARY KEY即其别名）
+        if (m_sqliteReturning < 0) {
+            m_sqliteReturning = 0;
+            QSqlQuery query(*m_connection);
+            if (query.exec(QStringLiteral("SELECT sqlite_version()")) && query.next()) {
+                const QVersionNumber version = QVersionNumber::fromString(query.value(0).toString());
+                m_sqliteReturning = version >= QVersionNumber(3, 35, 0) ? 1 : 0;
+            }
+        }
+        if (m_sqliteReturning == 0) {
+            return QString();
+        }
+        return keyColumn.isEmpty() ? QStringLiteral("rowid") : keyColumn;
+    case QSqlDriver::PostgreSQL:
+        return keyColumn;
+    default:
+        return QString();
+    }
+}
+
+int Executor::mysqlAutoIncrementStep()
+{
+    // 多主复制等场景下自增步长可能大于1，连接期间不变，查询一次即可
+    if (m_autoIncrementStep == 0) {
+        QSqlQuery query(*m_connection);
+        m_autoIncrementStep = query.exec(QStringLiteral("SELECT @@auto_increment_increment")) && query.next()
+            ? qMax(1, query.value(0).toInt()) : 1;
+    }
+    return m_autoIncrementStep;
+}
+
+int Executor::maxBindVariables()
+{
+    if (m_maxBindVariables > 0) {
+        return m_maxBindVariables;
+    }
+    
+    switch (m_connection->driver()->dbmsType()) {
+    case QSqlDriver::SQLite: {
+        // SQLITE_MAX_VARIABLE_NUMBER 默认值：3.32.0 之前为999，之后为32766
+        m_maxBindVariables = 999;
+        QSqlQuery query(*m_connection);
+        if (query.exec(QStringLiteral("SELECT sqlite_version()")) && query.next()) {
+            const QVersionNumber version = QVersionNumber::fromString(query.value(0).toString());
+            if (version >= QVersionNumber(3, 32, 0)) {
+                m_maxBindVariables = 32766;
+            }
+        }
+        break;
+    }
+    case QSqlDriver::MySqlServer:
+        // MySQL预处理语句最多支持65535个占位符
+        m_maxBindVariables = 65535;
+        break;
+    default:
+        m_maxBindVariables = 999;
+        break;
+    }
+    
+    return m_maxBindVariables;
+}
+
+qint64 Executor::mysqlConnectionId()
+{
+    // KILL QUERY的目标线程号，连接在会话期间不变，查询一次即可
+    if (m_mysqlConnectionId == 0) {
+        QSqlQuery query(*m_connection);
+        m_mysqlConnectionId = query.exec(QStringLiteral("SELECT CONNECTION_ID()")) && query.next()
+            ? query.value(0).toLongLong() : -1;
+    }
+    return m_mysqlConnectionId;
+}
+
+qint64 Executor::sqliteTotalChanges()
+{
+    QSqlQuery query(*m_connection);
+    if (query.exec(QStringLiteral("SELECT total_changes()")) && query.next()) {
+        return query.value(0).toLongLong();
+    }
+    return 0;
+}
+
+void Executor::clearCache(const QString& pattern)
+{
+    if (m_cacheManager) {
+        if (pattern.isEmpty()) {
+            m_cacheManager->clear();
+            // 记录缓存清空调试信息
+            if (m_debugMode) {
+                qDebug() << "[Cache] Clear all cache";
+            }
+        } else {
+            m_cacheManager->invalidateByPattern(pattern);
+            // 记录缓存模式失效调试信息
+            if (m_debugMode) {
+                qDebug() << QString("[Cache] Invalidate cache by pattern - Pattern: %1").arg(pattern);
+            }
+        }
+    }
+}
+
+QVariant Executor::queryInternal(const QString& sql, const QVariantMap& parameters, 
+                                const QString& statementId, const StatementOptions& options,
+                                const CompiledStatement* compiled)
+{
+    if (!m_connection || !m_connection->isOpen()) {
+        throw ConnectionException(QStringLiteral("Database connection is not available"));
+    }
+    
+    QElapsedTimer timer;
+    timer.start();
+    
+    // flushCache的查询先清除相关缓存
+    if (options.flushCache && m_cacheManager) {
+        invalidateCacheForStatement(statementId, sql, compiled);
+    }
+    
+    // 只有useCache的语句才生成缓存键并访问CacheManager
+    const bool useCache = readsResultCache(statementId, options);
+    if (useCache) {
+        QString cacheKey = generateCacheKey(statementId, parameters);
+        QVariant cachedResult = m_cacheManager->get(cacheKey);
+        if (!cachedResult.isNull()) {
+            if (m_debugMode) {
+                logDebugInfo("selectOne (Cache hit)", statementId.isEmpty() ? sql : statementId,
+                            parameters, timer.elapsed(), cachedResult);
+            }
+            return cachedResult;
+        }
+    }
+    
+    QueryDeadline deadline(this, options);
+    
+    try {
+        // 使用优化的方法获取处理后的SQL
+        QString processedSql = getProcessedSql(sql, parameters, compiled);
+        
+        // 准备查询
+        QSqlQuery query = prepareStatement(processedSql, parameters, options);
+        
+        // 使用对象池或回退策略绑定参数
+        bindParameters(query, processedSql, parameters, compiled);
+        
+        // 执行查询
+        if (!execStatement(query, processedSql, parameters, InterceptPhase::Query)) {
+            throw SqlExecutionException(
+                QStringLiteral("Failed to execute query: %1. SQL: %2")
+                .arg(query.lastError().text())
+                .arg(processedSql)
+            );
+        }
+        
+        // 处理结果
+        QVariant result = m_resultHandler->handleSingleResult(query);
+        m_statementHandler->release(processedSql, query);
+        
+        // 记录调试日志 - 使用完整的SQL执行流程跟踪
+        if (m_debugMode) {
+            logSqlExecutionFlow("selectOne", sql, parameters, processedSql, 
+                               timer.elapsed(), result);
+        }   
+        
+        // 如果启用缓存，将结果存入缓存
+        if (useCache && !result.isNull()) {
+            QString cacheKey = generateCacheKey(statementId, parameters);
+            m_cacheManager->put(cacheKey, result);
+            // 记录缓存存储调试信息
+            if (m_debugMode) {
+                qDebug() << QString("[Cache] Cache stored - StatementId: %1, CacheKey: %2")
+                            .arg(statementId, cacheKey);
+            }
+        }
+        
+        return result;
+        
+    } catch (const QtMyBatisException&) {
+        deadline.throwIfInterrupted();
+        throw; // 重新抛出已知异常
+    } catch (const std::exception& e) {
+        throw SqlExecutionException(
+            QStringLiteral("Unexpected error during query execution: %1").arg(QString::fromLatin1(e.what()))
+        );
+    }
+}
+
+QVariantList Executor::queryListInternal(const QString& sql, const QVariantMap& parameters, 
+                                        const QString& statementId, const StatementOptions& options,
+                                        const CompiledStatement* compiled)
+{
+    if (!m_connection || !m_connection->isOpen()) {
+        throw ConnectionException(QStringLiteral("Database connection is not available"));
+    }
+    
+    QElapsedTimer timer;
+    timer.start();
+    
+    // flushCache的查询先清除相关缓存
+    if (options.flushCache && m_cacheManager) {
+        invalidateCacheForStatement(statementId, sql, compiled);
+    }
+    
+    // 只有useCache的语句才生成缓存键并访问CacheManager
+    const bool useCache = readsResultCache(statementId, options);
+    if (useCache) {
+        QString cacheKey = generateCacheKey(statementId, parameters);
+        QVariant cachedResult = m_cacheManager->get(cacheKey);
+        if (!cachedResult.isNull()) {
+            if (m_debugMode) {
+                logSqlExecutionFlow("selectList (Cache hit)", sql, parameters, sql,
+                                   timer.elapsed(), cachedResult);
+            }
+            return cachedResult.toList();
+        }
+    }
+    
+    QueryDeadline deadline(this, options);
+    
+    try {
+        // 使用优化的方法获取处理后的SQL
+        QString processedSql = getProcessedSql(sql, parameters, compiled);
+        
+        // 准备查询
+        QSqlQuery query = prepareStatement(processedSql, parameters, options);
+        
+        // 使用对象池或回退策略绑定参数
+        bindParameters(query, processedSql, parameters, compiled);
+        
+        // 执行查询
+        if (!execStatement(query, processedSql, parameters, InterceptPhase::Query)) {
+            throw SqlExecutionException(
+                QStringLiteral("Failed to execute query: %1. SQL: %2")
+                .arg(query.lastError().text())
+                .arg(processedSql)
+            );
+        }
+        
+        // 处理结果
+        QVariantList result = m_resultHandler->handleListResult(query, options.maxRows);
+        m_statementHandler->release(processedSql, query);
+        
+        // 记录调试日志 - 使用完整的SQL执行流程跟踪
+        if (m_debugMode) {
+            logSqlExecutionFlow("selectList", sql, parameters, processedSql, 
+                               timer.elapsed(), QVariant::fromValue(result));
+        }
+        
+        // 如果启用缓存，将结果存入缓存
+        if (useCache && !result.isEmpty()) {
+            QString cacheKey = generateCacheKey(statementId, parameters);
+            m_cacheManager->put(cacheKey, QVariant::fromValue(result));
+            // 记录缓存存储调试信息
+            if (m_debugMode) {
+                qDebug() << QString("[Cache] Cache stored - StatementId: %1, CacheKey: %2, Records: %3")
+                            .arg(statementId, cacheKey).arg(result.size());
+            }
+        }
+        
+        return result;
+        
+    } catch (const QtMyBatisException&) {
+        deadline.throwIfInterrupted();
+        throw; // 重新抛出已知异常
+    } catch (const std::exception& e) {
+        throw SqlExecutionException(
+            QStringLiteral("Unexpected error during query execution: %1").arg(QString::fromLatin1(e.what()))
+        );
+    }
+}
+
+ResultSet Executor::queryResultSet(const QString& sql, const QVariantMap& parameters,
+                                   const StatementOptions& options)
+{
+    return queryResultSetInternal(sql, parameters, options, nullptr);
+}
+
+ResultSet Executor::queryResultSetInternal(const QString& sql, const QVariantMap& parameters,
+                                           const StatementOptions& options, const CompiledStatement* compiled)
+{
+    if (!m_connection || !m_connection->isOpen()) {
+        throw ConnectionException(QStringLiteral("Database connection is not available"));
+    }
+    
+    QElapsedTimer timer;
+    timer.start();
+    
+    QueryDeadline deadline(this, options);
+    
+    try {
+        QString processedSql = getProcessedSql(sql, parameters, compiled);
+        
+        QSqlQuery query = prepareStatement(processedSql, parameters, options);
+        
+        bindParameters(query, processedSql, parameters, compiled);
+        
+        if (!execStatement(query, processedSql, parameters, InterceptPhase::Query)) {
+            throw SqlExecutionException(
+                QStringLiteral("Failed to execute query: %1. SQL: %2")
+                .arg(query.lastError().text())
+                .arg(processedSql)
+            );
+        }
+        
+        ResultSet result = m_resultHandler->handleResultSet(query, options.maxRows);
+        m_statementHandler->release(processedSql, query);
+        
+        if (m_debugMode) {
+            logSqlExecutionFlow("selectResultSet", sql, parameters, processedSql,
+                               timer.elapsed(), QVariant(result.rowCount()));
+        }
+        
+        return result;
+        
+    } catch (const QtMyBatisException&) {
+        deadline.throwIfInterrupted();
+        throw; // 重新抛出已知异常
+    } catch (const std::exception& e) {
+        throw SqlExecutionException(
+            QStringLiteral("Unexpected error during query execution: %1").arg(QString::fromLatin1(e.what()))
+        );
+    }
+}
+
+int Executor::queryObjects(const QString& sql, const QVariantMap& parameters, const QMetaObject* metaObject,
+                           const std::function<void*()>& nextObject, int maxRows,
+                           const StatementOptions& options)
+{
+    if (!m_connection || !m_connection->isOpen()) {
+        throw ConnectionException(QStringLiteral("Database connection is not available"));
+    }
+    
+    QElapsedTimer timer;
+    timer.start();
+    
+    QueryDeadline deadline(this, options);
+    
+    try {
+        QString processedSql = getProcessedSql(sql, parameters);
+        
+        QSqlQuery query = prepareStatement(processedSql, parameters, options, true);
+        
+        bindParameters(query, processedSql, parameters);
+        
+        if (!execStatement(query, processedSql, parameters, InterceptPhase::Query)) {
+            throw SqlExecutionException(
+                QStringLiteral("Failed to execute query: %1. SQL: %2")
+                .arg(query.lastError().text())
+                .arg(processedSql)
+            );
+        }
+        
+        // 语句的maxRows与调用方的上限取较小者
+        if (options.maxRows > 0 && (maxRows < 0 || options.maxRows < maxRows)) {
+            maxRows = options.maxRows;
+        }
+        
+        // 列与属性的对应关系按语句缓存，每行直接写入目标对象
+        QSharedPointer<const PropertyPlan> plan = PropertyPlan::forQuery(metaObject, processedSql, query);
+        
+        int rowCount = 0;
+        try {
+            while ((maxRows < 0 || rowCount < maxRows) && query.next()) {
+                plan->apply(query, nextObject());
+                ++rowCount;
+            }
+        } catch (...) {
+            query.finish();
+            throw;
+        }
+        
+        if (query.lastError().isValid()) {
+            throw SqlExecutionException(
+                QStringLiteral("Query error during result processing: %1")
+                .arg(query.lastError().text())
+            );
+        }
+        m_statementHandler->release(processedSql, query);
+        
+        if (m_debugMode) {
+            logSqlExecutionFlow(QStringLiteral("selectTyped<%1>").arg(QString::fromLatin1(metaObject->className())),
+                               sql, parameters, processedSql, timer.elapsed(), QVariant(rowCount));
+        }
+        
+        return rowCount;
+        
+    } catch (const QtMyBatisException&) {
+        deadline.throwIfInterrupted();
+        throw; // 重新抛出已知异常
+    } catch (const std::exception& e) {
+        throw SqlExecutionException(
+            QStringLiteral("Unexpected error during query execution: %1").arg(QString::fromLatin1(e.what()))
+        );
+    }
 }
 
-int Executor::update(const QString& sql, const QVariantMap& parameters)
+QString Executor::pageSql(const QString& sql, QSqlDriver::DbmsType dbms)
 {
-    return updateInternal(sql, parameters, QString(), true);
+    return buildPagingSql(sql, dbms).pageSql;
 }
 
-QVariant Executor::queryWithCache(const QString& statementId, const QString& sql, 
-                                 const QVariantMap& parameters)
+PageResult Executor::queryPage(const QString& statementId, const QString& sql, const QVariantMap& parameters,
+                               int page, int pageSize, const StatementOptions& options)
 {
-    if (!m_cacheManager) {
-        // 如果没有缓存管理器，直接执行查询
-        return query(sql, parameters);
+    if (!m_connection || !m_connection->isOpen()) {
+        throw ConnectionException(QStringLiteral("Database connection is not available"));
     }
     
-    // 生成缓存键
-    QString cacheKey = generateCacheKey(statementId, parameters);
+    PageResult result;
+    result.page = page;
+    result.pageSize = pageSize;
     
-    // 尝试从缓存获取结果
-    QVariant cachedResult = m_cacheManager->get(cacheKey);
-    if (!cachedResult.isNull()) {
-        // 记录缓存命中调试信息
-        if (m_debugMode) {
-            qDebug() << QString("[Cache] Cache hit - StatementId: %1, CacheKey: %2")
-                        .arg(statementId, cacheKey);
-        }
-        return cachedResult;
-    }
+    const PagingSql paging = buildPagingSql(sql, m_connection->driver()->dbmsType());
     
-    // 记录缓存未命中调试信息
-    if (m_debugMode) {
-        qDebug() << QString("[Cache] Cache miss - StatementId: %1, CacheKey: %2")
-                    .arg(statementId, cacheKey);
+    // flushCache在计数之前处理一次，计数和分页查询不再重复失效
+    StatementOptions pageOptions = options;
+    if (pageOptions.flushCache && m_cacheManager) {
+        invalidateCacheForStatement(statementId, sql);
     }
+    pageOptions.flushCache = false;
     
-    // 缓存中没有，执行查询
-    QVariant result = query(sql, parameters);
+    // 计数缓存键包含相关表的版本号，任一表被写入后自动失效
+    QString countKey;
+    if (readsResultCache(statementId, options)) {
+        const QStringList tableNames = extractTableNamesFromSql(sql);
+        if (!tableNames.isEmpty()) {
+            countKey = QLatin1String("count_") + generateCacheKey(statementId, parameters);
+            for (const QString& tableName : tableNames) {
+                countKey += QStringLiteral("_%1:%2").arg(tableName).arg(m_cacheManager->tableVersion(tableName));
+            }
+        }
+    }
     
-    // 将结果存入缓存
-    if (!result.isNull()) {
-        m_cacheManager->put(cacheKey, result);
-        // 记录缓存存储调试信息
+    const QVariant cachedTotal = countKey.isEmpty() ? QVariant() : m_cacheManager->get(countKey);
+    if (!cachedTotal.isNull()) {
+        result.total = cachedTotal.toLongLong();
         if (m_debugMode) {
-            qDebug() << QString("[Cache] Cache stored - StatementId: %1, CacheKey: %2")
-                        .arg(statementId, cacheKey);
+            qDebug() << QString("[Cache] Page count hit - StatementId: %1, Total: %2")
+                        .arg(statementId).arg(result.total);
+        }
+    } else {
+        StatementOptions countOptions = pageOptions;
+        countOptions.maxRows = 0;
+        result.total = queryValue(paging.countSql, parameters, countOptions).toLongLong();
+        if (!countKey.isEmpty()) {
+            m_cacheManager->put(countKey, result.total);
         }
     }
     
+    // 超出末页时不再查询
+    const qint64 offset = qint64(page - 1) * pageSize;
+    if (offset >= result.total) {
+        return result;
+    }
+    
+    QVariantMap pageParameters = parameters;
+    pageParameters.insert(QStringLiteral("_pageLimit"), pageSize);
+    pageParameters.insert(QStringLiteral("_pageOffset"), offset);
+    result.items = queryListInternal(paging.pageSql, pageParameters, statementId, pageOptions);
     return result;
 }
 
-QVariantList Executor::queryListWithCache(const QString& statementId, const QString& sql, 
-                                         const QVariantMap& parameters)
+QVariantList Executor::queryKeysetPage(const QString& statementId, const QString& sql,
+                                       const QVariantMap& parameters, const QStringList& keyColumns,
+                                       const QVariantList& lastKey, int pageSize, const StatementOptions& options)
 {
-    if (!m_cacheManager) {
-        // 如果没有缓存管理器，直接执行查询
-        return queryList(sql, parameters);
+    if (!m_connection || !m_connection->isOpen()) {
+        throw ConnectionException(QStringLiteral("Database connection is not available"));
     }
     
-    // 生成缓存键
-    QString cacheKey = generateCacheKey(statementId, parameters);
-    
-    // 尝试从缓存获取结果
-    QVariant cachedResult = m_cacheManager->get(cacheKey);
-    if (!cachedResult.isNull()) {
-        // 记录缓存命中调试信息
-        if (m_debugMode) {
-            qDebug() << QString("[Cache] Cache hit - StatementId: %1, CacheKey: %2")
-                        .arg(statementId, cacheKey);
-        }
-        return cachedResult.toList();
+    if (keyColumns.isEmpty() || pageSize < 1) {
+        throw SqlExecutionException(QStringLiteral("Keyset pagination requires key columns and a positive page size"));
     }
-    
-    // 记录缓存未命中调试信息
-    if (m_debugMode) {
-        qDebug() << QString("[Cache] Cache miss - StatementId: %1, CacheKey: %2")
-                    .arg(statementId, cacheKey);
+    if (!lastKey.isEmpty() && lastKey.size() != keyColumns.size()) {
+        throw SqlExecutionException(
+            QStringLiteral("Keyset pagination expects %1 key values, got %2").arg(keyColumns.size()).arg(lastKey.size())
+        );
     }
     
-    // 缓存中没有，执行查询
-    QVariantList result = queryList(sql, parameters);
+    const QString keysetSql = buildKeysetSql(sql, keyColumns, !lastKey.isEmpty(), m_connection->driver()->dbmsType());
     
-    // 将结果存入缓存
-    if (!result.isEmpty()) {
-        m_cacheManager->put(cacheKey, QVariant::fromValue(result));
-        // 记录缓存存储调试信息
-        if (m_debugMode) {
-            qDebug() << QString("[Cache] Cache stored - StatementId: %1, CacheKey: %2, Records: %3")
-                        .arg(statementId, cacheKey).arg(result.size());
-        }
+    QVariantMap pageParameters = parameters;
+    pageParameters.insert(QStringLiteral("_pageLimit"), pageSize);
+    for (int i = 0; i < lastKey.size(); ++i) {
+        pageParameters.insert(QStringLiteral("_keyset%1").arg(i), lastKey.at(i));
     }
     
-    return result;
-}
-
-int Executor::updateWithCacheInvalidation(const QString& statementId, const QString& sql, 
-                                          const QVariantMap& parameters)
-{
-    return updateInternal(sql, parameters, statementId, true);
-}
-
-void Executor::clearCache(const QString& pattern)
-{
-    if (m_cacheManager) {
-        if (pattern.isEmpty()) {
-            m_cacheManager->clear();
-            // 记录缓存清空调试信息
-            if (m_debugMode) {
-                qDebug() << "[Cache] Clear all cache";
-            }
-        } else {
-            m_cacheManager->invalidateByPattern(pattern);
-            // 记录缓存模式失效调试信息
-            if (m_debugMode) {
-                qDebug() << QString("[Cache] Invalidate cache by pattern - Pattern: %1").arg(pattern);
-            }
-        }
-    }
+    // 扫描的页面只读一次，不进入结果缓存
+    StatementOptions pageOptions = options;
+    pageOptions.useCache = false;
+    pageOptions.flushCache = false;
+    return queryListInternal(keysetSql, pageParameters, statementId, pageOptions);
 }
 
-QVariant Executor::queryInternal(const QString& sql, const QVariantMap& parameters, 
-                                const QString& statementId, bool useCache)
+QVariant Executor::queryValue(const QString& sql, const QVariantMap& parameters,
+                              const StatementOptions& options)
 {
     if (!m_connection || !m_connection->isOpen()) {
         throw ConnectionException(QStringLiteral("Database connection is not available"));
@@ -173,31 +1920,16 @@ QVariant Executor::queryInternal(const QString& sql, const QVariantMap& paramete
     QElapsedTimer timer;
     timer.start();
     
-    // 如果启用缓存且有缓存管理器，尝试从缓存获取
-    if (useCache && m_cacheManager && !statementId.isEmpty()) {
-        QString cacheKey = generateCacheKey(statementId, parameters);
-        QVariant cachedResult = m_cacheManager->get(cacheKey);
-        if (!cachedResult.isNull()) {
-            if (m_debugMode) {
-                logDebugInfo("selectOne (Cache hit)", statementId.isEmpty() ? sql : statementId,
-                            parameters, timer.elapsed(), cachedResult);
-            }
-            return cachedResult;
-        }
-    }
+    QueryDeadline deadline(this, options);
     
     try {
-        // 使用优化的方法获取处理后的SQL
-        const QString processedSql = getProcessedSql(sql, parameters);
+        QString processedSql = getProcessedSql(sql, parameters);
         
-        // 准备查询
-        QSqlQuery query = m_statementHandler->prepare(processedSql, *m_connection);
+        QSqlQuery query = prepareStatement(processedSql, parameters, options, true);
         
-        // 使用对象池或回退策略绑定参数
-        withParameterHandler(query, parameters);
+        bindParameters(query, processedSql, parameters);
         
-        // 执行查询
-        if (!query.exec()) {
+        if (!execStatement(query, processedSql, parameters, InterceptPhase::Query)) {
             throw SqlExecutionException(
                 QStringLiteral("Failed to execute query: %1. SQL: %2")
                 .arg(query.lastError().text())
@@ -205,29 +1937,18 @@ QVariant Executor::queryInternal(const QString& sql, const QVariantMap& paramete
             );
         }
         
-        // 处理结果
-        QVariant result = m_resultHandler->handleSingleResult(query);
+        // 标量查询（COUNT、MAX等）只读取第一行第一列
+        QVariant result = query.next() ? query.value(0) : QVariant();
+        m_statementHandler->release(processedSql, query);
         
-        // 记录调试日志 - 使用完整的SQL执行流程跟踪
         if (m_debugMode) {
-            logSqlExecutionFlow("selectOne", sql, parameters, query.lastQuery(), 
-                               timer.elapsed(), result);
-        }   
-        
-        // 如果启用缓存，将结果存入缓存
-        if (useCache && m_cacheManager && !statementId.isEmpty() && !result.isNull()) {
-            QString cacheKey = generateCacheKey(statementId, parameters);
-            m_cacheManager->put(cacheKey, result);
-            // 记录缓存存储调试信息
-            if (m_debugMode) {
-                qDebug() << QString("[Cache] Cache stored - StatementId: %1, CacheKey: %2")
-                            .arg(statementId, cacheKey);
-            }
+            logSqlExecutionFlow("selectValue", sql, parameters, processedSql, timer.elapsed(), result);
         }
         
         return result;
         
     } catch (const QtMyBatisException&) {
+        deadline.throwIfInterrupted();
         throw; // 重新抛出已知异常
     } catch (const std::exception& e) {
         throw SqlExecutionException(
@@ -236,41 +1957,31 @@ QVariant Executor::queryInternal(const QString& sql, const QVariantMap& paramete
     }
 }
 
-QVariantList Executor::queryListInternal(const QString& sql, const QVariantMap& parameters, 
-                                        const QString& statementId, bool useCache)
+int Executor::queryCursor(const QString& sql, const QVariantMap& parameters, const RowCallback& callback,
+                          const StatementOptions& options)
 {
     if (!m_connection || !m_connection->isOpen()) {
         throw ConnectionException(QStringLiteral("Database connection is not available"));
     }
     
+    if (!callback) {
+        throw SqlExecutionException(QStringLiteral("Cursor callback must not be empty"));
+    }
+    
     QElapsedTimer timer;
     timer.start();
     
-    // 如果启用缓存且有缓存管理器，尝试从缓存获取
-    if (useCache && m_cacheManager && !statementId.isEmpty()) {
-        QString cacheKey = generateCacheKey(statementId, parameters);
-        QVariant cachedResult = m_cacheManager->get(cacheKey);
-        if (!cachedResult.isNull()) {
-            if (m_debugMode) {
-                logSqlExecutionFlow("selectList (Cache hit)", sql, parameters, sql,
-                                   timer.elapsed(), QVariant::fromValue(cachedResult.toList()));
-            }
-            return cachedResult.toList();
-        }
-    }
+    QueryDeadline deadline(this, options);
     
     try {
-        // 使用优化的方法获取处理后的SQL
-        const QString processedSql = getProcessedSql(sql, parameters);
+        QString processedSql = getProcessedSql(sql, parameters);
         
-        // 准备查询
-        QSqlQuery query = m_statementHandler->prepare(processedSql, *m_connection);
+        // 只进游标：驱动不缓存已读取的行，内存占用保持恒定
+        QSqlQuery query = prepareStatement(processedSql, parameters, options, true);
         
-        // 使用对象池或回退策略绑定参数
-        withParameterHandler(query, parameters);
+        bindParameters(query, processedSql, parameters);
         
-        // 执行查询
-        if (!query.exec()) {
+        if (!execStatement(query, processedSql, parameters, InterceptPhase::Query)) {
             throw SqlExecutionException(
                 QStringLiteral("Failed to execute query: %1. SQL: %2")
                 .arg(query.lastError().text())
@@ -278,39 +1989,36 @@ QVariantList Executor::queryListInternal(const QString& sql, const QVariantMap&
             );
         }
         
-        // 处理结果
-        QVariantList result = m_resultHandler->handleListResult(query);
-        
-        // 记录调试日志 - 使用完整的SQL执行流程跟踪
-        if (m_debugMode) {
-            logSqlExecutionFlow("selectList", sql, parameters, query.lastQuery(), 
-                               timer.elapsed(), QVariant::fromValue(result));
+        int rowCount = 0;
+        try {
+            rowCount = m_resultHandler->handleCursorResult(query, callback, options.maxRows);
+        } catch (...) {
+            // 回调抛出异常时同样释放驱动端游标
+            query.finish();
+            throw;
         }
+        m_statementHandler->release(processedSql, query);
         
-        // 如果启用缓存，将结果存入缓存
-        if (useCache && m_cacheManager && !statementId.isEmpty() && !result.isEmpty()) {
-            QString cacheKey = generateCacheKey(statementId, parameters);
-            m_cacheManager->put(cacheKey, QVariant::fromValue(result));
-            // 记录缓存存储调试信息
-            if (m_debugMode) {
-                qDebug() << QString("[Cache] Cache stored - StatementId: %1, CacheKey: %2, Records: %3")
-                            .arg(statementId, cacheKey).arg(result.size());
-            }
+        if (m_debugMode) {
+            logSqlExecutionFlow("selectCursor", sql, parameters, processedSql,
+                               timer.elapsed(), QVariant(rowCount));
         }
         
-        return result;
+        return rowCount;
         
     } catch (const QtMyBatisException&) {
+        deadline.throwIfInterrupted();
         throw; // 重新抛出已知异常
     } catch (const std::exception& e) {
         throw SqlExecutionException(
-            QStringLiteral("Unexpected error during query execution: %1").arg(QString::fromLatin1(e.what()))
+            QStringLiteral("Unexpected error during cursor query execution: %1").arg(QString::fromLatin1(e.what()))
         );
     }
 }
 
 int Executor::updateInternal(const QString& sql, const QVariantMap& parameters, 
-                            const QString& statementId, bool invalidateCache)
+                            const QString& statementId, const StatementOptions& options,
+                            QVariantList* generatedKeys, const CompiledStatement* compiled)
 {
     if (!m_connection || !m_connection->isOpen()) {
         throw ConnectionException(QStringLiteral("Database connection is not available"));
@@ -319,18 +2027,20 @@ int Executor::updateInternal(const QString& sql, const QVariantMap& parameters,
     QElapsedTimer timer;
     timer.start();
     
+    QueryDeadline deadline(this, options);
+    
     try {
         // 使用优化的方法获取处理后的SQL
-        const QString processedSql = getProcessedSql(sql, parameters);
+        QString processedSql = getProcessedSql(sql, parameters, compiled);
         
         // 准备查询
-        QSqlQuery query = m_statementHandler->prepare(processedSql, *m_connection);
+        QSqlQuery query = prepareStatement(processedSql, parameters, options);
         
         // 使用对象池或回退策略绑定参数
-        withParameterHandler(query, parameters);
+        bindParameters(query, processedSql, parameters, compiled);
         
         // 执行更新操作
-        if (!query.exec()) {
+        if (!execStatement(query, processedSql, parameters, InterceptPhase::Update)) {
             throw SqlExecutionException(
                 QStringLiteral("Failed to execute update: %1. SQL: %2")
                 .arg(query.lastError().text())
@@ -340,6 +2050,21 @@ int Executor::updateInternal(const QString& sql, const QVariantMap& parameters,
         
         int affectedRows = query.numRowsAffected();
         
+        // 生成键在执行后由驱动直接报告（或随RETURNING返回），无需额外查询
+        if (generatedKeys) {
+            if (query.isSelect()) {
+                while (query.next()) {
+                    generatedKeys->append(query.value(0));
+                }
+            } else {
+                const QVariant key = query.lastInsertId();
+                if (key.isValid()) {
+                    generatedKeys->append(key);
+                }
+            }
+        }
+        m_statementHandler->release(processedSql, query);
+        
         // 记录调试日志 - 使用完整的SQL执行流程跟踪
         if (m_debugMode) {
             QString operation = "update";
@@ -348,18 +2073,19 @@ int Executor::updateInternal(const QString& sql, const QVariantMap& parameters,
             } else if (sql.toUpper().contains("DELETE")) {
                 operation = "delete";
             }
-            logSqlExecutionFlow(operation, sql, parameters, query.lastQuery(), 
+            logSqlExecutionFlow(operation, sql, parameters, processedSql, 
                                timer.elapsed(), QVariant(affectedRows));
         }
         
-        // 如果启用缓存失效且有受影响的行，清除相关缓存
-        if (invalidateCache && m_cacheManager && affectedRows > 0) {
-            invalidateCacheForStatement(statementId, sql);
+        // flushCache的语句在有受影响的行时清除相关缓存
+        if (options.flushCache && m_cacheManager && affectedRows > 0) {
+            invalidateCacheForStatement(statementId, sql, compiled);
         }
         
         return affectedRows;
         
     } catch (const QtMyBatisException&) {
+        deadline.throwIfInterrupted();
         throw; // 重新抛出已知异常
     } catch (const std::exception& e) {
         throw SqlExecutionException(
@@ -368,14 +2094,89 @@ int Executor::updateInternal(const QString& sql, const QVariantMap& parameters,
     }
 }
 
-void Executor::invalidateCacheForStatement(const QString& statementId, const QString& sql)
+QSqlQuery Executor::prepareStatement(QString& processedSql, const QVariantMap& parameters,
+                                     const StatementOptions& options, bool forwardOnly)
+{
+    // 拦截器链为空时，每个阶段只有这一次指针判断
+    if (!m_interceptors) {
+        return prepareQuery(processedSql, options, forwardOnly);
+    }
+    
+    QSqlQuery query;
+    Invocation invocation(*m_interceptors, InterceptPhase::Prepare, processedSql, parameters, &query,
+                          [this, &query, &processedSql, &options, forwardOnly]() {
+                              query = prepareQuery(processedSql, options, forwardOnly);
+                              return true;
+                          });
+    invocation.proceed();
+    return query;
+}
+
+void Executor::bindParameters(QSqlQuery& query, QString& processedSql, const QVariantMap& parameters,
+                              const CompiledStatement* compiled)
+{
+    // 预解析的静态语句直接使用其绑定计划；SQL被执行提示或拦截器改写后按文本查找
+    const auto bind = [this, &query, &processedSql, compiled](const QVariantMap& values) {
+        if (compiled && compiled->bindingPlan && processedSql == compiled->processedSql) {
+            m_parameterHandler->setParameters(query, *compiled->bindingPlan, values);
+        } else {
+            withParameterHandler(query, values);
+        }
+    };
+    
+    if (!m_interceptors) {
+        bind(parameters);
+        return;
+    }
+    
+    // 拦截器修改的是参数副本，绑定时使用修改后的值
+    Invocation* current = nullptr;
+    Invocation invocation(*m_interceptors, InterceptPhase::Parameterize, processedSql, parameters, &query,
+                          [&bind, &current]() {
+                              bind(current->parameters());
+                              return true;
+                          });
+    current = &invocation;
+    invocation.proceed();
+}
+
+bool Executor::execStatement(QSqlQuery& query, QString& processedSql, const QVariantMap& parameters,
+                             InterceptPhase phase)
+{
+    if (!m_interceptors) {
+        return query.exec();
+    }
+    
+    Invocation invocation(*m_interceptors, phase, processedSql, parameters, &query,
+                          [&query]() { return query.exec(); });
+    return invocation.proceed();
+}
+
+QSqlQuery Executor::prepareQuery(QString& processedSql, const StatementOptions& options, bool forwardOnly)
+{
+    // MySQL 5.7.8+：以优化器提示限制SELECT的执行时间，超时由服务器中止语句
+    if (options.timeout > 0 && m_connection->driver()->dbmsType() == QSqlDriver::MySqlServer) {
+        const int insertPos = selectKeywordEnd(processedSql);
+        if (insertPos > 0) {
+            processedSql.insert(insertPos, QStringLiteral(" /*+ MAX_EXECUTION_TIME(%1) */")
+                                .arg(qint64(options.timeout) * 1000));
+        }
+    }
+    
+    // fetchSize/maxRows：只进读取，驱动不保留已读取的行
+    const bool streamed = forwardOnly || options.fetchSize > 0 || options.maxRows > 0;
+    return m_statementHandler->prepare(processedSql, *m_connection, streamed);
+}
+
+void Executor::invalidateCacheForStatement(const QString& statementId, const QString& sql,
+                                           const CompiledStatement* compiled)
 {
     if (!m_cacheManager) {
         return;
     }
     
-    // 从SQL语句中提取表名，用于缓存失效
-    QStringList tableNames = extractTableNamesFromSql(sql);
+    // 从SQL语句中提取表名，用于缓存失效；预解析的语句已在编译时提取
+    const QStringList tableNames = compiled ? compiled->tables : extractTableNamesFromSql(sql);
     
     // 记录缓存失效开始调试信息
     if (m_debugMode) {
@@ -384,9 +2185,14 @@ void Executor::invalidateCacheForStatement(const QString& statementId, const QSt
     }
     
     // 为每个表名创建失效模式
-    for (const QString& tableName : tableNames) {
+    for (qsizetype i = 0; i < tableNames.size(); ++i) {
+        const QString& tableName = tableNames.at(i);
+        // 表版本号递增，依赖该表的计数缓存随之失效
+        m_cacheManager->bumpTableVersion(tableName);
+        
         // 失效所有与该表相关的缓存条目
-        QString pattern = QStringLiteral(".*%1.*").arg(tableName);
+        const QString pattern = compiled ? compiled->tablePatterns.at(i)
+                                         : QString(QStringLiteral(".*%1.*").arg(tableName));
         m_cacheManager->invalidateByPattern(pattern);
         
         // 记录表级缓存失效调试信息
@@ -398,7 +2204,14 @@ void Executor::invalidateCacheForStatement(const QString& statementId, const QSt
     
     // 如果有具体的语句ID，也失效相关的缓存
     if (!statementId.isEmpty()) {
-        QString statementPattern = QStringLiteral("cache_%1_.*").arg(statementId.split(QLatin1Char('.')).first());
+        // 缓存键形如 cache_<namespace>.<id>_<hash>，按命名空间整体失效
+        QString statementPattern;
+        if (compiled) {
+            statementPattern = compiled->namespacePattern;
+        } else {
+            const QString mapperNamespace = statementId.section(QLatin1Char('.'), 0, 0);
+            statementPattern = QStringLiteral("^cache_%1\\.").arg(QRegularExpression::escape(mapperNamespace));
+        }
         m_cacheManager->invalidateByPattern(statementPattern);
         
         // 记录语句级缓存失效调试信息
@@ -549,6 +2362,12 @@ QStringList Executor::extractTableNamesFromSql(const QString& sql)
     return tableNames;
 }
 
+bool Executor::readsResultCache(const QString& statementId, const StatementOptions& options) const
+{
+    // 缓存键只含语句id和参数，拦截器改写的SQL（如按租户过滤）不在键中，有拦截器时不读写结果缓存
+    return options.useCache && m_cacheManager && !statementId.isEmpty() && !m_interceptors;
+}
+
 QString Executor::generateCacheKey(const QString& statementId, const QVariantMap& parameters)
 {
     // 使用更高效的字符串拼接方法
@@ -603,33 +2422,17 @@ QString Executor::generateCacheKey(const QString& statementId, const QVariantMap
     return QStringLiteral("cache_%1_%2").arg(statementId).arg(hash, 8, 16, QLatin1Char('0'));
 }
 
-QString Executor::getProcessedSql(const QString& sql, const QVariantMap& parameters)
+QString Executor::getProcessedSql(const QString& sql, const QVariantMap& parameters,
+                                  const CompiledStatement* compiled)
 {
-    // 对于无参数查询或简单查询，使用缓存
-    if (parameters.isEmpty() || (!sql.contains(QStringLiteral("${")) && !sql.contains(QStringLiteral("#}")))) {
-        QMutexLocker locker(&m_sqlCacheMutex);
-        if (m_processedSqlCache.contains(sql)) {
-            return m_processedSqlCache[sql];
-        }
-        
-        // 处理SQL并缓存
-        QString processedSql = m_statementHandler->processSql(sql, parameters);
-        
-        // 限制缓存大小，防止无限增长
-        if (m_processedSqlCache.size() >= 1000) {
-            // 如果缓存太大，清除一半
-            QList<QString> keys = m_processedSqlCache.keys();
-            for (int i = 0; i < keys.size() / 2; ++i) {
-                m_processedSqlCache.remove(keys[i]);
-            }
-        }
-        
-        m_processedSqlCache[sql] = processedSql;
-        return processedSql;
+    // 预解析的静态语句在编译时已渲染
+    if (compiled && !compiled->dynamic) {
+        return compiled->processedSql;
     }
     
-    // 对于带参数的动态SQL，不缓存直接处理
-    return m_statementHandler->processSql(sql, parameters);
+    // 按形状签名跨Session共享：同一语句只要分支与集合长度相同就复用已生成的SQL，
+    // 相同的SQL文本也会命中连接上的预编译语句缓存
+    return DynamicSqlProcessor::processCached(sql, parameters);
 }
 
 void Executor::withParameterHandler(QSqlQuery &query, const QVariantMap &parameters)
@@ -646,6 +2449,29 @@ void Executor::withParameterHandler(QSqlQuery &query, const QVariantMap &paramet
     }
 }
 
+void Executor::withBatchParameterHandler(QSqlQuery &query, const QList<QVariantMap> &parametersList)
+{
+    ParameterHandler* paramHandler = g_parameterHandlerPool.acquire();
+    if (paramHandler) {
+        paramHandler->setBatchParameters(query, parametersList);
+        g_parameterHandlerPool.release(paramHandler);
+    } else {
+        m_parameterHandler->setBatchParameters(query, parametersList);
+    }
+}
+
+void Executor::withMultiRowParameterHandler(QSqlQuery &query, const BindingPlan &rowPlan,
+                                            const QList<QVariantMap> &parametersList)
+{
+    ParameterHandler* paramHandler = g_parameterHandlerPool.acquire();
+    if (paramHandler) {
+        paramHandler->setMultiRowParameters(query, rowPlan, parametersList);
+        g_parameterHandlerPool.release(paramHandler);
+    } else {
+        m_parameterHandler->setMultiRowParameters(query, rowPlan, parametersList);
+    }
+}
+
 void Executor::setDebugMode(bool enabled)
 {
     m_debugMode = enabled;
@@ -656,6 +2482,32 @@ bool Executor::isDebugMode() const
     return m_debugMode;
 }
 
+void Executor::setPreparedStatementCache(QSharedPointer<PreparedStatementCache> cache)
+{
+    m_statementHandler->setPreparedStatementCache(cache);
+}
+
+PreparedStatementStats Executor::getPreparedStatementStats() const
+{
+    QSharedPointer<PreparedStatementCache> cache = m_statementHandler->preparedStatementCache();
+    return cache ? cache->getStats() : PreparedStatementStats();
+}
+
+void Executor::setInterceptors(const InterceptorChain& interceptors)
+{
+    // 拦截器链不可变，空链保持为空指针
+    if (interceptors.isEmpty()) {
+        m_interceptors.reset();
+    } else {
+        m_interceptors = QSharedPointer<const InterceptorChain>::create(interceptors);
+    }
+}
+
+bool Executor::hasInterceptors() const
+{
+    return !m_interceptors.isNull();
+}
+
 void Executor::logDebugInfo(const QString& operation, const QString& sql, 
                            const QVariantMap& parameters, qint64 elapsedMs, 
                            const QVariant& result) const
@@ -0,0 +1,47 @@
+#include "QtMyBatisORM/interceptor.h"
+
+#include <utility>
+
+namespace QtMyBatisORM {
+
+Invocation::Invocation(const InterceptorChain& chain, InterceptPhase phase, QString& sql,
+                       const QVariantMap& parameters, QSqlQuery* query, std::function<bool()> target)
+    : m_chain(chain)
+    , m_phase(phase)
+    , m_sql(sql)
+    , m_parameters(parameters)
+    , m_query(query)
+    , m_target(std::move(target))
+{
+}
+
+InterceptPhase Invocation::phase() const
+{
+    return m_phase;
+}
+
+QString& Invocation::sql()
+{
+    return m_sql;
+}
+
+QVariantMap& Invocation::parameters()
+{
+    return m_parameters;
+}
+
+QSqlQuery* Invocation::query() const
+{
+    return m_query;
+}
+
+bool Invocation::proceed()
+{
+    // 依次进入下一个拦截器，链尾执行阶段本身
+    if (m_index < m_chain.size()) {
+        return m_chain.at(m_index++)->intercept(*this);
+    }
+    return m_target();
+}
+
+} // namespace QtMyBatisORM
@@ -0,0 +1,126 @@
+#include "QtMyBatisORM/keysetiterator.h"
+#include "QtMyBatisORM/asyncexecutor.h"
+#include "QtMyBatisORM/session.h"
+#include "QtMyBatisORM/qtmybatisexception.h"
+
+#include <utility>
+
+namespace QtMyBatisORM {
+
+KeysetIterator::KeysetIterator(QSharedPointer<AsyncExecutor> executor, const QString& statementId,
+                               const QStringList& keyColumns, const QVariantMap& parameters, int pageSize)
+    : m_executor(std::move(executor))
+    , m_statementId(statementId)
+    , m_keyColumns(keyColumns)
+    , m_parameters(parameters)
+    , m_pageSize(pageSize)
+{
+    if (!m_executor) {
+        throw ConfigurationException(QStringLiteral("KeysetIterator requires an AsyncExecutor"));
+    }
+    if (m_keyColumns.isEmpty() || m_pageSize < 1) {
+        throw ConfigurationException(
+            QStringLiteral("KeysetIterator for %1 requires key columns and a positive page size").arg(statementId)
+        );
+    }
+
+    // 构造时即开始读取第一页
+    requestPage({});
+}
+
+KeysetIterator::~KeysetIterator()
+{
+    // 预读任务只持有参数副本，放弃结果即可，无需等待
+}
+
+bool KeysetIterator::hasNext()
+{
+    takePage();
+    return !m_current.isEmpty();
+}
+
+QVariantList KeysetIterator::next()
+{
+    takePage();
+    m_hasCurrent = false;
+    return std::exchange(m_current, {});
+}
+
+int KeysetIterator::pageSize() const
+{
+    return m_pageSize;
+}
+
+int KeysetIterator::pagesRequested() const
+{
+    return m_pagesRequested;
+}
+
+void KeysetIterator::requestPage(const QVariantList& lastKey)
+{
+    ++m_pagesRequested;
+    m_prefetching = true;
+    m_pendingFailed = false;
+    m_pendingKey = lastKey;
+    m_pending = m_executor->submit<QVariantList>(
+        [statementId = m_statementId, keyColumns = m_keyColumns, parameters = m_parameters,
+         pageSize = m_pageSize, lastKey](Session& session) {
+            return session.selectKeysetPage(statementId, keyColumns, lastKey, parameters, pageSize);
+        });
+}
+
+void KeysetIterator::takePage()
+{
+    if (m_hasCurrent) {
+        return;
+    }
+
+    if (!m_prefetching) {
+        // 上一页不满，扫描结束
+        m_current.clear();
+        m_hasCurrent = true;
+        return;
+    }
+
+    if (m_pendingFailed) {
+        // 上次读取失败：从同一个键重新读取这一页，失败不能当作扫描结束
+        requestPage(m_pendingKey);
+    }
+
+    QVariantList page;
+    try {
+        // result()在任务失败时重新抛出其异常
+        page = m_pending.result();
+    } catch (...) {
+        m_pendingFailed = true;
+        throw;
+    }
+
+    // 满页时立即预读下一页，与调用方处理当前页并行
+    QVariantList lastKey;
+    const bool full = page.size() == m_pageSize;
+    if (full) {
+        const QVariantMap lastRow = page.last().toMap();
+        lastKey.reserve(m_keyColumns.size());
+        for (const QString& column : m_keyColumns) {
+            auto it = lastRow.constFind(column);
+            if (it == lastRow.constEnd()) {
+                m_pendingFailed = true;
+                throw SessionException(
+                    QStringLiteral("Key column %1 is not in the result of %2").arg(column, m_statementId),
+                    "SESSION_SELECT_KEYSET_ERROR"
+                );
+            }
+            lastKey.append(it.value());
+        }
+    }
+
+    m_prefetching = false;
+    m_current = std::move(page);
+    m_hasCurrent = true;
+    if (full) {
+        requestPage(lastKey);
+    }
+}
+
+} // namespace QtMyBatisORM
@@ -5,9 +5,148 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QVarLengthArray>
+#include <algorithm>
 
 namespace QtMyBatisORM {
 
+namespace {
+
+// 与QSqlResult解析命名占位符时使用的字符集保持一致
+bool isPlaceholderChar(QChar ch)
+{
+    const ushort u = ch.unicode();
+    return (u >= 'a' && u <= 'z') || (u >= 'A' && u <= 'Z') || (u >= '0' && u <= '9') || u == '_';
+}
+
+// 按名称取参数值；<foreach>生成的"集合名_下标"占位符取集合中的元素，
+// 超出集合长度的下标是按桶补齐的部分，取最后一个元素
+bool lookupParameter(const QVariantMap& parameters, const QString& name, QVariant& value)
+{
+    auto it = parameters.constFind(name);
+    if (it != parameters.constEnd()) {
+        value = it.value();
+        return true;
+    }
+    
+    const int separator = name.lastIndexOf(QLatin1Char('_'));
+    if (separator <= 0 || separator == name.size() - 1) {
+        return false;
+    }
+    
+    bool ok = false;
+    const qsizetype index = QStringView(name).mid(separator + 1).toLongLong(&ok);
+    if (!ok || index < 0) {
+        return false;
+    }
+    
+    const QString collection = name.left(separator);
+    auto list = parameters.constFind(collection);
+    if (list == parameters.constEnd()) {
+        // 集合名含有占位符不允许的字符（如 row.tags）时，占位符前缀中这些字符被替换为下划线，
+        // 规则与ForEachSqlNode一致
+        for (list = parameters.constBegin(); list != parameters.constEnd(); ++list) {
+            const QString& key = list.key();
+            if (key.size() != collection.size() || std::all_of(key.cbegin(), key.cend(), isPlaceholderChar)) {
+                continue;
+            }
+            bool matches = true;
+            for (qsizetype i = 0; matches && i < key.size(); ++i) {
+                const QChar ch = isPlaceholderChar(key.at(i)) ? key.at(i) : QLatin1Char('_');
+                matches = ch == collection.at(i);
+            }
+            if (matches) {
+                break;
+            }
+        }
+        if (list == parameters.constEnd()) {
+            return false;
+        }
+    }
+    
+    if (list->typeId() == QMetaType::QVariantList) {
+        const QVariantList items = list->toList();
+        if (items.isEmpty()) {
+            return false;
+        }
+        value = items.at(qMin(index, items.size() - 1));
+        return true;
+    }
+    if (list->typeId() == QMetaType::QStringList) {
+        const QStringList items = list->toStringList();
+        if (items.isEmpty()) {
+            return false;
+        }
+        value = items.at(qMin(index, items.size() - 1));
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+BindingPlan BindingPlan::build(const QString& sql)
+{
+    BindingPlan plan;
+    QHash<QString, int> nameIndexes;
+    QChar closingQuote;
+    const int n = sql.size();
+    
+    for (int i = 0; i < n; ++i) {
+        const QChar ch = sql.at(i);
+        
+        // 引号及方括号内的内容不是占位符
+        if (!closingQuote.isNull()) {
+            if (ch == closingQuote) {
+                if (closingQuote == QLatin1Char(']') && i + 1 < n && sql.at(i + 1) == closingQuote) {
+                    ++i;
+                } else {
+                    closingQuote = QChar();
+                }
+            }
+            continue;
+        }
+        
+        if (ch == QLatin1Char(':') && (i == 0 || sql.at(i - 1) != QLatin1Char(':'))
+            && i + 1 < n && isPlaceholderChar(sql.at(i + 1))) {
+            int end = i + 2;
+            while (end < n && isPlaceholderChar(sql.at(end))) {
+                ++end;
+            }
+            
+            const QString name = sql.mid(i + 1, end - i - 1);
+            auto it = nameIndexes.constFind(name);
+            if (it == nameIndexes.constEnd()) {
+                it = nameIndexes.insert(name, plan.names.size());
+                plan.names.append(name);
+                plan.placeholders.append(QStringLiteral(":") + name);
+            } else {
+                plan.hasDuplicateNames = true;
+            }
+            plan.positions.append(it.value());
+            plan.offsets.append(i);
+            i = end - 1;
+        } else if (ch == QLatin1Char('?')) {
+            ++plan.positionalCount;
+        } else if (ch == QLatin1Char('\'') || ch == QLatin1Char('"') || ch == QLatin1Char('`')) {
+            closingQuote = ch;
+        } else if (ch == QLatin1Char('[')) {
+            closingQuote = QLatin1Char(']');
+        }
+    }
+    
+    if (!plan.positions.isEmpty()) {
+        plan.mode = Mode::Named;
+    } else if (plan.positionalCount > 0) {
+        plan.mode = Mode::Positional;
+    }
+    
+    return plan;
+}
+
 ParameterHandler::ParameterHandler(QObject* parent)
     : QObject(parent)
 {
@@ -18,23 +157,34 @@ void ParameterHandler::setParameters(QSqlQuery& query, const QVariantMap& parame
     try {
         // Check if query uses named parameters or positional parameters;
         // 检查查询是否使用命名参数或位置参数
-        QString sql = query.lastQuery();
+        const QString sql = query.lastQuery();
         if (sql.isEmpty()) {
             throw MappingException(QStringLiteral("Query SQL is empty, cannot bind parameters"));
         }
         
-        QRegularExpression namedParamRegex(QStringLiteral(R"(:\w+)"));
-        bool hasNamedParams = sql.contains(namedParamRegex);
-        bool hasPositionalParams = sql.contains(QStringLiteral("?"));
-        
-        if (hasNamedParams) {
-            bindByName(query, parameters);
-        } else if (hasPositionalParams) {
-            bindByIndex(query, parameters);
-        } else if (!parameters.isEmpty()) {
-            // No parameter placeholders in SQL but parameters provided, log warning;
-            // SQL中没有参数占位符但提供了参数，记录警告
-            qWarning() << "Parameters provided but no placeholders found in SQL:" << sql;
+        const QSharedPointer<const BindingPlan> plan = bindingPlan(sql);
+        setParameters(query, *plan, parameters);
+    } catch (const QtMyBatisException&) {
+        throw; // Re-throw known exceptions
+    } catch (const std::exception& e) {
+        throw MappingException(
+            QStringLiteral("Unexpected error during parameter binding: %1").arg(QString::fromLatin1(e.what()))
+        );
+    }
+}
+
+void ParameterHandler::setParameters(QSqlQuery& query, const BindingPlan& plan, const QVariantMap& parameters)
+{
+    try {
+        switch (plan.mode) {
+        case BindingPlan::Mode::Named:
+            bindByName(query, plan, parameters);
+            break;
+        case BindingPlan::Mode::Positional:
+            bindByIndex(query, plan, parameters);
+            break;
+        case BindingPlan::Mode::None:
+            break;
         }
     } catch (const QtMyBatisException&) {
         throw; // Re-throw known exceptions
@@ -45,6 +195,143 @@ void ParameterHandler::setParameters(QSqlQuery& query, const QVariantMap& parame
     }
 }
 
+void ParameterHandler::setBatchParameters(QSqlQuery& query, const QList<QVariantMap>& parametersList)
+{
+    try {
+        const QString sql = query.lastQuery();
+        if (sql.isEmpty()) {
+            throw MappingException(QStringLiteral("Query SQL is empty, cannot bind parameters"));
+        }
+        
+        const QSharedPointer<const BindingPlan> plan = bindingPlan(sql);
+        const int rowCount = parametersList.size();
+        
+        if (plan->mode == BindingPlan::Mode::Named) {
+            // 每个占位符一列，按行收集参数值
+            const int nameCount = plan->names.size();
+            QVector<QVariantList> columns(nameCount);
+            for (QVariantList& column : columns) {
+                column.reserve(rowCount);
+            }
+            
+            for (int row = 0; row < rowCount; ++row) {
+                const QVariantMap& parameters = parametersList.at(row);
+                for (int i = 0; i < nameCount; ++i) {
+                    QVariant value;
+                    if (!lookupParameter(parameters, plan->names.at(i), value)) {
+                        throw MappingException(
+                            QStringLiteral("Missing required parameter %1 in batch row %2").arg(plan->names.at(i)).arg(row)
+                        );
+                    }
+                    columns[i].append(toBindValue(value));
+                }
+            }
+            
+            if (plan->hasDuplicateNames) {
+                for (int i = 0; i < nameCount; ++i) {
+                    query.bindValue(plan->placeholders.at(i), columns.at(i));
+                }
+            } else {
+                const int positionCount = plan->positions.size();
+                for (int pos = 0; pos < positionCount; ++pos) {
+                    query.bindValue(pos, columns.at(plan->positions.at(pos)));
+                }
+            }
+        } else if (plan->mode == BindingPlan::Mode::Positional) {
+            QVector<QVariantList> columns(plan->positionalCount);
+            for (QVariantList& column : columns) {
+                column.reserve(rowCount);
+            }
+            
+            for (int row = 0; row < rowCount; ++row) {
+                const QVariantMap& parameters = parametersList.at(row);
+                if (parameters.size() != plan->positionalCount) {
+                    throw MappingException(
+                        QStringLiteral("Parameter count mismatch in batch row %1: SQL has %2 placeholders but %3 parameters provided")
+                        .arg(row)
+                        .arg(plan->positionalCount)
+                        .arg(parameters.size())
+                    );
+                }
+                
+                const QStringList keys = positionalKeys(parameters);
+                for (int i = 0; i < keys.size(); ++i) {
+                    columns[i].append(toBindValue(parameters.value(keys.at(i))));
+                }
+            }
+            
+            for (int i = 0; i < columns.size(); ++i) {
+                query.bindValue(i, columns.at(i));
+            }
+        }
+    } catch (const QtMyBatisException&) {
+        throw; // Re-throw known exceptions
+    } catch (const std::exception& e) {
+        throw MappingException(
+            QStringLiteral("Unexpected error during batch parameter binding: %1").arg(QString::fromLatin1(e.what()))
+        );
+    }
+}
+
+void ParameterHandler::setMultiRowParameters(QSqlQuery& query, const BindingPlan& rowPlan,
+                                             const QList<QVariantMap>& parametersList)
+{
+    try {
+        const int nameCount = rowPlan.names.size();
+        const int positionCount = rowPlan.positions.size();
+        QVarLengthArray<QVariant, 16> values(nameCount);
+        
+        for (int row = 0; row < parametersList.size(); ++row) {
+            const QVariantMap& parameters = parametersList.at(row);
+            for (int i = 0; i < nameCount; ++i) {
+                QVariant value;
+                if (!lookupParameter(parameters, rowPlan.names.at(i), value)) {
+                    throw MappingException(
+                        QStringLiteral("Missing required parameter %1 in batch row %2").arg(rowPlan.names.at(i)).arg(row)
+                    );
+                }
+                values[i] = toBindValue(value);
+            }
+            
+            const int base = row * positionCount;
+            for (int pos = 0; pos < positionCount; ++pos) {
+                query.bindValue(base + pos, values[rowPlan.positions.at(pos)]);
+            }
+        }
+    } catch (const QtMyBatisException&) {
+        throw; // Re-throw known exceptions
+    } catch (const std::exception& e) {
+        throw MappingException(
+            QStringLiteral("Unexpected error during batch parameter binding: %1").arg(QString::fromLatin1(e.what()))
+        );
+    }
+}
+
+QSharedPointer<const BindingPlan> ParameterHandler::bindingPlan(const QString& sql)
+{
+    // 绑定计划缓存，按处理后的SQL文本复用
+    static QHash<QString, QSharedPointer<const BindingPlan>> planCache;
+    static QMutex cacheMutex;
+    
+    {
+        QMutexLocker locker(&cacheMutex);
+        auto it = planCache.constFind(sql);
+        if (it != planCache.constEnd()) {
+            return it.value();
+        }
+    }
+    
+    QSharedPointer<const BindingPlan> plan = QSharedPointer<const BindingPlan>::create(BindingPlan::build(sql));
+    
+    QMutexLocker locker(&cacheMutex);
+    if (planCache.size() > 1000) {
+        planCache.clear();
+    }
+    planCache.insert(sql, plan);
+    
+    return plan;
+}
+
 QVariant ParameterHandler::convertParameter(const QVariant& value, const QString& targetType)
 {
     if (targetType.isEmpty()) {
@@ -67,17 +354,10 @@ QVariant ParameterHandler::convertParameter(const QVariant& value, const QString
     return convertToSqlType(value);
 }
 
-void ParameterHandler::bindByIndex(QSqlQuery& query, const QVariantMap& parameters)
+void ParameterHandler::bindByIndex(QSqlQuery& query, const BindingPlan& plan, const QVariantMap& parameters)
 {
     try {
-        // Calculate the number of placeholders in SQL
-        // 计算SQL中的占位符数量
-        QString sql = query.lastQuery();
-        int placeholderCount = sql.count(QLatin1Char('?'));
-        
-        if (placeholderCount == 0 && !parameters.isEmpty()) {
-            throw MappingException(QStringLiteral("No positional placeholders found in SQL but parameters provided"));
-        }
+        const int placeholderCount = plan.positionalCount;
         
         if (placeholderCount != parameters.size()) {
             throw MappingException(
@@ -87,35 +367,10 @@ void ParameterHandler::bindByIndex(QSqlQuery& query, const QVariantMap& paramete
             );
         }
         
-        // Bind parameters by index (using numeric keys or alphabetical order)
-        // 按索引绑定参数（使用数字键或按字母顺序）
-        QStringList keys = parameters.keys();
-        
-        // Try to sort by numeric keys, if failed then by alphabetical order
-        // 尝试按数字键排序，如果失败则按字母顺序
-        bool hasNumericKeys = true;
-        for (const QString& key : keys) {
-            bool ok;
-            key.toInt(&ok);
-            if (!ok) {
-                hasNumericKeys = false;
-                break;
-            }
-        }
-        
-        if (hasNumericKeys) {
-            // Sort by numeric keys
-            std::sort(keys.begin(), keys.end(), [](const QString& a, const QString& b) {
-                return a.toInt() < b.toInt();
-            });
-        } else {
-            // Sort by alphabetical order
-            keys.sort();
-        }
+        const QStringList keys = positionalKeys(parameters);
         
         for (int i = 0; i < keys.size(); ++i) {
-            QVariant value = convertToSqlType(parameters[keys[i]]);
-            query.bindValue(i, value);
+            query.bindValue(i, toBindValue(parameters.value(keys.at(i))));
         }
         
     } catch (const QtMyBatisException&) {
@@ -127,31 +382,21 @@ void ParameterHandler::bindByIndex(QSqlQuery& query, const QVariantMap& paramete
     }
 }
 
-void ParameterHandler::bindByName(QSqlQuery& query, const QVariantMap& parameters)
+void ParameterHandler::bindByName(QSqlQuery& query, const BindingPlan& plan, const QVariantMap& parameters)
 {
     try {
-        QString sql = query.lastQuery();
-        
-        // Extract all named parameters from SQL
-        // 提取SQL中的所有命名参数
-        QRegularExpression re(QStringLiteral(R"(:(\w+))"));
-        QRegularExpressionMatchIterator it = re.globalMatch(sql);
-        QStringList sqlParameters;
-        
-        while (it.hasNext()) {
-            QRegularExpressionMatch match = it.next();
-            QString paramName = match.captured(1);
-            if (!sqlParameters.contains(paramName)) {
-                sqlParameters.append(paramName);
-            }
-        }
-        
-        // Check for missing required parameters
-        // 检查是否有未提供的必需参数
+        // Resolve each distinct placeholder once
+        // 每个不同的占位符只查找和转换一次
+        const int nameCount = plan.names.size();
+        QVarLengthArray<QVariant, 16> values(nameCount);
         QStringList missingParams;
-        for (const QString& sqlParam : sqlParameters) {
-            if (!parameters.contains(sqlParam)) {
-                missingParams.append(sqlParam);
+        
+        for (int i = 0; i < nameCount; ++i) {
+            QVariant value;
+            if (!lookupParameter(parameters, plan.names.at(i), value)) {
+                missingParams.append(plan.names.at(i));
+            } else {
+                values[i] = toBindValue(value);
             }
         }
         
@@ -161,27 +406,17 @@ void ParameterHandler::bindByName(QSqlQuery& query, const QVariantMap& parameter
             );
         }
         
-        // Check for extra parameters
-        // 检查是否有多余的参数
-        QStringList extraParams;
-        for (auto paramIt = parameters.begin(); paramIt != parameters.end(); ++paramIt) {
-            if (!sqlParameters.contains(paramIt.key())) {
-                extraParams.append(paramIt.key());
+        if (plan.hasDuplicateNames) {
+            // QSQLite collapses repeated named placeholders itself and only
+            // accepts them bound by name
+            // 重复的命名占位符需按名称绑定，由驱动处理所有出现位置
+            for (int i = 0; i < nameCount; ++i) {
+                query.bindValue(plan.placeholders.at(i), values[i]);
             }
-        }
-        
-        if (!extraParams.isEmpty()) {
-            qWarning() << "Extra parameters provided (will be ignored):" << extraParams.join(QStringLiteral(", "));
-        }
-        
-        // Bind parameters by name
-        for (auto paramIt = parameters.begin(); paramIt != parameters.end(); ++paramIt) {
-            QString paramName = paramIt.key();
-            QString fullParamName = paramName.startsWith(QLatin1Char(':')) ? paramName : QStringLiteral(":") + paramName;
-            
-            if (isValidParameterName(fullParamName) && sqlParameters.contains(paramName)) {
-                QVariant value = convertToSqlType(paramIt.value());
-                query.bindValue(fullParamName, value);
+        } else {
+            const int positionCount = plan.positions.size();
+            for (int pos = 0; pos < positionCount; ++pos) {
+                query.bindValue(pos, values[plan.positions.at(pos)]);
             }
         }
         
@@ -194,6 +429,56 @@ void ParameterHandler::bindByName(QSqlQuery& query, const QVariantMap& parameter
     }
 }
 
+QStringList ParameterHandler::positionalKeys(const QVariantMap& parameters)
+{
+    // Bind parameters by index (using numeric keys or alphabetical order)
+    // 按索引绑定参数（使用数字键或按字母顺序）
+    QStringList keys = parameters.keys();
+    
+    // Try to sort by numeric keys, if failed then by alphabetical order
+    // 尝试按数字键排序，如果失败则按字母顺序
+    bool hasNumericKeys = true;
+    for (const QString& key : keys) {
+        bool ok;
+        key.toInt(&ok);
+        if (!ok) {
+            hasNumericKeys = false;
+            break;
+        }
+    }
+    
+    if (hasNumericKeys) {
+        // Sort by numeric keys
+        std::sort(keys.begin(), keys.end(), [](const QString& a, const QString& b) {
+            return a.toInt() < b.toInt();
+        });
+    }
+    // QVariantMap keys are already in alphabetical order
+    // QVariantMap的键本身已按字母顺序排列
+    
+    return keys;
+}
+
+QVariant ParameterHandler::toBindValue(const QVariant& value)
+{
+    // Types the driver accepts as-is skip the conversion switch
+    // 驱动可直接接受的类型无需转换
+    switch (value.typeId()) {
+        case QMetaType::QString:
+        case QMetaType::Int:
+        case QMetaType::LongLong:
+        case QMetaType::Double:
+        case QMetaType::Bool:
+        case QMetaType::QDate:
+        case QMetaType::QDateTime:
+        case QMetaType::QTime:
+        case QMetaType::QByteArray:
+            return value;
+        default:
+            return convertToSqlType(value);
+    }
+}
+
 QVariant ParameterHandler::convertToSqlType(const QVariant& value)
 {
     // Ensure value is suitable for SQL database
@@ -0,0 +1,111 @@
+#include "QtMyBatisORM/propertyplan.h"
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QObject>
+
+namespace QtMyBatisORM {
+
+QSharedPointer<const PropertyPlan> PropertyPlan::forQuery(const QMetaObject* metaObject, const QString& sql,
+                                                          const QSqlQuery& query)
+{
+    // 映射计划缓存：同一语句和目标类型只解析一次列名
+    static QHash<QString, QSharedPointer<const PropertyPlan>> planCache;
+    static QMutex cacheMutex;
+
+    const QString key = QString::fromLatin1(metaObject->className()) + QLatin1Char('\n') + sql;
+
+    {
+        QMutexLocker locker(&cacheMutex);
+        auto it = planCache.constFind(key);
+        if (it != planCache.constEnd()) {
+            return it.value();
+        }
+    }
+
+    QSharedPointer<const PropertyPlan> plan = build(metaObject, query.record());
+
+    QMutexLocker locker(&cacheMutex);
+    if (planCache.size() > 1000) {
+        planCache.clear();
+    }
+    planCache.insert(key, plan);
+
+    return plan;
+}
+
+QSharedPointer<const PropertyPlan> PropertyPlan::build(const QMetaObject* metaObject, const QSqlRecord& record)
+{
+    QSharedPointer<PropertyPlan> plan = QSharedPointer<PropertyPlan>::create();
+    plan->m_isObject = metaObject->inherits(&QObject::staticMetaObject);
+
+    for (int column = 0; column < record.count(); ++column) {
+        const int index = findProperty(metaObject, record.fieldName(column));
+        if (index >= 0) {
+            plan->m_bindings.append(Binding{column, metaObject->property(index)});
+        }
+    }
+
+    return plan;
+}
+
+void PropertyPlan::apply(const QSqlQuery& query, void* target) const
+{
+    if (m_isObject) {
+        QObject* object = static_cast<QObject*>(target);
+        for (const Binding& binding : m_bindings) {
+            binding.property.write(object, query.value(binding.column));
+        }
+    } else {
+        for (const Binding& binding : m_bindings) {
+            binding.property.writeOnGadget(target, query.value(binding.column));
+        }
+    }
+}
+
+int PropertyPlan::findProperty(const QMetaObject* metaObject, const QString& column)
+{
+    auto writable = [metaObject](int index) {
+        return index >= 0 && metaObject->property(index).isWritable() ? index : -1;
+    };
+
+    // 精确匹配
+    int index = writable(metaObject->indexOfProperty(column.toLatin1().constData()));
+    if (index >= 0) {
+        return index;
+    }
+
+    // snake_case转camelCase
+    if (column.contains(QLatin1Char('_'))) {
+        QString camel;
+        camel.reserve(column.size());
+        bool upperNext = false;
+        for (QChar ch : column) {
+            if (ch == QLatin1Char('_')) {
+                upperNext = !camel.isEmpty();
+                continue;
+            }
+            camel.append(upperNext ? ch.toUpper() : ch);
+            upperNext = false;
+        }
+        index = writable(metaObject->indexOfProperty(camel.toLatin1().constData()));
+        if (index >= 0) {
+            return index;
+        }
+    }
+
+    // 忽略大小写和下划线
+    QString normalized = column;
+    normalized.remove(QLatin1Char('_'));
+    for (int i = 0; i < metaObject->propertyCount(); ++i) {
+        const QMetaProperty property = metaObject->property(i);
+        if (property.isWritable()
+            && QString::fromLatin1(property.name()).compare(normalized, Qt::CaseInsensitive) == 0) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+} // namespace QtMyBatisORM
@@ -62,7 +62,7 @@ QVariant ResultHandler::handleSingleResult(QSqlQuery& query)
     }
 }
 
-QVariantList ResultHandler::handleListResult(QSqlQuery& query)
+QVariantList ResultHandler::handleListResult(QSqlQuery& query, int maxRows)
 {
     try {
         QVariantList results;
@@ -78,27 +78,21 @@ QVariantList ResultHandler::handleListResult(QSqlQuery& query)
             return results;
         }
         
-        // 性能优化：预分配空间和结果集大小检查
-        const int maxRows = 10000; // 防止过大的结果集
-        int rowCount = 0;
+        // 列名只读取一次，不再截断结果集；超大结果集请使用handleCursorResult
+        const QSqlRecord record = query.record();
+        const int columnCount = record.count();
+        QStringList fieldNames;
+        fieldNames.reserve(columnCount);
+        for (int i = 0; i < columnCount; ++i) {
+            fieldNames.append(record.fieldName(i));
+        }
         
-        while (query.next() && rowCount < maxRows) {
-            QSqlRecord record = query.record();
+        while ((maxRows <= 0 || results.size() < maxRows) && query.next()) {
             QVariantMap resultMap;
-            
-            for (int i = 0; i < record.count(); ++i) {
-                QString fieldName = record.fieldName(i);
-                QVariant fieldValue = normalizeValue(query.value(i));
-                resultMap[fieldName] = fieldValue;
+            for (int i = 0; i < columnCount; ++i) {
+                resultMap.insert(fieldNames.at(i), normalizeValue(query.value(i)));
             }
-            
             results.append(resultMap);
-            rowCount++;
-            
-            if (rowCount >= maxRows) {
-                qWarning() << QStringLiteral("Result set too large, limiting to %1 rows").arg(maxRows);
-                break;
-            }
         }
         
         // 检查是否有查询错误
@@ -120,6 +114,92 @@ QVariantList ResultHandler::handleListResult(QSqlQuery& query)
     }
 }
 
+ResultSet ResultHandler::handleResultSet(QSqlQuery& query, int maxRows)
+{
+    try {
+        if (!query.isActive()) {
+            if (query.lastError().isValid()) {
+                throw SqlExecutionException(
+                    QStringLiteral("Query error before processing results: %1")
+                    .arg(query.lastError().text())
+                );
+            }
+            return ResultSet();
+        }
+        
+        // 列名只保存一次，单元格按行优先顺序连续存放
+        ResultSet results(getColumnNames(query));
+        const int columnCount = results.columnCount();
+        
+        while ((maxRows <= 0 || results.rowCount() < maxRows) && query.next()) {
+            for (int i = 0; i < columnCount; ++i) {
+                results.appendValue(normalizeValue(query.value(i)));
+            }
+        }
+        
+        if (query.lastError().isValid()) {
+            throw SqlExecutionException(
+                QStringLiteral("Query error during result processing: %1")
+                .arg(query.lastError().text())
+            );
+        }
+        
+        return results;
+        
+    } catch (const QtMyBatisException&) {
+        throw; // 重新抛出已知异常
+    } catch (const std::exception& e) {
+        throw SqlExecutionException(
+            QStringLiteral("Unexpected error during list result processing: %1").arg(QString::fromLatin1(e.what()))
+        );
+    }
+}
+
+int ResultHandler::handleCursorResult(QSqlQuery& query, const RowCallback& callback, int maxRows)
+{
+    if (!query.isActive()) {
+        if (query.lastError().isValid()) {
+            throw SqlExecutionException(
+                QStringLiteral("Query error before processing results: %1")
+                .arg(query.lastError().text())
+            );
+        }
+        return 0;
+    }
+    
+    const QSqlRecord record = query.record();
+    const int columnCount = record.count();
+    QStringList fieldNames;
+    fieldNames.reserve(columnCount);
+    for (int i = 0; i < columnCount; ++i) {
+        fieldNames.append(record.fieldName(i));
+    }
+    
+    // 每次只持有当前一行，内存占用与结果集大小无关
+    int rowCount = 0;
+    QVariantMap row;
+    while ((maxRows <= 0 || rowCount < maxRows) && query.next()) {
+        row.clear();
+        for (int i = 0; i < columnCount; ++i) {
+            row.insert(fieldNames.at(i), normalizeValue(query.value(i)));
+        }
+        ++rowCount;
+        
+        if (!callback(row)) {
+            break;
+        }
+    }
+    
+    if (query.lastError().isValid()) {
+        throw SqlExecutionException(
+            QStringLiteral("Query error during result processing: %1")
+            .arg(query.lastError().text())
+        );
+    }
+    
+    return rowCount;
+}
+
 QVariant ResultHandler::convertFromSqlType(const QVariant& value, const QString& targetType)
 {
     if (value.isNull()) {
@@ -0,0 +1,109 @@
+#include "QtMyBatisORM/resultset.h"
+
+namespace QtMyBatisORM {
+
+namespace {
+
+const QStringList& emptyColumnNames()
+{
+    static const QStringList names;
+    return names;
+}
+
+} // namespace
+
+ResultSet::ResultSet()
+{
+}
+
+ResultSet::ResultSet(const QStringList& columnNames)
+{
+    QSharedPointer<Header> header = QSharedPointer<Header>::create();
+    header->names = columnNames;
+    header->indexes.reserve(columnNames.size());
+    for (int i = 0; i < columnNames.size(); ++i) {
+        // 重名列按第一次出现的位置解析，与QSqlRecord::indexOf一致
+        if (!header->indexes.contains(columnNames.at(i))) {
+            header->indexes.insert(columnNames.at(i), i);
+        }
+    }
+    m_header = header;
+}
+
+int ResultSet::rowCount() const
+{
+    const int columns = columnCount();
+    return columns > 0 ? m_cells.size() / columns : 0;
+}
+
+int ResultSet::columnCount() const
+{
+    return m_header ? m_header->names.size() : 0;
+}
+
+bool ResultSet::isEmpty() const
+{
+    return m_cells.isEmpty();
+}
+
+const QStringList& ResultSet::columnNames() const
+{
+    return m_header ? m_header->names : emptyColumnNames();
+}
+
+int ResultSet::columnIndex(const QString& name) const
+{
+    return m_header ? m_header->indexes.value(name, -1) : -1;
+}
+
+QVariant ResultSet::value(int row, int column) const
+{
+    const int columns = columnCount();
+    if (row < 0 || column < 0 || column >= columns || row >= rowCount()) {
+        return QVariant();
+    }
+    return m_cells.at(row * columns + column);
+}
+
+QVariant ResultSet::value(int row, const QString& column) const
+{
+    return value(row, columnIndex(column));
+}
+
+QVariantMap ResultSet::rowMap(int row) const
+{
+    QVariantMap map;
+    if (row < 0 || row >= rowCount()) {
+        return map;
+    }
+
+    const QStringList& names = m_header->names;
+    const int offset = row * names.size();
+    for (int i = 0; i < names.size(); ++i) {
+        map.insert(names.at(i), m_cells.at(offset + i));
+    }
+    return map;
+}
+
+QVariantList ResultSet::toVariantList() const
+{
+    QVariantList rows;
+    const int count = rowCount();
+    rows.reserve(count);
+    for (int row = 0; row < count; ++row) {
+        rows.append(rowMap(row));
+    }
+    return rows;
+}
+
+void ResultSet::reserve(int rows)
+{
+    m_cells.reserve(rows * columnCount());
+}
+
+void ResultSet::appendValue(const QVariant& value)
+{
+    m_cells.append(value);
+}
+
+} // namespace QtMyBatisORM
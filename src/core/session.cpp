@@ -3,14 +3,71 @@
 #include "QtMyBatisORM/mapperregistry.h"
 #include "QtMyBatisORM/qtmybatisexception.h"
 #include "QtMyBatisORM/logger.h"
+#include "QtMyBatisORM/batchloader.h"
+#include "QtMyBatisORM/dynamicsqlprocessor.h"
 #include <QTimer>
 #include <QDateTime>
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QUuid>
+#include <QSet>
+#include <utility>
 
 namespace QtMyBatisORM {
 
+namespace {
+
+// 单条IN列表的键数上限，过长的列表会拖慢语句解析与查询计划
+constexpr int kMaxKeysPerChunk = 1024;
+
+/**
+ * 单条语句调用的异常包装，语句ID与语句句柄两组重载共用：
+ * 超时与取消原样抛出，其他异常转为带operation/statementId/parameters上下文的SessionException
+ */
+template <typename Operation>
+auto runStatement(QLatin1String operation, const char* errorCode, const QString& statementId,
+                  const QVariantMap& parameters, Operation&& run) -> decltype(run())
+{
+    try {
+        return run();
+    } catch (const TimeoutException&) {
+        throw; // 超时与取消保持原异常类型
+    } catch (const SessionException& e) {
+        SessionException ex(e);
+        ex.setContext(QLatin1String("operation"), operation);
+        ex.setContext(QStringLiteral("statementId"), statementId);
+        ex.setContext(QStringLiteral("parameters"), parameters);
+        throw ex;
+    } catch (const QtMyBatisException& e) {
+        SessionException ex(
+            QStringLiteral("Failed to execute %1: %2").arg(operation, e.message()),
+            QLatin1String(errorCode)
+        );
+        QVariantMap context;
+        context[QLatin1String("operation")] = operation;
+        context[QStringLiteral("statementId")] = statementId;
+        context[QStringLiteral("parameters")] = parameters;
+        context[QStringLiteral("originalError")] = e.message();
+        context[QStringLiteral("originalCode")] = e.code();
+        ex.setContext(context);
+        throw ex;
+    } catch (const std::exception& e) {
+        SessionException ex(
+            QStringLiteral("Unexpected error in %1: %2").arg(operation, QString::fromUtf8(e.what())),
+            "SESSION_UNEXPECTED_ERROR"
+        );
+        QVariantMap context;
+        context[QLatin1String("operation")] = operation;
+        context[QStringLiteral("statementId")] = statementId;
+        context[QStringLiteral("parameters")] = parameters;
+        context[QLatin1String("stdError")] = QString::fromUtf8(e.what());
+        ex.setContext(context);
+        throw ex;
+    }
+}
+
+} // namespace
+
 Session::Session(QSharedPointer<QSqlDatabase> connection,
                 QSharedPointer<Executor> executor,
                 QSharedPointer<MapperRegistry> mapperRegistry,
@@ -32,26 +89,141 @@ Session::Session(QSharedPointer<QSqlDatabase> connection,
 }
 
 QVariant Session::selectOne(const QString& statementId, const QVariantMap& parameters)
+{
+    return runStatement(QLatin1String("selectOne"), "SESSION_SELECT_ONE_ERROR", statementId, parameters, [&]() {
+        checkClosed();
+        executeQueuedBatches();
+        const StatementConfig statement = getStatementConfig(statementId);
+        return m_executor->queryWithCache(statementId, statement.sql, parameters, statementOptions(statement));
+    });
+}
+
+QVariantList Session::selectList(const QString& statementId, const QVariantMap& parameters)
+{
+    return runStatement(QLatin1String("selectList"), "SESSION_SELECT_LIST_ERROR", statementId, parameters, [&]() {
+        checkClosed();
+        executeQueuedBatches();
+        const StatementConfig statement = getStatementConfig(statementId);
+        return m_executor->queryListWithCache(statementId, statement.sql, parameters, statementOptions(statement));
+    });
+}
+
+PageResult Session::selectPage(const QString& statementId, const QVariantMap& parameters, int page, int pageSize)
 {
     try {
         checkClosed();
-        QString sql = getStatementSql(statementId);
-        return m_executor->queryWithCache(statementId, sql, parameters);
+        
+        if (page < 1 || pageSize < 1) {
+            throw SessionException(
+                QStringLiteral("Invalid page %1 of size %2: both must be at least 1").arg(page).arg(pageSize),
+                "SESSION_SELECT_PAGE_ERROR"
+            );
+        }
+        
+        executeQueuedBatches();
+        const StatementConfig statement = getStatementConfig(statementId);
+        return m_executor->queryPage(statementId, statement.sql, parameters, page, pageSize, statementOptions(statement));
+    } catch (const TimeoutException&) {
+        throw; // 超时与取消保持原异常类型
     } catch (const SessionException& e) {
-        // Add context and re-throw
         SessionException ex(e);
-        ex.setContext(QLatin1String("operation"), QLatin1String("selectOne"));
+        ex.setContext(QLatin1String("operation"), QLatin1String("selectPage"));
+        ex.setContext(QStringLiteral("statementId"), statementId);
+        ex.setContext(QStringLiteral("parameters"), parameters);
+        ex.setContext(QStringLiteral("page"), page);
+        ex.setContext(QStringLiteral("pageSize"), pageSize);
+        throw ex;
+    } catch (const QtMyBatisException& e) {
+        SessionException ex(
+            QStringLiteral("Failed to execute selectPage: %1").arg(e.message()),
+            "SESSION_SELECT_PAGE_ERROR"
+        );
+        ex.setContext(QLatin1String("operation"), QLatin1String("selectPage"));
+        ex.setContext(QStringLiteral("statementId"), statementId);
+        ex.setContext(QStringLiteral("parameters"), parameters);
+        ex.setContext(QStringLiteral("page"), page);
+        ex.setContext(QStringLiteral("pageSize"), pageSize);
+        ex.setContext(QStringLiteral("originalError"), e.message());
+        ex.setContext(QStringLiteral("originalCode"), e.code());
+        throw ex;
+    } catch (const std::exception& e) {
+        SessionException ex(
+            QStringLiteral("Unexpected error in selectPage: %1").arg(QString::fromUtf8(e.what())),
+            "SESSION_UNEXPECTED_ERROR"
+        );
+        ex.setContext(QLatin1String("operation"), QLatin1String("selectPage"));
         ex.setContext(QStringLiteral("statementId"), statementId);
         ex.setContext(QStringLiteral("parameters"), parameters);
+        ex.setContext(QLatin1String("stdError"), QString::fromUtf8(e.what()));
+        throw ex;
+    }
+}
+
+QVariantList Session::selectKeysetPage(const QString& statementId, const QStringList& keyColumns,
+                                       const QVariantList& lastKey, const QVariantMap& parameters, int pageSize)
+{
+    try {
+        checkClosed();
+        executeQueuedBatches();
+        const StatementConfig statement = getStatementConfig(statementId);
+        return m_executor->queryKeysetPage(statementId, statement.sql, parameters, keyColumns, lastKey,
+                                           pageSize, statementOptions(statement));
+    } catch (const TimeoutException&) {
+        throw; // 超时与取消保持原异常类型
+    } catch (const SessionException& e) {
+        SessionException ex(e);
+        ex.setContext(QLatin1String("operation"), QLatin1String("selectKeysetPage"));
+        ex.setContext(QStringLiteral("statementId"), statementId);
+        ex.setContext(QStringLiteral("keyColumns"), keyColumns);
+        ex.setContext(QStringLiteral("lastKey"), lastKey);
         throw ex;
     } catch (const QtMyBatisException& e) {
-        // Wrap other exceptions as session exceptions
         SessionException ex(
-            QStringLiteral("Failed to execute selectOne: %1").arg(e.message()),
-            "SESSION_SELECT_ONE_ERROR"
+            QStringLiteral("Failed to execute selectKeysetPage: %1").arg(e.message()),
+            "SESSION_SELECT_KEYSET_ERROR"
         );
+        ex.setContext(QLatin1String("operation"), QLatin1String("selectKeysetPage"));
+        ex.setContext(QStringLiteral("statementId"), statementId);
+        ex.setContext(QStringLiteral("keyColumns"), keyColumns);
+        ex.setContext(QStringLiteral("lastKey"), lastKey);
+        ex.setContext(QStringLiteral("originalError"), e.message());
+        ex.setContext(QStringLiteral("originalCode"), e.code());
+        throw ex;
+    } catch (const std::exception& e) {
+        SessionException ex(
+            QStringLiteral("Unexpected error in selectKeysetPage: %1").arg(QString::fromUtf8(e.what())),
+            "SESSION_UNEXPECTED_ERROR"
+        );
+        ex.setContext(QLatin1String("operation"), QLatin1String("selectKeysetPage"));
+        ex.setContext(QStringLiteral("statementId"), statementId);
+        ex.setContext(QLatin1String("stdError"), QString::fromUtf8(e.what()));
+        throw ex;
+    }
+}
+
+ResultSet Session::selectResultSet(const QString& statementId, const QVariantMap& parameters)
+{
+    try {
+        checkClosed();
+        executeQueuedBatches();
+        const StatementConfig statement = getStatementConfig(statementId);
+        return m_executor->queryResultSetWithCache(statementId, statement.sql, parameters, statementOptions(statement));
+    } catch (const TimeoutException&) {
+        throw; // 超时与取消保持原异常类型
+    } catch (const SessionException& e) {
+        SessionException ex(e);
+        ex.setContext(QLatin1String("operation"), QLatin1String("selectResultSet"));
+        ex.setContext(QStringLiteral("statementId"), statementId);
+        ex.setContext(QStringLiteral("parameters"), parameters);
+        throw ex;
+    } catch (const QtMyBatisException& e) {
+        SessionException ex(
+            QStringLiteral("Failed to execute selectResultSet: %1").arg(e.message()),
+            "SESSION_SELECT_RESULT_SET_ERROR"
+        );
+
         QVariantMap context;
-        context[QLatin1String("operation")] = QLatin1String("selectOne");
+        context[QLatin1String("operation")] = QLatin1String("selectResultSet");
         context[QStringLiteral("statementId")] = statementId;
         context[QStringLiteral("parameters")] = parameters;
         context[QStringLiteral("originalError")] = e.message();
@@ -60,11 +232,11 @@ QVariant Session::selectOne(const QString& statementId, const QVariantMap& param
         throw ex;
     } catch (const std::exception& e) {
         SessionException ex(
-            QLatin1String("Unexpected error in selectOne: %1") +(e.what()),
+            QStringLiteral("Unexpected error in selectResultSet: %1").arg(QString::fromUtf8(e.what())),
             "SESSION_UNEXPECTED_ERROR"
         );
         QVariantMap context;
-        context[QLatin1String("operation")] = QLatin1String("selectOne");
+        context[QLatin1String("operation")] = QLatin1String("selectResultSet");
         context[QStringLiteral("statementId")] = statementId;
         context[QStringLiteral("parameters")] = parameters;
         context[QLatin1String("stdError")] = QString::fromUtf8(e.what());
@@ -73,26 +245,30 @@ QVariant Session::selectOne(const QString& statementId, const QVariantMap& param
     }
 }
 
-QVariantList Session::selectList(const QString& statementId, const QVariantMap& parameters)
+int Session::selectCursor(const QString& statementId, const QVariantMap& parameters,
+                          const RowCallback& callback)
 {
     try {
         checkClosed();
-        QString sql = getStatementSql(statementId);
-        return m_executor->queryListWithCache(statementId, sql, parameters);
+        executeQueuedBatches();
+        const StatementConfig statement = getStatementConfig(statementId);
+        return m_executor->queryCursor(statement.sql, parameters, callback, statementOptions(statement));
+    } catch (const TimeoutException&) {
+        throw; // 超时与取消保持原异常类型
     } catch (const SessionException& e) {
         SessionException ex(e);
-        ex.setContext(QLatin1String("operation"), QLatin1String("selectList"));
+        ex.setContext(QLatin1String("operation"), QLatin1String("selectCursor"));
         ex.setContext(QStringLiteral("statementId"), statementId);
         ex.setContext(QStringLiteral("parameters"), parameters);
         throw ex;
     } catch (const QtMyBatisException& e) {
         SessionException ex(
-            QStringLiteral("Failed to execute selectList: %1").arg(e.message()),
-            "SESSION_SELECT_LIST_ERROR"
+            QStringLiteral("Failed to execute selectCursor: %1").arg(e.message()),
+            "SESSION_SELECT_CURSOR_ERROR"
         );
 
         QVariantMap context;
-        context[QLatin1String("operation")] = QLatin1String("selectList");
+        context[QLatin1String("operation")] = QLatin1String("selectCursor");
         context[QStringLiteral("statementId")] = statementId;
         context[QStringLiteral("parameters")] = parameters;
         context[QStringLiteral("originalError")] = e.message();
@@ -101,11 +277,11 @@ QVariantList Session::selectList(const QString& statementId, const QVariantMap&
         throw ex;
     } catch (const std::exception& e) {
         SessionException ex(
-            QLatin1String("Unexpected error in selectList: %1") +(e.what()),
+            QStringLiteral("Unexpected error in selectCursor: %1").arg(QString::fromUtf8(e.what())),
             "SESSION_UNEXPECTED_ERROR"
         );
         QVariantMap context;
-        context[QLatin1String("operation")] = QLatin1String("selectList");
+        context[QLatin1String("operation")] = QLatin1String("selectCursor");
         context[QStringLiteral("statementId")] = statementId;
         context[QStringLiteral("parameters")] = parameters;
         context[QLatin1String("stdError")] = QString::fromUtf8(e.what());
@@ -114,25 +290,31 @@ QVariantList Session::selectList(const QString& statementId, const QVariantMap&
     }
 }
 
-int Session::insert(const QString& statementId, const QVariantMap& parameters)
+int Session::selectObjects(const QString& statementId, const QVariantMap& parameters,
+                           const QMetaObject* metaObject, const std::function<void*()>& nextObject, int maxRows)
 {
     try {
         checkClosed();
-        QString sql = getStatementSql(statementId);
-        return m_executor->updateWithCacheInvalidation(statementId, sql, parameters);
+        executeQueuedBatches();
+        const StatementConfig statement = getStatementConfig(statementId);
+        return m_executor->queryObjects(statement.sql, parameters, metaObject, nextObject, maxRows,
+                                        statementOptions(statement));
+    } catch (const TimeoutException&) {
+        throw; // 超时与取消保持原异常类型
     } catch (const SessionException& e) {
         SessionException ex(e);
-        ex.setContext(QLatin1String("operation"), QLatin1String("insert"));
+        ex.setContext(QLatin1String("operation"), QLatin1String("selectTyped"));
         ex.setContext(QStringLiteral("statementId"), statementId);
         ex.setContext(QStringLiteral("parameters"), parameters);
         throw ex;
     } catch (const QtMyBatisException& e) {
         SessionException ex(
-            QStringLiteral("Failed to execute insert: %1").arg(e.message()),
-            "SESSION_INSERT_ERROR"
+            QStringLiteral("Failed to execute selectTyped: %1").arg(e.message()),
+            "SESSION_SELECT_TYPED_ERROR"
         );
+
         QVariantMap context;
-        context[QLatin1String("operation")] = QLatin1String("insert");
+        context[QLatin1String("operation")] = QLatin1String("selectTyped");
         context[QStringLiteral("statementId")] = statementId;
         context[QStringLiteral("parameters")] = parameters;
         context[QStringLiteral("originalError")] = e.message();
@@ -141,11 +323,11 @@ int Session::insert(const QString& statementId, const QVariantMap& parameters)
         throw ex;
     } catch (const std::exception& e) {
         SessionException ex(
-            QLatin1String("Unexpected error in insert: %1") +(e.what()),
+            QStringLiteral("Unexpected error in selectTyped: %1").arg(QString::fromUtf8(e.what())),
             "SESSION_UNEXPECTED_ERROR"
         );
         QVariantMap context;
-        context[QLatin1String("operation")] = QLatin1String("insert");
+        context[QLatin1String("operation")] = QLatin1String("selectTyped");
         context[QStringLiteral("statementId")] = statementId;
         context[QStringLiteral("parameters")] = parameters;
         context[QLatin1String("stdError")] = QString::fromUtf8(e.what());
@@ -154,25 +336,29 @@ int Session::insert(const QString& statementId, const QVariantMap& parameters)
     }
 }
 
-int Session::update(const QString& statementId, const QVariantMap& parameters)
+QVariant Session::selectScalar(const QString& statementId, const QVariantMap& parameters)
 {
     try {
         checkClosed();
-        QString sql = getStatementSql(statementId);
-        return m_executor->updateWithCacheInvalidation(statementId, sql, parameters);
+        executeQueuedBatches();
+        const StatementConfig statement = getStatementConfig(statementId);
+        return m_executor->queryValue(statement.sql, parameters, statementOptions(statement));
+    } catch (const TimeoutException&) {
+        throw; // 超时与取消保持原异常类型
     } catch (const SessionException& e) {
         SessionException ex(e);
-        ex.setContext(QLatin1String("operation"), QLatin1String("update"));
+        ex.setContext(QLatin1String("operation"), QLatin1String("selectValue"));
         ex.setContext(QStringLiteral("statementId"), statementId);
         ex.setContext(QStringLiteral("parameters"), parameters);
         throw ex;
     } catch (const QtMyBatisException& e) {
         SessionException ex(
-            QStringLiteral("Failed to execute update: %1").arg(e.message()),
-            "SESSION_UPDATE_ERROR"
+            QStringLiteral("Failed to execute selectValue: %1").arg(e.message()),
+            "SESSION_SELECT_VALUE_ERROR"
         );
+
         QVariantMap context;
-        context[QLatin1String("operation")] = QLatin1String("update");
+        context[QLatin1String("operation")] = QLatin1String("selectValue");
         context[QStringLiteral("statementId")] = statementId;
         context[QStringLiteral("parameters")] = parameters;
         context[QStringLiteral("originalError")] = e.message();
@@ -181,11 +367,11 @@ int Session::update(const QString& statementId, const QVariantMap& parameters)
         throw ex;
     } catch (const std::exception& e) {
         SessionException ex(
-            QLatin1String("Unexpected error in update: %1") +(e.what()),
+            QStringLiteral("Unexpected error in selectValue: %1").arg(QString::fromUtf8(e.what())),
             "SESSION_UNEXPECTED_ERROR"
         );
         QVariantMap context;
-        context[QLatin1String("operation")] = QLatin1String("update");
+        context[QLatin1String("operation")] = QLatin1String("selectValue");
         context[QStringLiteral("statementId")] = statementId;
         context[QStringLiteral("parameters")] = parameters;
         context[QLatin1String("stdError")] = QString::fromUtf8(e.what());
@@ -194,25 +380,358 @@ int Session::update(const QString& statementId, const QVariantMap& parameters)
     }
 }
 
-int Session::remove(const QString& statementId, const QVariantMap& parameters)
+QList<QVariantList> Session::splitKeys(const QVariantList& keys, int reservedVariables)
+{
+    checkClosed();
+    
+    // 每块的键数取不超过绑定变量上限的2的幂，完整的块生成相同的SQL并复用同一条预编译语句
+    const int budget = qMin(kMaxKeysPerChunk, m_executor->maxBindVariables() - reservedVariables);
+    if (budget < 1) {
+        throw SessionException(
+            QStringLiteral("No bind variables left for keys: %1 reserved by other parameters")
+            .arg(reservedVariables),
+            "SESSION_SELECT_BY_KEYS_ERROR"
+        );
+    }
+    int chunkSize = 1;
+    while (chunkSize * 2 <= budget) {
+        chunkSize *= 2;
+    }
+    
+    // 去除空值与重复键，保持首次出现的顺序
+    QList<QVariantList> chunks;
+    QSet<QString> seen;
+    seen.reserve(keys.size());
+    QVariantList opaqueKeys;
+    QVariantList chunk;
+    for (const QVariant& key : keys) {
+        if (key.isNull()) {
+            continue;
+        }
+        const QString text = key.toString();
+        if (!text.isEmpty() || key.typeId() == QMetaType::QString) {
+            if (seen.contains(text)) {
+                continue;
+            }
+            seen.insert(text);
+        } else {
+            // 没有字符串形式的键按值比较，不能都归为空串
+            if (opaqueKeys.contains(key)) {
+                continue;
+            }
+            opaqueKeys.append(key);
+        }
+        chunk.append(key);
+        if (chunk.size() == chunkSize) {
+            chunks.append(chunk);
+            chunk.clear();
+        }
+    }
+    if (!chunk.isEmpty()) {
+        chunks.append(chunk);
+    }
+    
+    return chunks;
+}
+
+QVariantList Session::selectByKeys(const QString& statementId, const QString& keyParam, const QVariantList& keys,
+                                   const QVariantMap& parameters)
 {
     try {
         checkClosed();
-        QString sql = getStatementSql(statementId);
-        return m_executor->updateWithCacheInvalidation(statementId, sql, parameters);
+        executeQueuedBatches();
+        const StatementConfig statement = getStatementConfig(statementId);
+        
+        // 键集合很少重复出现，分块结果不进入结果缓存
+        StatementOptions options = statementOptions(statement);
+        options.useCache = false;
+        
+        QVariantList rows;
+        QVariantMap chunkParameters = parameters;
+        const QList<QVariantList> chunks = splitKeys(keys, parameters.size());
+        for (const QVariantList& chunk : chunks) {
+            chunkParameters.insert(keyParam, chunk);
+            rows.append(m_executor->queryListWithCache(statementId, statement.sql, chunkParameters, options));
+        }
+        return rows;
+    } catch (const TimeoutException&) {
+        throw; // 超时与取消保持原异常类型
     } catch (const SessionException& e) {
         SessionException ex(e);
-        ex.setContext(QLatin1String("operation"), QLatin1String("remove"));
+        ex.setContext(QLatin1String("operation"), QLatin1String("selectByKeys"));
+        ex.setContext(QStringLiteral("statementId"), statementId);
+        ex.setContext(QStringLiteral("keyCount"), keys.size());
+        throw ex;
+    } catch (const QtMyBatisException& e) {
+        SessionException ex(
+            QStringLiteral("Failed to execute selectByKeys: %1").arg(e.message()),
+            "SESSION_SELECT_BY_KEYS_ERROR"
+        );
+        
+        QVariantMap context;
+        context[QLatin1String("operation")] = QLatin1String("selectByKeys");
+        context[QStringLiteral("statementId")] = statementId;
+        context[QStringLiteral("keyParam")] = keyParam;
+        context[QStringLiteral("keyCount")] = keys.size();
+        context[QStringLiteral("originalError")] = e.message();
+        context[QStringLiteral("originalCode")] = e.code();
+        ex.setContext(context);
+        throw ex;
+    } catch (const std::exception& e) {
+        SessionException ex(
+            QStringLiteral("Unexpected error in selectByKeys: %1").arg(QString::fromUtf8(e.what())),
+            "SESSION_UNEXPECTED_ERROR"
+        );
+        QVariantMap context;
+        context[QLatin1String("operation")] = QLatin1String("selectByKeys");
+        context[QStringLiteral("statementId")] = statementId;
+        context[QStringLiteral("keyCount")] = keys.size();
+        context[QLatin1String("stdError")] = QString::fromUtf8(e.what());
+        ex.setContext(context);
+        throw ex;
+    }
+}
+
+QHash<QString, QVariantMap> Session::selectMapByKeys(const QString& statementId, const QString& keyParam,
+                                                     const QVariantList& keys, const QString& mapKey,
+                                                     const QVariantMap& parameters)
+{
+    const QVariantList rows = selectByKeys(statementId, keyParam, keys, parameters);
+    
+    QHash<QString, QVariantMap> result;
+    result.reserve(rows.size());
+    for (const QVariant& rowValue : rows) {
+        const QVariantMap row = rowValue.toMap();
+        auto column = row.constFind(mapKey);
+        if (column == row.constEnd()) {
+            SessionException ex(
+                QStringLiteral("Column %1 not found in the result of %2").arg(mapKey, statementId),
+                "SESSION_SELECT_BY_KEYS_ERROR"
+            );
+            ex.setContext(QLatin1String("operation"), QLatin1String("selectMapByKeys"));
+            ex.setContext(QStringLiteral("statementId"), statementId);
+            ex.setContext(QStringLiteral("mapKey"), mapKey);
+            throw ex;
+        }
+        result.insert(column.value().toString(), row);
+    }
+    return result;
+}
+
+void Session::setExecutorType(ExecutorType type)
+{
+    checkClosed();
+    
+    // 切换回SIMPLE模式前执行已排队的写操作
+    if (type == ExecutorType::Simple) {
+        executeQueuedBatches();
+    }
+    m_executorType = type;
+}
+
+ExecutorType Session::executorType() const
+{
+    return m_executorType;
+}
+
+void Session::setBatchFlushThreshold(int rows)
+{
+    m_batchFlushThreshold = qMax(0, rows);
+}
+
+int Session::batchFlushThreshold() const
+{
+    return m_batchFlushThreshold;
+}
+
+int Session::pendingBatchRows() const
+{
+    return m_batchQueuedRows;
+}
+
+void Session::setQueryTimeout(int milliseconds)
+{
+    m_queryTimeoutMs = qMax(0, milliseconds);
+}
+
+int Session::queryTimeout() const
+{
+    return m_queryTimeoutMs;
+}
+
+void Session::setCancellationToken(const CancellationToken& token)
+{
+    m_cancellationToken = token;
+}
+
+CancellationToken Session::cancellationToken() const
+{
+    return m_cancellationToken;
+}
+
+QList<BatchStatementResult> Session::flushStatements()
+{
+    checkClosed();
+    executeQueuedBatches();
+    return std::exchange(m_batchResults, {});
+}
+
+int Session::queueStatement(const QString& statementId, const StatementConfig& statement,
+                            const QVariantMap& parameters)
+{
+    // 与MyBatis的BatchExecutor一致：只有与队尾分组的语句ID和渲染后的SQL相同时才合并，
+    // 否则新开一组，交错的写操作按调用顺序执行
+    const QString sql = DynamicSqlProcessor::processCached(statement.sql, parameters);
+    
+    if (m_batchQueue.isEmpty() || m_batchQueue.last().statementId != statementId
+        || m_batchQueue.last().sql != sql) {
+        QueuedBatch batch;
+        batch.statementId = statementId;
+        batch.sql = sql;
+        batch.options = statementOptions(statement);
+        m_batchQueue.append(batch);
+    }
+    m_batchQueue.last().rows.append(parameters);
+    ++m_batchQueuedRows;
+    
+    if (m_batchFlushThreshold > 0 && m_batchQueuedRows >= m_batchFlushThreshold) {
+        executeQueuedBatches();
+    }
+    
+    // 与MyBatis一致，受影响的行数在flushStatements()的报告中返回
+    return 0;
+}
+
+void Session::executeQueuedBatches()
+{
+    if (m_batchQueue.isEmpty()) {
+        return;
+    }
+    
+    const QList<QueuedBatch> queue = std::exchange(m_batchQueue, {});
+    m_batchQueuedRows = 0;
+    
+    // 没有外层事务时整个队列在一个事务中执行
+    const bool wasInTransaction = m_inTransaction;
+    if (!wasInTransaction) {
+        beginTransaction();
+    }
+    
+    QList<BatchStatementResult> results;
+    results.reserve(queue.size());
+    const QueuedBatch* current = nullptr;
+    try {
+        for (const QueuedBatch& batch : queue) {
+            current = &batch;
+            BatchStatementResult result;
+            result.statementId = batch.statementId;
+            result.sql = batch.sql;
+            result.rowCount = batch.rows.size();
+            result.affectedRows = m_executor->flushBatch(batch.statementId, batch.sql, batch.rows, batch.options);
+            results.append(result);
+        }
+        
+        if (!wasInTransaction) {
+            commit();
+        }
+    } catch (const TimeoutException&) {
+        if (!wasInTransaction) {
+            rollback();
+        }
+        throw; // 超时与取消保持原异常类型
+    } catch (const QtMyBatisException& e) {
+        if (!wasInTransaction) {
+            rollback();
+        }
+        
+        // 失败后剩余的分组不再执行
+        SessionException ex(
+            QStringLiteral("Failed to flush batch statements: %1").arg(e.message()),
+            "SESSION_BATCH_FLUSH_ERROR"
+        );
+        ex.setContext(QLatin1String("operation"), QLatin1String("flushStatements"));
+        if (current) {
+            ex.setContext(QStringLiteral("statementId"), current->statementId);
+            ex.setContext(QStringLiteral("sql"), current->sql);
+        }
+        ex.setContext(QStringLiteral("completedStatements"), results.size());
+        ex.setContext(QStringLiteral("queuedStatements"), queue.size());
+        ex.setContext(QStringLiteral("originalError"), e.message());
+        ex.setContext(QStringLiteral("originalCode"), e.code());
+        throw ex;
+    }
+    
+    m_batchResults.append(results);
+}
+
+void Session::discardQueuedBatches()
+{
+    m_batchQueue.clear();
+    m_batchQueuedRows = 0;
+    m_batchResults.clear();
+}
+
+BatchLoader* Session::loader(const QString& statementId, const QString& keyParam, const QString& keyColumn)
+{
+    checkClosed();
+    
+    const QString loaderKey = statementId + QLatin1Char('|') + keyParam + QLatin1Char('|') + keyColumn;
+    BatchLoader*& loader = m_loaders[loaderKey];
+    if (!loader) {
+        loader = new BatchLoader(this, statementId, keyParam, keyColumn, this);
+    }
+    return loader;
+}
+
+void Session::clearLoaders()
+{
+    // 写操作之后记忆的结果可能已过期
+    for (BatchLoader* loader : std::as_const(m_loaders)) {
+        loader->clear();
+    }
+}
+
+int Session::insert(const QString& statementId, const QVariantMap& parameters)
+{
+    return runStatement(QLatin1String("insert"), "SESSION_INSERT_ERROR", statementId, parameters, [&]() {
+        checkClosed();
+        clearLoaders();
+        const StatementConfig statement = getStatementConfig(statementId);
+        if (m_executorType == ExecutorType::Batch) {
+            return queueStatement(statementId, statement, parameters);
+        }
+        return m_executor->updateWithCacheInvalidation(statementId, statement.sql, parameters,
+                                                       statementOptions(statement));
+    });
+}
+
+QVariantList Session::insertWithKeys(const QString& statementId, const QVariantMap& parameters)
+{
+    try {
+        checkClosed();
+        clearLoaders();
+        // 生成键需要立即执行，BATCH模式下先执行队列中的写操作以保持顺序
+        executeQueuedBatches();
+        const StatementConfig statement = getStatementConfig(statementId);
+        QVariantList generatedKeys;
+        m_executor->updateWithGeneratedKeys(statementId, statement.sql, parameters, statementOptions(statement),
+                                            statement.generatedKeyColumn(), generatedKeys);
+        return generatedKeys;
+    } catch (const TimeoutException&) {
+        throw; // 超时与取消保持原异常类型
+    } catch (const SessionException& e) {
+        SessionException ex(e);
+        ex.setContext(QLatin1String("operation"), QLatin1String("insertWithKeys"));
         ex.setContext(QStringLiteral("statementId"), statementId);
         ex.setContext(QStringLiteral("parameters"), parameters);
         throw ex;
     } catch (const QtMyBatisException& e) {
         SessionException ex(
-            QStringLiteral("Failed to execute remove: %1").arg(e.message()),
-            "SESSION_REMOVE_ERROR"
+            QStringLiteral("Failed to execute insert: %1").arg(e.message()),
+            "SESSION_INSERT_ERROR"
         );
         QVariantMap context;
-        context[QLatin1String("operation")] = QLatin1String("remove");
+        context[QLatin1String("operation")] = QLatin1String("insertWithKeys");
         context[QStringLiteral("statementId")] = statementId;
         context[QStringLiteral("parameters")] = parameters;
         context[QStringLiteral("originalError")] = e.message();
@@ -221,11 +740,11 @@ int Session::remove(const QString& statementId, const QVariantMap& parameters)
         throw ex;
     } catch (const std::exception& e) {
         SessionException ex(
-            QLatin1String("Unexpected error in remove: %1") +(e.what()),
+            QStringLiteral("Unexpected error in insertWithKeys: %1").arg(QString::fromUtf8(e.what())),
             "SESSION_UNEXPECTED_ERROR"
         );
         QVariantMap context;
-        context[QLatin1String("operation")] = QLatin1String("remove");
+        context[QLatin1String("operation")] = QLatin1String("insertWithKeys");
         context[QStringLiteral("statementId")] = statementId;
         context[QStringLiteral("parameters")] = parameters;
         context[QLatin1String("stdError")] = QString::fromUtf8(e.what());
@@ -234,10 +753,99 @@ int Session::remove(const QString& statementId, const QVariantMap& parameters)
     }
 }
 
+int Session::update(const QString& statementId, const QVariantMap& parameters)
+{
+    return runStatement(QLatin1String("update"), "SESSION_UPDATE_ERROR", statementId, parameters, [&]() {
+        checkClosed();
+        clearLoaders();
+        const StatementConfig statement = getStatementConfig(statementId);
+        if (m_executorType == ExecutorType::Batch) {
+            return queueStatement(statementId, statement, parameters);
+        }
+        return m_executor->updateWithCacheInvalidation(statementId, statement.sql, parameters,
+                                                       statementOptions(statement));
+    });
+}
+
+int Session::remove(const QString& statementId, const QVariantMap& parameters)
+{
+    return runStatement(QLatin1String("remove"), "SESSION_REMOVE_ERROR", statementId, parameters, [&]() {
+        checkClosed();
+        clearLoaders();
+        const StatementConfig statement = getStatementConfig(statementId);
+        if (m_executorType == ExecutorType::Batch) {
+            return queueStatement(statementId, statement, parameters);
+        }
+        return m_executor->updateWithCacheInvalidation(statementId, statement.sql, parameters,
+                                                       statementOptions(statement));
+    });
+}
+
+QVariant Session::selectOne(const StatementHandle& statement, const QVariantMap& parameters)
+{
+    return runStatement(QLatin1String("selectOne"), "SESSION_SELECT_ONE_ERROR", statement.id(), parameters, [&]() {
+        checkClosed();
+        executeQueuedBatches();
+        const CompiledStatement& compiled = compiledStatement(statement);
+        return m_executor->queryWithCache(compiled, parameters, withSessionOptions(compiled.options));
+    });
+}
+
+QVariantList Session::selectList(const StatementHandle& statement, const QVariantMap& parameters)
+{
+    return runStatement(QLatin1String("selectList"), "SESSION_SELECT_LIST_ERROR", statement.id(), parameters, [&]() {
+        checkClosed();
+        executeQueuedBatches();
+        const CompiledStatement& compiled = compiledStatement(statement);
+        return m_executor->queryListWithCache(compiled, parameters, withSessionOptions(compiled.options));
+    });
+}
+
+int Session::insert(const StatementHandle& statement, const QVariantMap& parameters)
+{
+    return runStatement(QLatin1String("insert"), "SESSION_INSERT_ERROR", statement.id(), parameters, [&]() {
+        checkClosed();
+        clearLoaders();
+        const CompiledStatement& compiled = compiledStatement(statement);
+        if (m_executorType == ExecutorType::Batch) {
+            return queueStatement(compiled.id, compiled.config, parameters);
+        }
+        return m_executor->updateWithCacheInvalidation(compiled, parameters, withSessionOptions(compiled.options));
+    });
+}
+
+int Session::update(const StatementHandle& statement, const QVariantMap& parameters)
+{
+    return runStatement(QLatin1String("update"), "SESSION_UPDATE_ERROR", statement.id(), parameters, [&]() {
+        checkClosed();
+        clearLoaders();
+        const CompiledStatement& compiled = compiledStatement(statement);
+        if (m_executorType == ExecutorType::Batch) {
+            return queueStatement(compiled.id, compiled.config, parameters);
+        }
+        return m_executor->updateWithCacheInvalidation(compiled, parameters, withSessionOptions(compiled.options));
+    });
+}
+
+int Session::remove(const StatementHandle& statement, const QVariantMap& parameters)
+{
+    return runStatement(QLatin1String("remove"), "SESSION_REMOVE_ERROR", statement.id(), parameters, [&]() {
+        checkClosed();
+        clearLoaders();
+        const CompiledStatement& compiled = compiledStatement(statement);
+        if (m_executorType == ExecutorType::Batch) {
+            return queueStatement(compiled.id, compiled.config, parameters);
+        }
+        return m_executor->updateWithCacheInvalidation(compiled, parameters, withSessionOptions(compiled.options));
+    });
+}
+
 int Session::execute(const QString& sql, const QVariantMap& parameters)
 {
     try {
         checkClosed();
+        clearLoaders();
+        executeQueuedBatches();
         return m_executor->update(sql, parameters);
     } catch (const SessionException& e) {
         SessionException ex(e);
@@ -260,7 +868,7 @@ int Session::execute(const QString& sql, const QVariantMap& parameters)
         throw ex;
     } catch (const std::exception& e) {
         SessionException ex(
-            QLatin1String("Unexpected error in execute: %1") + QString::fromUtf8(e.what()),
+            QStringLiteral("Unexpected error in execute: %1").arg(QString::fromUtf8(e.what())),
             "SESSION_UNEXPECTED_ERROR"
         );
         QVariantMap context;
@@ -300,7 +908,7 @@ void Session::beginTransaction(int timeoutSeconds)
         
         if (!m_connection->transaction()) {
             TransactionException ex(
-                QLatin1String("Failed to begin transaction: %1") +(m_connection->lastError().text()),
+                QStringLiteral("Failed to begin transaction: %1").arg(m_connection->lastError().text()),
                 "TRANSACTION_BEGIN_FAILED"
             );
             QVariantMap context;
@@ -338,7 +946,7 @@ void Session::beginTransaction(int timeoutSeconds)
         throw ex;
     } catch (const QtMyBatisException& e) {
         TransactionException ex(
-            QLatin1String("Failed to begin transaction: %1") +(e.message()),
+            QStringLiteral("Failed to begin transaction: %1").arg(e.message()),
             "TRANSACTION_BEGIN_ERROR"
         );
         QVariantMap context;
@@ -350,7 +958,7 @@ void Session::beginTransaction(int timeoutSeconds)
         throw ex;
     } catch (const std::exception& e) {
         TransactionException ex(
-            QLatin1String("Unexpected error beginning transaction: %1") +(e.what()),
+            QStringLiteral("Unexpected error beginning transaction: %1").arg(QString::fromUtf8(e.what())),
             "TRANSACTION_UNEXPECTED_ERROR"
         );
         QVariantMap context;
@@ -368,6 +976,14 @@ void Session::commit()
         checkClosed();
         checkTransactionTimeout();
         
+        // BATCH模式：先执行排队的写操作；没有外层事务时队列在自己的事务中提交
+        if (!m_batchQueue.isEmpty()) {
+            executeQueuedBatches();
+            if (!m_inTransaction) {
+                return;
+            }
+        }
+        
         if (!m_inTransaction) {
             TransactionException ex("No active transaction to commit", "TRANSACTION_NOT_ACTIVE");
             ex.setContext(QStringLiteral("transactionLevel"), getTransactionLevel());
@@ -397,7 +1013,7 @@ void Session::commit()
         
         if (!m_connection->commit()) {
             TransactionException ex(
-                QLatin1String("Failed to commit transaction: %1") +(m_connection->lastError().text()),
+                QStringLiteral("Failed to commit transaction: %1").arg(m_connection->lastError().text()),
                 "TRANSACTION_COMMIT_FAILED"
             );
             QVariantMap context;
@@ -428,7 +1044,7 @@ void Session::commit()
         throw ex;
     } catch (const QtMyBatisException& e) {
         TransactionException ex(
-            QLatin1String("Failed to commit transaction: %1") +(e.message()),
+            QStringLiteral("Failed to commit transaction: %1").arg(e.message()),
             "TRANSACTION_COMMIT_ERROR"
         );
         ex.setContext(QLatin1String("operation"), QLatin1String("commit"));
@@ -437,7 +1053,7 @@ void Session::commit()
         throw ex;
     } catch (const std::exception& e) {
         TransactionException ex(
-            QLatin1String("Unexpected error committing transaction: %1") +(e.what()),
+            QStringLiteral("Unexpected error committing transaction: %1").arg(QString::fromUtf8(e.what())),
             "TRANSACTION_UNEXPECTED_ERROR"
         );
         ex.setContext(QLatin1String("operation"), QLatin1String("commit"));
@@ -450,6 +1066,8 @@ void Session::rollback()
 {
     try {
         checkClosed();
+        discardQueuedBatches();
+        clearLoaders();
         
         if (!m_inTransaction) {
             return; // 没有活动事务，静默返回
@@ -467,7 +1085,7 @@ void Session::rollback()
         
         if (!m_connection->rollback()) {
             TransactionException ex(
-                QLatin1String("Failed to rollback transaction: %1") +(m_connection->lastError().text()),
+                QStringLiteral("Failed to rollback transaction: %1").arg(m_connection->lastError().text()),
                 "TRANSACTION_ROLLBACK_FAILED"
             );
             ex.setContext(QStringLiteral("sqlError"), m_connection->lastError().text());
@@ -495,7 +1113,7 @@ void Session::rollback()
         throw ex;
     } catch (const QtMyBatisException& e) {
         TransactionException ex(
-            QLatin1String("Failed to rollback transaction: %1") +(e.message()),
+            QStringLiteral("Failed to rollback transaction: %1").arg(e.message()),
             "TRANSACTION_ROLLBACK_ERROR"
         );
         ex.setContext(QLatin1String("operation"), QLatin1String("rollback"));
@@ -504,7 +1122,7 @@ void Session::rollback()
         throw ex;
     } catch (const std::exception& e) {
         TransactionException ex(
-            QLatin1String("Unexpected error rolling back transaction: %1") +(e.what()),
+            QStringLiteral("Unexpected error rolling back transaction: %1").arg(QString::fromUtf8(e.what())),
             "TRANSACTION_UNEXPECTED_ERROR"
         );
         ex.setContext(QLatin1String("operation"), QLatin1String("rollback"));
@@ -521,6 +1139,11 @@ bool Session::isInTransaction() const
 void Session::close()
 {
     if (!m_closed) {
+        if (!m_batchQueue.isEmpty()) {
+            qWarning() << "[Session] Closing with" << m_batchQueuedRows
+                       << "queued batch rows that were never flushed, discarding them";
+            discardQueuedBatches();
+        }
         if (m_inTransaction) {
             rollback();
         }
@@ -549,16 +1172,22 @@ bool Session::isDebugMode() const
 }
 
 QString Session::getStatementSql(const QString& statementId)
+{
+    return getStatementConfig(statementId).sql;
+}
+
+StatementConfig Session::getStatementConfig(const QString& statementId)
 {
     // 使用静态缓存存储频繁访问的语句
     static QMutex cacheMutex;
-    static QHash<QString, QString> sqlCache;
+    static QHash<QString, StatementConfig> statementCache;
     
     // 首先检查缓存
     {
         QMutexLocker locker(&cacheMutex);
-        if (sqlCache.contains(statementId)) {
-            return sqlCache[statementId];
+        auto it = statementCache.constFind(statementId);
+        if (it != statementCache.constEnd()) {
+            return it.value();
         }
     }
     
@@ -566,53 +1195,42 @@ QString Session::getStatementSql(const QString& statementId)
         throw MappingException(QLatin1String("MapperRegistry is not available"));
     }
     
-    // 更高效的字符串解析
-    int dotPos = statementId.indexOf(QLatin1Char('.'));
-    if (dotPos <= 0 || dotPos == statementId.length() - 1) {
-        throw MappingException(
-            QStringLiteral("Invalid statement ID format: %1. Expected format: namespace.statementId")
-            .arg(statementId)
-        );
-    }
-    
-    QString mapperName = statementId.left(dotPos);
-    QString stmtId = statementId.mid(dotPos + 1);
-    
-    if (!m_mapperRegistry->hasMapper(mapperName)) {
-        throw MappingException(
-            QLatin1String("Mapper not found: %1") +(mapperName)
-        );
-    }
-    
-    MapperConfig config = m_mapperRegistry->getMapperConfig(mapperName);
-    
-    // 获取SQL语句
-    QString result;
-    QString fullStatementId = QStringLiteral("%1.%2").arg(mapperName, stmtId);
-    
-    if (config.statements.contains(fullStatementId)) {
-        result = config.statements[fullStatementId].sql;
-    } else if (config.statements.contains(stmtId)) {
-        result = config.statements[stmtId].sql;
-    } else {
-        throw MappingException(
-            QStringLiteral("Statement not found: %1 in mapper: %2")
-            .arg(stmtId).arg(mapperName)
-        );
-    }
+    const StatementConfig result = m_mapperRegistry->resolveStatement(statementId);
     
     // 缓存结果
     {
         QMutexLocker locker(&cacheMutex);
-        if (sqlCache.size() > 1000) { // 防止无限增长
-            sqlCache.clear();
+        if (statementCache.size() > 1000) { // 防止无限增长
+            statementCache.clear();
         }
-        sqlCache[statementId] = result;
+        statementCache[statementId] = result;
     }
     
     return result;
 }
 
+StatementOptions Session::statementOptions(const StatementConfig& statement) const
+{
+    return withSessionOptions(statement.options());
+}
+
+StatementOptions Session::withSessionOptions(StatementOptions options) const
+{
+    // 会话级超时覆盖语句的timeout属性，取消令牌附加到每条语句
+    options.callTimeoutMs = m_queryTimeoutMs;
+    options.cancellation = m_cancellationToken;
+    return options;
+}
+
+const CompiledStatement& Session::compiledStatement(const StatementHandle& statement) const
+{
+    const CompiledStatement* compiled = statement.compiled();
+    if (!compiled) {
+        throw MappingException(QLatin1String("Statement handle is not valid"));
+    }
+    return *compiled;
+}
+
 // 嵌套事务支持 (保存点)
 QString Session::setSavepoint(const QString& savepointName)
 {
@@ -627,6 +1245,9 @@ QString Session::setSavepoint(const QString& savepointName)
         throw SqlExecutionException(QLatin1String("Database connection is not available"));
     }
     
+    // 排队的写操作属于保存点之前
+    executeQueuedBatches();
+    
     QString actualSavepointName = savepointName.isEmpty() ? generateSavepointName() : savepointName;
     
     // 检查是否已经有这个保存点
@@ -635,7 +1256,7 @@ QString Session::setSavepoint(const QString& savepointName)
     }
     
     QSqlQuery query(*m_connection);
-    QString sql = QLatin1String("SAVEPOINT %1") +(actualSavepointName);
+    QString sql = QStringLiteral("SAVEPOINT %1").arg(actualSavepointName);
     
     if (!query.exec(sql)) {
         throw SqlExecutionException(
@@ -662,14 +1283,19 @@ void Session::rollbackToSavepoint(const QString& savepointName)
         throw SqlExecutionException(QLatin1String("Database connection is not available"));
     }
     
+    // 设置保存点时队列已清空，排队中的写操作都在最近的保存点之后
+    discardQueuedBatches();
+    // 记忆的结果可能读到了被撤销的写操作
+    clearLoaders();
+    
     if (!m_savepointStack.contains(savepointName)) {
         throw SqlExecutionException(
-            QLatin1String("Savepoint '%1' not found") +(savepointName)
+            QStringLiteral("Savepoint '%1' not found").arg(savepointName)
         );
     }
     
     QSqlQuery query(*m_connection);
-    QString sql = QLatin1String("ROLLBACK TO SAVEPOINT %1") +(savepointName);
+    QString sql = QStringLiteral("ROLLBACK TO SAVEPOINT %1").arg(savepointName);
     
     if (!query.exec(sql)) {
         throw SqlExecutionException(
@@ -700,12 +1326,12 @@ void Session::releaseSavepoint(const QString& savepointName)
     
     if (!m_savepointStack.contains(savepointName)) {
         throw SqlExecutionException(
-            QLatin1String("Savepoint '%1' not found") +(savepointName)
+            QStringLiteral("Savepoint '%1' not found").arg(savepointName)
         );
     }
     
     QSqlQuery query(*m_connection);
-    QString sql = QLatin1String("RELEASE SAVEPOINT %1") +(savepointName);
+    QString sql = QStringLiteral("RELEASE SAVEPOINT %1").arg(savepointName);
     
     if (!query.exec(sql)) {
         throw SqlExecutionException(
@@ -806,11 +1432,20 @@ void Session::checkClosed()
     }
 }
 
-int Session::batchInsert(const QString& statementId, const QList<QVariantMap>& parametersList)
+int Session::batchInsert(const QString& statementId, const QList<QVariantMap>& parametersList,
+                         BatchStrategy strategy)
+{
+    return batchInsertWithResult(statementId, parametersList, strategy).totalAffected;
+}
+
+BatchResult Session::batchInsertWithResult(const QString& statementId, const QList<QVariantMap>& parametersList,
+                                           BatchStrategy strategy)
 {
     try {
         checkClosed();
-        QString sql = getStatementSql(statementId);
+        clearLoaders();
+        executeQueuedBatches();
+        const StatementConfig statement = getStatementConfig(statementId);
         
         // 开始事务进行批量操作
         bool wasInTransaction = m_inTransaction;
@@ -818,11 +1453,15 @@ int Session::batchInsert(const QString& statementId, const QList<QVariantMap>& p
             beginTransaction();
         }
         
-        int totalAffected = 0;
+        BatchResult result;
         try {
-            for (const QVariantMap& parameters : parametersList) {
-                totalAffected += m_executor->updateWithCacheInvalidation(statementId, sql, parameters);
-            }
+            // 按所选策略执行：execBatch或分块多行VALUES，缓存只失效一次；
+            // useGeneratedKeys的语句同时取回每行的生成键
+            result = statement.useGeneratedKeys
+                ? m_executor->insertBatchWithKeys(statementId, statement.sql, parametersList, strategy,
+                                                  statement.generatedKeyColumn(), statementOptions(statement))
+                : m_executor->updateBatch(statementId, statement.sql, parametersList, strategy,
+                                          statementOptions(statement));
             
             // 如果是我们开始的事务，则提交
             if (!wasInTransaction) {
@@ -836,7 +1475,9 @@ int Session::batchInsert(const QString& statementId, const QList<QVariantMap>& p
             throw;
         }
         
-        return totalAffected;
+        return result;
+    } catch (const TimeoutException&) {
+        throw; // 超时与取消保持原异常类型
     } catch (const SessionException& e) {
         SessionException ex(e);
         ex.setContext(QLatin1String("operation"), QLatin1String("batchInsert"));
@@ -856,7 +1497,7 @@ int Session::batchInsert(const QString& statementId, const QList<QVariantMap>& p
         throw ex;
     } catch (const std::exception& e) {
         SessionException ex(
-            QLatin1String("Unexpected error in batch insert: %1") +(e.what()),
+            QStringLiteral("Unexpected error in batch insert: %1").arg(QString::fromUtf8(e.what())),
             "SESSION_UNEXPECTED_ERROR"
         );
         ex.setContext(QLatin1String("operation"), QLatin1String("batchInsert"));
@@ -871,7 +1512,9 @@ int Session::batchUpdate(const QString& statementId, const QList<QVariantMap>& p
 {
     try {
         checkClosed();
-        QString sql = getStatementSql(statementId);
+        clearLoaders();
+        executeQueuedBatches();
+        const StatementConfig statement = getStatementConfig(statementId);
         
         // 开始事务进行批量操作
         bool wasInTransaction = m_inTransaction;
@@ -881,9 +1524,10 @@ int Session::batchUpdate(const QString& statementId, const QList<QVariantMap>& p
         
         int totalAffected = 0;
         try {
-            for (const QVariantMap& parameters : parametersList) {
-                totalAffected += m_executor->updateWithCacheInvalidation(statementId, sql, parameters);
-            }
+            // 整批预编译一次、按列绑定执行，缓存只失效一次
+            totalAffected = m_executor->updateBatch(statementId, statement.sql, parametersList,
+                                                    BatchStrategy::ExecBatch,
+                                                    statementOptions(statement)).totalAffected;
             
             // 如果是我们开始的事务，则提交
             if (!wasInTransaction) {
@@ -898,6 +1542,8 @@ int Session::batchUpdate(const QString& statementId, const QList<QVariantMap>& p
         }
         
         return totalAffected;
+    } catch (const TimeoutException&) {
+        throw; // 超时与取消保持原异常类型
     } catch (const SessionException& e) {
         SessionException ex(e);
         ex.setContext(QLatin1String("operation"), QLatin1String("batchUpdate"));
@@ -917,7 +1563,7 @@ int Session::batchUpdate(const QString& statementId, const QList<QVariantMap>& p
         throw ex;
     } catch (const std::exception& e) {
         SessionException ex(
-            QLatin1String("Unexpected error in batch update: %1") +(e.what()),
+            QStringLiteral("Unexpected error in batch update: %1").arg(QString::fromUtf8(e.what())),
             "SESSION_UNEXPECTED_ERROR"
         );
         ex.setContext(QLatin1String("operation"), QLatin1String("batchUpdate"));
@@ -932,7 +1578,9 @@ int Session::batchRemove(const QString& statementId, const QList<QVariantMap>& p
 {
     try {
         checkClosed();
-        QString sql = getStatementSql(statementId);
+        clearLoaders();
+        executeQueuedBatches();
+        const StatementConfig statement = getStatementConfig(statementId);
         
         // 开始事务进行批量操作
         bool wasInTransaction = m_inTransaction;
@@ -942,9 +1590,10 @@ int Session::batchRemove(const QString& statementId, const QList<QVariantMap>& p
         
         int totalAffected = 0;
         try {
-            for (const QVariantMap& parameters : parametersList) {
-                totalAffected += m_executor->updateWithCacheInvalidation(statementId, sql, parameters);
-            }
+            // 整批预编译一次、按列绑定执行，缓存只失效一次
+            totalAffected = m_executor->updateBatch(statementId, statement.sql, parametersList,
+                                                    BatchStrategy::ExecBatch,
+                                                    statementOptions(statement)).totalAffected;
             
             // 如果是我们开始的事务，则提交
             if (!wasInTransaction) {
@@ -959,6 +1608,8 @@ int Session::batchRemove(const QString& statementId, const QList<QVariantMap>& p
         }
         
         return totalAffected;
+    } catch (const TimeoutException&) {
+        throw; // 超时与取消保持原异常类型
     } catch (const SessionException& e) {
         SessionException ex(e);
         ex.setContext(QLatin1String("operation"), QLatin1String("batchRemove"));
@@ -978,7 +1629,7 @@ int Session::batchRemove(const QString& statementId, const QList<QVariantMap>& p
         throw ex;
     } catch (const std::exception& e) {
         SessionException ex(
-            QLatin1String("Unexpected error in batch remove: %1") +(e.what()),
+            QStringLiteral("Unexpected error in batch remove: %1").arg(QString::fromUtf8(e.what())),
             "SESSION_UNEXPECTED_ERROR"
         );
         ex.setContext(QLatin1String("operation"), QLatin1String("batchRemove"));
@@ -989,4 +1640,80 @@ int Session::batchRemove(const QString& statementId, const QList<QVariantMap>& p
     }
 }
 
+int Session::batchUpsert(const QString& statementId, const QList<QVariantMap>& rows,
+                         const QStringList& conflictKeys, BatchStrategy strategy)
+{
+    try {
+        checkClosed();
+        clearLoaders();
+        executeQueuedBatches();
+        
+        if (conflictKeys.isEmpty()) {
+            throw SessionException(
+                QStringLiteral("batchUpsert requires at least one conflict key"),
+                "SESSION_BATCH_UPSERT_ERROR"
+            );
+        }
+        
+        const StatementConfig statement = getStatementConfig(statementId);
+        
+        // 开始事务进行批量操作
+        bool wasInTransaction = m_inTransaction;
+        if (!wasInTransaction) {
+            beginTransaction();
+        }
+        
+        int totalAffected = 0;
+        try {
+            // 插入语句改写为方言的upsert后走批量路径，缓存只失效一次
+            totalAffected = m_executor->upsertBatch(statementId, statement.sql, rows, conflictKeys, strategy,
+                                                    statementOptions(statement)).totalAffected;
+            
+            // 如果是我们开始的事务，则提交
+            if (!wasInTransaction) {
+                commit();
+            }
+        } catch (...) {
+            // 如果是我们开始的事务，则回滚
+            if (!wasInTransaction) {
+                rollback();
+            }
+            throw;
+        }
+        
+        return totalAffected;
+    } catch (const TimeoutException&) {
+        throw; // 超时与取消保持原异常类型
+    } catch (const SessionException& e) {
+        SessionException ex(e);
+        ex.setContext(QLatin1String("operation"), QLatin1String("batchUpsert"));
+        ex.setContext(QStringLiteral("statementId"), statementId);
+        ex.setContext(QStringLiteral("batchSize"), rows.size());
+        ex.setContext(QStringLiteral("conflictKeys"), conflictKeys);
+        throw ex;
+    } catch (const QtMyBatisException& e) {
+        SessionException ex(
+            QStringLiteral("Failed to execute batch upsert: %1").arg(e.message()),
+            "SESSION_BATCH_UPSERT_ERROR"
+        );
+        ex.setContext(QLatin1String("operation"), QLatin1String("batchUpsert"));
+        ex.setContext(QStringLiteral("statementId"), statementId);
+        ex.setContext(QStringLiteral("batchSize"), rows.size());
+        ex.setContext(QStringLiteral("conflictKeys"), conflictKeys);
+        ex.setContext(QStringLiteral("originalError"), e.message());
+        ex.setContext(QStringLiteral("originalCode"), e.code());
+        throw ex;
+    } catch (const std::exception& e) {
+        SessionException ex(
+            QStringLiteral("Unexpected error in batch upsert: %1").arg(QString::fromUtf8(e.what())),
+            "SESSION_UNEXPECTED_ERROR"
+        );
+        ex.setContext(QLatin1String("operation"), QLatin1String("batchUpsert"));
+        ex.setContext(QStringLiteral("statementId"), statementId);
+        ex.setContext(QStringLiteral("batchSize"), rows.size());
+        ex.setContext(QLatin1String("stdError"), QString::fromUtf8(e.what()));
+        throw ex;
+    }
+}
+
 } // namespace QtMyBatisORM
\ No newline at end of file
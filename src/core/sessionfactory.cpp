@@ -5,7 +5,9 @@
 #include "QtMyBatisORM/cachemanager.h"
 #include "QtMyBatisORM/configurationmanager.h"
 #include "QtMyBatisORM/executor.h"
+#include "QtMyBatisORM/asyncexecutor.h"
 #include "QtMyBatisORM/qtmybatisexception.h"
+#include <exception>
 
 namespace QtMyBatisORM {
 
@@ -32,6 +34,10 @@ void SessionFactory::initialize()
     ConfigurationManager* configMgr = ConfigurationManager::instance();
     QList<MapperConfig> mappers = configMgr->getMapperConfigs();
     m_mapperRegistry->registerMappers(mappers);
+    
+    // 工作线程在第一次异步调用时才启动
+    m_asyncExecutor = QSharedPointer<AsyncExecutor>::create(
+        m_connectionPool, m_cacheManager, m_mapperRegistry, m_config.asyncWorkerCount);
 }
 
 QSharedPointer<Session> SessionFactory::openSession()
@@ -53,6 +59,8 @@ QSharedPointer<Session> SessionFactory::openSession()
         
         // 创建Executor
         QSharedPointer<Executor> executor = QSharedPointer<Executor>::create(connection, m_cacheManager);
+        executor->setPreparedStatementCache(m_connectionPool->getPreparedStatementCache(connection));
+        executor->setInterceptors(m_interceptors);
         
         // 创建Session
         QSharedPointer<Session> session = QSharedPointer<Session>::create(
@@ -79,6 +87,13 @@ QSharedPointer<Session> SessionFactory::openSession()
     }
 }
 
+QSharedPointer<Session> SessionFactory::openSession(ExecutorType type)
+{
+    QSharedPointer<Session> session = openSession();
+    session->setExecutorType(type);
+    return session;
+}
+
 void SessionFactory::closeSession(QSharedPointer<Session> session)
 {
     if (session) {
@@ -90,9 +105,146 @@ void SessionFactory::closeSession(QSharedPointer<Session> session)
     }
 }
 
+QFuture<QVariant> SessionFactory::selectOneAsync(const QString& statementId, const QVariantMap& parameters)
+{
+    if (m_closed) {
+        throw ConfigurationException(QLatin1String("SessionFactory is closed"));
+    }
+    
+    return m_asyncExecutor->submit<QVariant>([statementId, parameters](Session& session) {
+        return session.selectOne(statementId, parameters);
+    });
+}
+
+QFuture<QVariantList> SessionFactory::selectListAsync(const QString& statementId, const QVariantMap& parameters)
+{
+    if (m_closed) {
+        throw ConfigurationException(QLatin1String("SessionFactory is closed"));
+    }
+    
+    return m_asyncExecutor->submit<QVariantList>([statementId, parameters](Session& session) {
+        return session.selectList(statementId, parameters);
+    });
+}
+
+QFuture<int> SessionFactory::updateAsync(const QString& statementId, const QVariantMap& parameters)
+{
+    if (m_closed) {
+        throw ConfigurationException(QLatin1String("SessionFactory is closed"));
+    }
+    
+    return m_asyncExecutor->submit<int>([statementId, parameters](Session& session) {
+        return session.update(statementId, parameters);
+    });
+}
+
+QFuture<int> SessionFactory::batchInsertAsync(const QString& statementId, const QList<QVariantMap>& parametersList,
+                                              BatchStrategy strategy)
+{
+    if (m_closed) {
+        throw ConfigurationException(QLatin1String("SessionFactory is closed"));
+    }
+    
+    return m_asyncExecutor->submit<int>([statementId, parametersList, strategy](Session& session) {
+        return session.batchInsert(statementId, parametersList, strategy);
+    });
+}
+
+QList<QVariantList> SessionFactory::executeParallel(const QList<ParallelStatement>& statements, int maxParallelism)
+{
+    if (m_closed) {
+        throw ConfigurationException(QLatin1String("SessionFactory is closed"));
+    }
+    
+    if (statements.isEmpty()) {
+        return {};
+    }
+    
+    // 每个工作线程独占一个连接，扩容不能超过连接池剩余的容量；
+    // 扩容出的工作线程在队列清空后退出并归还连接
+    int parallelism = maxParallelism > 0 ? maxParallelism : m_config.maxConnections;
+    parallelism = qMin(parallelism, int(statements.size()));
+    m_asyncExecutor->ensureWorkers(
+        qMin(parallelism, m_asyncExecutor->workerCount() + m_connectionPool->spareConnections()));
+    
+    QList<QFuture<QVariantList>> futures;
+    futures.reserve(statements.size());
+    for (const ParallelStatement& statement : statements) {
+        const QString statementId = statement.statementId;
+        const QVariantMap parameters = statement.parameters;
+        futures.append(m_asyncExecutor->submit<QVariantList>([statementId, parameters](Session& session) {
+            return session.selectList(statementId, parameters);
+        }));
+    }
+    
+    // 等待全部完成后再抛出第一个错误，避免仍有语句在后台运行
+    QList<QVariantList> results;
+    results.reserve(futures.size());
+    std::exception_ptr firstError;
+    for (QFuture<QVariantList>& future : futures) {
+        try {
+            results.append(future.result());
+        } catch (...) {
+            if (!firstError) {
+                firstError = std::current_exception();
+            }
+        }
+    }
+    
+    if (firstError) {
+        std::rethrow_exception(firstError);
+    }
+    
+    return results;
+}
+
+QVariantList SessionFactory::selectByKeys(const QString& statementId, const QString& keyParam,
+                                         const QVariantList& keys, const QVariantMap& parameters,
+                                         int maxParallelism)
+{
+    if (m_closed) {
+        throw ConfigurationException(QLatin1String("SessionFactory is closed"));
+    }
+    
+    // 分块规则取决于驱动的绑定变量上限，与Session::selectByKeys一致
+    QList<QVariantList> chunks;
+    {
+        QSharedPointer<Session> session = openSession();
+        try {
+            chunks = session->splitKeys(keys, parameters.size());
+        } catch (...) {
+            closeSession(session);
+            throw;
+        }
+        closeSession(session);
+    }
+    
+    QList<ParallelStatement> statements;
+    statements.reserve(chunks.size());
+    for (const QVariantList& chunk : chunks) {
+        ParallelStatement statement;
+        statement.statementId = statementId;
+        statement.parameters = parameters;
+        statement.parameters.insert(keyParam, chunk);
+        statements.append(statement);
+    }
+    
+    QVariantList rows;
+    const QList<QVariantList> results = executeParallel(statements, maxParallelism);
+    for (const QVariantList& result : results) {
+        rows.append(result);
+    }
+    return rows;
+}
+
 void SessionFactory::close()
 {
     if (!m_closed) {
+        // 先停止异步工作线程，它们在各自线程中归还独占的连接
+        if (m_asyncExecutor) {
+            m_asyncExecutor->shutdown();
+        }
+        
         // 关闭所有活动的Session
         QSet<QObject*> sessionsToClose = m_activeSessions;
         for (QObject* sessionObj : sessionsToClose) {
@@ -112,11 +264,47 @@ void SessionFactory::close()
         m_mapperRegistry.reset();
         m_cacheManager.reset();
         m_connectionPool.reset();
+        m_asyncExecutor.reset();
         
         m_closed = true;
     }
 }
 
+QSharedPointer<AsyncExecutor> SessionFactory::asyncExecutor() const
+{
+    if (m_closed) {
+        throw ConfigurationException(QLatin1String("SessionFactory is closed"));
+    }
+    
+    return m_asyncExecutor;
+}
+
+void SessionFactory::addInterceptor(QSharedPointer<Interceptor> interceptor)
+{
+    if (!interceptor) {
+        throw ConfigurationException(QLatin1String("Interceptor must not be null"));
+    }
+    
+    m_interceptors.append(interceptor);
+    if (m_asyncExecutor) {
+        m_asyncExecutor->setInterceptors(m_interceptors);
+    }
+}
+
+InterceptorChain SessionFactory::interceptors() const
+{
+    return m_interceptors;
+}
+
+StatementHandle SessionFactory::statement(const QString& statementId) const
+{
+    if (!m_mapperRegistry) {
+        throw MappingException(QLatin1String("MapperRegistry is not available"));
+    }
+    
+    return m_mapperRegistry->statement(statementId);
+}
+
 bool SessionFactory::isClosed() const
 {
     return m_closed;
@@ -127,4 +315,9 @@ int SessionFactory::getActiveSessionCount() const
     return m_activeSessions.size();
 }
 
+PreparedStatementStats SessionFactory::getPreparedStatementStats() const
+{
+    return m_connectionPool ? m_connectionPool->getPreparedStatementStats() : PreparedStatementStats();
+}
+
 } // namespace QtMyBatisORM
\ No newline at end of file
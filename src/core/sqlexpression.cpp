@@ -0,0 +1,652 @@
+#include "QtMyBatisORM/sqlexpression.h"
+#include "QtMyBatisORM/sqlnode.h"
+#include "QtMyBatisORM/qtmybatisexception.h"
+#include <QMetaProperty>
+#include <QObject>
+#include <QVector>
+
+namespace QtMyBatisORM {
+
+class SqlExpression::Node
+{
+public:
+    virtual ~Node() = default;
+    virtual QVariant evaluate(const DynamicContext& context) const = 0;
+};
+
+namespace {
+
+using NodePtr = QSharedPointer<const SqlExpression::Node>;
+
+bool isNull(const QVariant& value)
+{
+    return !value.isValid() || value.isNull();
+}
+
+bool isNumber(const QVariant& value)
+{
+    switch (value.typeId()) {
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::LongLong:
+    case QMetaType::ULongLong:
+    case QMetaType::Long:
+    case QMetaType::ULong:
+    case QMetaType::Short:
+    case QMetaType::UShort:
+    case QMetaType::Double:
+    case QMetaType::Float:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool isIntegral(const QVariant& value)
+{
+    return isNumber(value) && value.typeId() != QMetaType::Double && value.typeId() != QMetaType::Float;
+}
+
+bool isString(const QVariant& value)
+{
+    return value.typeId() == QMetaType::QString || value.typeId() == QMetaType::QByteArray
+        || value.typeId() == QMetaType::QChar;
+}
+
+// OGNL的真值规则：null为假，数字非零为真，其他非null值为真
+bool toBoolean(const QVariant& value)
+{
+    if (isNull(value)) {
+        return false;
+    }
+    if (value.typeId() == QMetaType::Bool) {
+        return value.toBool();
+    }
+    if (isNumber(value)) {
+        return value.toDouble() != 0.0;
+    }
+    return true;
+}
+
+// 比较两个值：返回<0、0、>0；无法比较时ok为false
+int compareValues(const QVariant& lhs, const QVariant& rhs, bool& ok)
+{
+    ok = true;
+
+    if (lhs.typeId() == QMetaType::Bool || rhs.typeId() == QMetaType::Bool) {
+        if (isString(lhs) || isString(rhs)) {
+            const QString text = (isString(lhs) ? lhs : rhs).toString();
+            if (text != QLatin1String("true") && text != QLatin1String("false")) {
+                ok = false;
+                return 0;
+            }
+        }
+        return int(lhs.toBool()) - int(rhs.toBool());
+    }
+
+    // 数字与数字、或数字与可转换为数字的字符串按数值比较
+    if (isNumber(lhs) || isNumber(rhs)) {
+        if (isIntegral(lhs) && isIntegral(rhs)) {
+            const qlonglong a = lhs.toLongLong();
+            const qlonglong b = rhs.toLongLong();
+            return a < b ? -1 : (a > b ? 1 : 0);
+        }
+        bool lhsOk = false;
+        bool rhsOk = false;
+        const double a = lhs.toDouble(&lhsOk);
+        const double b = rhs.toDouble(&rhsOk);
+        if (lhsOk && rhsOk) {
+            return a < b ? -1 : (a > b ? 1 : 0);
+        }
+        ok = false;
+        return 0;
+    }
+
+    if (isString(lhs) || isString(rhs)) {
+        return lhs.toString().compare(rhs.toString());
+    }
+
+    const QPartialOrdering order = QVariant::compare(lhs, rhs);
+    if (order == QPartialOrdering::Less) {
+        return -1;
+    }
+    if (order == QPartialOrdering::Greater) {
+        return 1;
+    }
+    if (order == QPartialOrdering::Equivalent) {
+        return 0;
+    }
+    ok = false;
+    return 0;
+}
+
+qsizetype sizeOf(const QVariant& value)
+{
+    switch (value.typeId()) {
+    case QMetaType::QVariantList:
+        return value.toList().size();
+    case QMetaType::QStringList:
+        return value.toStringList().size();
+    case QMetaType::QVariantMap:
+        return value.toMap().size();
+    case QMetaType::QVariantHash:
+        return value.toHash().size();
+    case QMetaType::QByteArray:
+        return value.toByteArray().size();
+    default:
+        return value.toString().size();
+    }
+}
+
+QVariant readProperty(const QVariant& value, const QString& name)
+{
+    if (isNull(value)) {
+        return QVariant();
+    }
+
+    switch (value.typeId()) {
+    case QMetaType::QVariantMap: {
+        const QVariantMap map = value.toMap();
+        return map.value(name);
+    }
+    case QMetaType::QVariantHash: {
+        const QVariantHash hash = value.toHash();
+        return hash.value(name);
+    }
+    default:
+        break;
+    }
+
+    const QMetaType type = value.metaType();
+    if (type.flags() & QMetaType::PointerToQObject) {
+        const QObject* object = value.value<QObject*>();
+        return object ? object->property(name.toLatin1().constData()) : QVariant();
+    }
+
+    if (const QMetaObject* metaObject = type.metaObject()) {
+        const int index = metaObject->indexOfProperty(name.toLatin1().constData());
+        if (index >= 0) {
+            return metaObject->property(index).readOnGadget(value.constData());
+        }
+    }
+
+    return QVariant();
+}
+
+class LiteralNode : public SqlExpression::Node
+{
+public:
+    explicit LiteralNode(const QVariant& value) : m_value(value) {}
+
+    QVariant evaluate(const DynamicContext&) const override { return m_value; }
+
+private:
+    QVariant m_value;
+};
+
+class PathNode : public SqlExpression::Node
+{
+public:
+    enum class Step
+    {
+        Property,
+        Size,
+        IsEmpty,
+        Length,
+        Trim
+    };
+
+    struct Segment
+    {
+        Step step;
+        QString name;
+    };
+
+    PathNode(const QString& root, const QVector<Segment>& segments)
+        : m_root(root)
+        , m_segments(segments)
+    {
+    }
+
+    QVariant evaluate(const DynamicContext& context) const override
+    {
+        QVariant value;
+        if (!context.lookup(m_root, value)) {
+            value = QVariant();
+        }
+
+        for (const Segment& segment : m_segments) {
+            switch (segment.step) {
+            case Step::Property:
+                value = readProperty(value, segment.name);
+                break;
+            case Step::Size:
+            case Step::Length:
+                value = isNull(value) ? QVariant() : QVariant(qlonglong(sizeOf(value)));
+                break;
+            case Step::IsEmpty:
+                value = isNull(value) || sizeOf(value) == 0;
+                break;
+            case Step::Trim:
+                value = isNull(value) ? QVariant() : QVariant(value.toString().trimmed());
+                break;
+            }
+        }
+
+        return value;
+    }
+
+private:
+    QString m_root;
+    QVector<Segment> m_segments;
+};
+
+class NotNode : public SqlExpression::Node
+{
+public:
+    explicit NotNode(NodePtr operand) : m_operand(operand) {}
+
+    QVariant evaluate(const DynamicContext& context) const override
+    {
+        return !toBoolean(m_operand->evaluate(context));
+    }
+
+private:
+    NodePtr m_operand;
+};
+
+class LogicalNode : public SqlExpression::Node
+{
+public:
+    LogicalNode(bool isAnd, NodePtr lhs, NodePtr rhs)
+        : m_isAnd(isAnd)
+        , m_lhs(lhs)
+        , m_rhs(rhs)
+    {
+    }
+
+    QVariant evaluate(const DynamicContext& context) const override
+    {
+        const bool lhs = toBoolean(m_lhs->evaluate(context));
+        if (m_isAnd ? !lhs : lhs) {
+            return lhs;
+        }
+        return toBoolean(m_rhs->evaluate(context));
+    }
+
+private:
+    bool m_isAnd;
+    NodePtr m_lhs;
+    NodePtr m_rhs;
+};
+
+class CompareNode : public SqlExpression::Node
+{
+public:
+    enum class Op
+    {
+        Equal,
+        NotEqual,
+        Less,
+        LessEqual,
+        Greater,
+        GreaterEqual
+    };
+
+    CompareNode(Op op, NodePtr lhs, NodePtr rhs)
+        : m_op(op)
+        , m_lhs(lhs)
+        , m_rhs(rhs)
+    {
+    }
+
+    QVariant evaluate(const DynamicContext& context) const override
+    {
+        const QVariant lhs = m_lhs->evaluate(context);
+        const QVariant rhs = m_rhs->evaluate(context);
+
+        // null只与null相等，与其他值比较大小均为假
+        const bool lhsNull = isNull(lhs);
+        const bool rhsNull = isNull(rhs);
+        if (lhsNull || rhsNull) {
+            switch (m_op) {
+            case Op::Equal:
+                return lhsNull && rhsNull;
+            case Op::NotEqual:
+                return lhsNull != rhsNull;
+            default:
+                return false;
+            }
+        }
+
+        bool ok = false;
+        const int order = compareValues(lhs, rhs, ok);
+        switch (m_op) {
+        case Op::Equal:
+            return ok && order == 0;
+        case Op::NotEqual:
+            return !ok || order != 0;
+        case Op::Less:
+            return ok && order < 0;
+        case Op::LessEqual:
+            return ok && order <= 0;
+        case Op::Greater:
+            return ok && order > 0;
+        case Op::GreaterEqual:
+            return ok && order >= 0;
+        }
+        return false;
+    }
+
+private:
+    Op m_op;
+    NodePtr m_lhs;
+    NodePtr m_rhs;
+};
+
+/**
+ * Recursive descent parser:
+ *   or         := and (("or" | "||") and)*
+ *   and        := not (("and" | "&&") not)*
+ *   not        := ("not" | "!") not | comparison
+ *   comparison := primary (op primary)?
+ *   primary    := literal | path | "(" or ")"
+ *   path       := identifier ("." identifier ("()")?)*
+ */
+class ExpressionParser
+{
+public:
+    explicit ExpressionParser(const QString& text)
+        : m_text(text)
+    {
+        advance();
+    }
+
+    NodePtr parse()
+    {
+        if (m_token.type == Token::End) {
+            fail(QStringLiteral("empty expression"));
+        }
+        NodePtr root = parseOr();
+        if (m_token.type != Token::End) {
+            fail(QStringLiteral("unexpected '%1'").arg(m_token.text));
+        }
+        return root;
+    }
+
+private:
+    struct Token
+    {
+        enum Type
+        {
+            End,
+            Identifier,
+            Number,
+            String,
+            Symbol
+        };
+
+        Type type = End;
+        QString text;
+        QVariant value;
+        int position = 0;
+    };
+
+    [[noreturn]] void fail(const QString& reason) const
+    {
+        MappingException ex(QStringLiteral("Invalid test expression \"%1\": %2 at position %3")
+                            .arg(m_text, reason).arg(m_token.position), QStringLiteral("INVALID_TEST_EXPRESSION"));
+        ex.setContext(QStringLiteral("expression"), m_text);
+        throw ex;
+    }
+
+    void advance()
+    {
+        const int length = m_text.size();
+        while (m_pos < length && m_text.at(m_pos).isSpace()) {
+            ++m_pos;
+        }
+
+        m_token = Token();
+        m_token.position = m_pos;
+        if (m_pos >= length) {
+            return;
+        }
+
+        const QChar ch = m_text.at(m_pos);
+
+        if (ch.isLetter() || ch == QLatin1Char('_') || ch == QLatin1Char('$')) {
+            const int start = m_pos;
+            while (m_pos < length && (m_text.at(m_pos).isLetterOrNumber() || m_text.at(m_pos) == QLatin1Char('_')
+                                      || m_text.at(m_pos) == QLatin1Char('$'))) {
+                ++m_pos;
+            }
+            m_token.type = Token::Identifier;
+            m_token.text = m_text.mid(start, m_pos - start);
+            return;
+        }
+
+        if (ch.isDigit()) {
+            const int start = m_pos;
+            bool isDecimal = false;
+            while (m_pos < length && (m_text.at(m_pos).isDigit()
+                                      || (!isDecimal && m_text.at(m_pos) == QLatin1Char('.')
+                                          && m_pos + 1 < length && m_text.at(m_pos + 1).isDigit()))) {
+                isDecimal = isDecimal || m_text.at(m_pos) == QLatin1Char('.');
+                ++m_pos;
+            }
+            m_token.type = Token::Number;
+            m_token.text = m_text.mid(start, m_pos - start);
+            bool ok = false;
+            if (isDecimal) {
+                m_token.value = m_token.text.toDouble(&ok);
+            } else {
+                m_token.value = m_token.text.toLongLong(&ok);
+            }
+            if (!ok) {
+                fail(QStringLiteral("invalid number"));
+            }
+            return;
+        }
+
+        if (ch == QLatin1Char('\'') || ch == QLatin1Char('"')) {
+            QString value;
+            ++m_pos;
+            while (m_pos < length && m_text.at(m_pos) != ch) {
+                if (m_text.at(m_pos) == QLatin1Char('\\') && m_pos + 1 < length) {
+                    ++m_pos;
+                }
+                value += m_text.at(m_pos++);
+            }
+            if (m_pos >= length) {
+                fail(QStringLiteral("unterminated string"));
+            }
+            ++m_pos;
+            m_token.type = Token::String;
+            m_token.text = value;
+            m_token.value = value;
+            return;
+        }
+
+        static const char* const symbols[] = {"==", "!=", "<=", ">=", "&&", "||", "<", ">", "!", "(", ")", ".", "-"};
+        for (const char* symbol : symbols) {
+            const QLatin1String candidate(symbol);
+            if (QStringView(m_text).mid(m_pos).startsWith(candidate)) {
+                m_pos += candidate.size();
+                m_token.type = Token::Symbol;
+                m_token.text = candidate;
+                return;
+            }
+        }
+
+        fail(QStringLiteral("unexpected character '%1'").arg(ch));
+    }
+
+    bool acceptSymbol(const char* symbol)
+    {
+        if (m_token.type == Token::Symbol && m_token.text == QLatin1String(symbol)) {
+            advance();
+            return true;
+        }
+        return false;
+    }
+
+    bool acceptKeyword(const char* keyword)
+    {
+        if (m_token.type == Token::Identifier && m_token.text == QLatin1String(keyword)) {
+            advance();
+            return true;
+        }
+        return false;
+    }
+
+    NodePtr parseOr()
+    {
+        NodePtr lhs = parseAnd();
+        while (acceptKeyword("or") || acceptSymbol("||")) {
+            lhs = NodePtr(new LogicalNode(false, lhs, parseAnd()));
+        }
+        return lhs;
+    }
+
+    NodePtr parseAnd()
+    {
+        NodePtr lhs = parseNot();
+        while (acceptKeyword("and") || acceptSymbol("&&")) {
+            lhs = NodePtr(new LogicalNode(true, lhs, parseNot()));
+        }
+        return lhs;
+    }
+
+    NodePtr parseNot()
+    {
+        if (acceptKeyword("not") || acceptSymbol("!")) {
+            return NodePtr(new NotNode(parseNot()));
+        }
+        return parseComparison();
+    }
+
+    NodePtr parseComparison()
+    {
+        NodePtr lhs = parsePrimary();
+
+        CompareNode::Op op;
+        if (acceptSymbol("==") || acceptKeyword("eq")) {
+            op = CompareNode::Op::Equal;
+        } else if (acceptSymbol("!=") || acceptKeyword("neq")) {
+            op = CompareNode::Op::NotEqual;
+        } else if (acceptSymbol("<=") || acceptKeyword("lte")) {
+            op = CompareNode::Op::LessEqual;
+        } else if (acceptSymbol(">=") || acceptKeyword("gte")) {
+            op = CompareNode::Op::GreaterEqual;
+        } else if (acceptSymbol("<") || acceptKeyword("lt")) {
+            op = CompareNode::Op::Less;
+        } else if (acceptSymbol(">") || acceptKeyword("gt")) {
+            op = CompareNode::Op::Greater;
+        } else {
+            return lhs;
+        }
+
+        return NodePtr(new CompareNode(op, lhs, parsePrimary()));
+    }
+
+    NodePtr parsePrimary()
+    {
+        if (acceptSymbol("(")) {
+            NodePtr inner = parseOr();
+            if (!acceptSymbol(")")) {
+                fail(QStringLiteral("expected ')'"));
+            }
+            return inner;
+        }
+
+        if (m_token.type == Token::Number || m_token.type == Token::String) {
+            NodePtr literal(new LiteralNode(m_token.value));
+            advance();
+            return literal;
+        }
+
+        if (acceptSymbol("-")) {
+            if (m_token.type != Token::Number) {
+                fail(QStringLiteral("expected number after '-'"));
+            }
+            const QVariant value = m_token.value.typeId() == QMetaType::Double
+                ? QVariant(-m_token.value.toDouble()) : QVariant(-m_token.value.toLongLong());
+            advance();
+            return NodePtr(new LiteralNode(value));
+        }
+
+        if (m_token.type != Token::Identifier) {
+            fail(m_token.type == Token::End ? QStringLiteral("unexpected end of expression")
+                                            : QStringLiteral("unexpected '%1'").arg(m_token.text));
+        }
+
+        const QString name = m_token.text;
+        if (name == QLatin1String("null")) {
+            advance();
+            return NodePtr(new LiteralNode(QVariant()));
+        }
+        if (name == QLatin1String("true") || name == QLatin1String("false")) {
+            advance();
+            return NodePtr(new LiteralNode(name == QLatin1String("true")));
+        }
+        advance();
+
+        QVector<PathNode::Segment> segments;
+        while (acceptSymbol(".")) {
+            if (m_token.type != Token::Identifier) {
+                fail(QStringLiteral("expected property name"));
+            }
+            const QString member = m_token.text;
+            advance();
+
+            if (!acceptSymbol("(")) {
+                segments.append(PathNode::Segment{PathNode::Step::Property, member});
+                continue;
+            }
+            if (!acceptSymbol(")")) {
+                fail(QStringLiteral("method arguments are not supported"));
+            }
+
+            if (member == QLatin1String("size")) {
+                segments.append(PathNode::Segment{PathNode::Step::Size, member});
+            } else if (member == QLatin1String("isEmpty")) {
+                segments.append(PathNode::Segment{PathNode::Step::IsEmpty, member});
+            } else if (member == QLatin1String("length")) {
+                segments.append(PathNode::Segment{PathNode::Step::Length, member});
+            } else if (member == QLatin1String("trim")) {
+                segments.append(PathNode::Segment{PathNode::Step::Trim, member});
+            } else {
+                fail(QStringLiteral("unsupported method '%1()'").arg(member));
+            }
+        }
+
+        return NodePtr(new PathNode(name, segments));
+    }
+
+    const QString& m_text;
+    int m_pos = 0;
+    Token m_token;
+};
+
+} // namespace
+
+SqlExpression SqlExpression::parse(const QString& expression)
+{
+    SqlExpression result;
+    result.m_text = expression.trimmed();
+    result.m_root = ExpressionParser(result.m_text).parse();
+    return result;
+}
+
+bool SqlExpression::evaluate(const DynamicContext& context) const
+{
+    return m_root && toBoolean(m_root->evaluate(context));
+}
+
+QVariant SqlExpression::value(const DynamicContext& context) const
+{
+    return m_root ? m_root->evaluate(context) : QVariant();
+}
+
+} // namespace QtMyBatisORM
@@ -0,0 +1,741 @@
+#include "QtMyBatisORM/sqlnode.h"
+#include <QStringView>
+
+namespace QtMyBatisORM {
+
+namespace {
+
+bool isIdentifierChar(QChar c)
+{
+    return c.isLetterOrNumber() || c == QLatin1Char('_');
+}
+
+bool isTagNameChar(QChar c)
+{
+    return c >= QLatin1Char('a') && c <= QLatin1Char('z');
+}
+
+bool isKnownTag(QStringView name)
+{
+    return name == QLatin1String("if") || name == QLatin1String("choose")
+        || name == QLatin1String("when") || name == QLatin1String("otherwise")
+        || name == QLatin1String("foreach") || name == QLatin1String("where")
+        || name == QLatin1String("set") || name == QLatin1String("trim");
+}
+
+QString unescapeAttribute(const QString& value)
+{
+    if (!value.contains(QLatin1Char('&'))) {
+        return value;
+    }
+
+    QString result = value;
+    result.replace(QLatin1String("&quot;"), QLatin1String("\""));
+    result.replace(QLatin1String("&apos;"), QLatin1String("'"));
+    result.replace(QLatin1String("&lt;"), QLatin1String("<"));
+    result.replace(QLatin1String("&gt;"), QLatin1String(">"));
+    result.replace(QLatin1String("&amp;"), QLatin1String("&"));
+    return result;
+}
+
+// 占位符只能由QSqlResult识别的字符组成，集合路径中的其他字符（如 row.tags 的点）替换为下划线
+QString placeholderPrefix(const QString& collection)
+{
+    QString prefix = collection;
+    for (QChar& ch : prefix) {
+        const ushort u = ch.unicode();
+        if (!((u >= 'a' && u <= 'z') || (u >= 'A' && u <= 'Z') || (u >= '0' && u <= '9') || u == '_')) {
+            ch = QLatin1Char('_');
+        }
+    }
+    return prefix + QLatin1Char('_');
+}
+
+QStringList splitOverrides(const QString& overrides)
+{
+    // MyBatis风格：以 | 分隔，保留每项中的空白
+    QStringList result;
+    for (const QString& item : overrides.split(QLatin1Char('|'))) {
+        if (!item.isEmpty()) {
+            result.append(item);
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// DynamicContext
+
+DynamicContext::DynamicContext(const QVariantMap& parameters)
+    : m_parameters(parameters)
+{
+}
+
+DynamicContext DynamicContext::nested() const
+{
+    DynamicContext inner(m_parameters);
+    inner.m_items = m_items;
+    return inner;
+}
+
+void DynamicContext::bindItem(const QString& name, const QString& placeholder, const QVariant& value)
+{
+    m_items.append(ItemBinding{name, placeholder, value});
+}
+
+const QString* DynamicContext::itemPlaceholder(const QString& name) const
+{
+    for (auto it = m_items.crbegin(); it != m_items.crend(); ++it) {
+        if (it->name == name) {
+            return &it->placeholder;
+        }
+    }
+    return nullptr;
+}
+
+bool DynamicContext::lookup(const QString& name, QVariant& value) const
+{
+    for (auto it = m_items.crbegin(); it != m_items.crend(); ++it) {
+        if (it->name == name) {
+            value = it->value;
+            return true;
+        }
+    }
+
+    auto it = m_parameters.constFind(name);
+    if (it == m_parameters.constEnd()) {
+        return false;
+    }
+    value = it.value();
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// SqlShape
+
+void SqlShape::addFlag(bool taken)
+{
+    if (m_bitPos == 8) {
+        m_key.append('\0');
+        m_bitPos = 0;
+    }
+    if (taken) {
+        m_key.back() = char(m_key.back() | (1 << m_bitPos));
+    }
+    ++m_bitPos;
+}
+
+void SqlShape::addCount(qsizetype count)
+{
+    // 变长编码，每字节7位
+    quint64 value = quint64(count);
+    do {
+        char byte = char(value & 0x7f);
+        value >>= 7;
+        if (value) {
+            byte = char(byte | 0x80);
+        }
+        m_key.append(byte);
+    } while (value);
+    m_bitPos = 8;
+}
+
+// ---------------------------------------------------------------------------
+// TextSqlNode
+
+TextSqlNode::TextSqlNode(const QString& text)
+{
+    // 加载时拆分文本与 #{param} 引用，执行时无需再扫描
+    QString literal;
+    int pos = 0;
+    const int length = text.size();
+
+    while (pos < length) {
+        const int start = text.indexOf(QLatin1String("#{"), pos);
+        if (start < 0) {
+            literal += QStringView(text).mid(pos);
+            break;
+        }
+
+        int end = start + 2;
+        while (end < length && isIdentifierChar(text.at(end))) {
+            ++end;
+        }
+
+        if (end < length && end > start + 2 && text.at(end) == QLatin1Char('}')) {
+            literal += QStringView(text).mid(pos, start - pos);
+            if (!literal.isEmpty()) {
+                m_segments.append(Segment{literal, false});
+                literal.clear();
+            }
+            m_segments.append(Segment{text.mid(start + 2, end - start - 2), true});
+            m_hasParameters = true;
+            pos = end + 1;
+        } else {
+            // 不是合法的参数引用，按原文保留
+            literal += QStringView(text).mid(pos, start + 2 - pos);
+            pos = start + 2;
+        }
+    }
+
+    if (!literal.isEmpty()) {
+        m_segments.append(Segment{literal, false});
+    }
+}
+
+QStringList TextSqlNode::parameterReferences(const QString& text)
+{
+    // 与构造函数相同的拆分规则
+    QStringList names;
+    const TextSqlNode node(text);
+    for (const Segment& segment : node.m_segments) {
+        if (segment.isParameter && !names.contains(segment.text)) {
+            names.append(segment.text);
+        }
+    }
+    return names;
+}
+
+void TextSqlNode::apply(DynamicContext& context) const
+{
+    const QVariantMap& parameters = context.parameters();
+    for (const Segment& segment : m_segments) {
+        if (!segment.isParameter) {
+            context.appendSql(segment.text);
+        } else if (const QString* placeholder = context.itemPlaceholder(segment.text)) {
+            context.appendSql(QStringLiteral(":") + *placeholder);
+        } else if (parameters.contains(segment.text)) {
+            context.appendSql(QStringLiteral(":") + segment.text);
+        } else {
+            context.appendSql(QStringLiteral("#{") + segment.text + QStringLiteral("}"));
+        }
+    }
+}
+
+void TextSqlNode::appendShape(DynamicContext& context, SqlShape& shape) const
+{
+    // 未提供的参数保留为 #{param} 原文，同样影响生成的SQL
+    if (!m_hasParameters) {
+        return;
+    }
+
+    const QVariantMap& parameters = context.parameters();
+    for (const Segment& segment : m_segments) {
+        if (segment.isParameter) {
+            shape.addFlag(context.itemPlaceholder(segment.text) || parameters.contains(segment.text));
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// MixedSqlNode
+
+MixedSqlNode::MixedSqlNode(const QVector<SqlNodePtr>& children)
+    : m_children(children)
+{
+}
+
+void MixedSqlNode::apply(DynamicContext& context) const
+{
+    for (const SqlNodePtr& child : m_children) {
+        child->apply(context);
+    }
+}
+
+void MixedSqlNode::appendShape(DynamicContext& context, SqlShape& shape) const
+{
+    for (const SqlNodePtr& child : m_children) {
+        child->appendShape(context, shape);
+    }
+}
+
+bool MixedSqlNode::isDynamic() const
+{
+    for (const SqlNodePtr& child : m_children) {
+        if (child->isDynamic()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// ---------------------------------------------------------------------------
+// IfSqlNode
+
+IfSqlNode::IfSqlNode(const SqlExpression& test, SqlNodePtr contents)
+    : m_test(test)
+    , m_contents(contents)
+{
+}
+
+void IfSqlNode::apply(DynamicContext& context) const
+{
+    if (test(context)) {
+        m_contents->apply(context);
+    }
+}
+
+void IfSqlNode::appendShape(DynamicContext& context, SqlShape& shape) const
+{
+    const bool taken = test(context);
+    shape.addFlag(taken);
+    if (taken) {
+        m_contents->appendShape(context, shape);
+    }
+}
+
+bool IfSqlNode::test(const DynamicContext& context) const
+{
+    return m_test.evaluate(context);
+}
+
+// ---------------------------------------------------------------------------
+// ChooseSqlNode
+
+ChooseSqlNode::ChooseSqlNode(const QVector<QSharedPointer<const IfSqlNode>>& whens, SqlNodePtr otherwise)
+    : m_whens(whens)
+    , m_otherwise(otherwise)
+{
+}
+
+void ChooseSqlNode::apply(DynamicContext& context) const
+{
+    for (const auto& when : m_whens) {
+        if (when->test(context)) {
+            when->apply(context);
+            return;
+        }
+    }
+
+    if (m_otherwise) {
+        m_otherwise->apply(context);
+    }
+}
+
+void ChooseSqlNode::appendShape(DynamicContext& context, SqlShape& shape) const
+{
+    for (qsizetype i = 0; i < m_whens.size(); ++i) {
+        if (m_whens.at(i)->test(context)) {
+            shape.addCount(i);
+            m_whens.at(i)->appendShape(context, shape);
+            return;
+        }
+    }
+
+    shape.addCount(m_whens.size());
+    if (m_otherwise) {
+        m_otherwise->appendShape(context, shape);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// ForEachSqlNode
+
+ForEachSqlNode::ForEachSqlNode(const QString& collection, const QString& item,
+                               const QString& open, const QString& close,
+                               const QString& separator, SqlNodePtr contents, bool padToBucket)
+    : m_collection(collection)
+    , m_placeholderPrefix(placeholderPrefix(collection))
+    , m_item(item)
+    , m_open(open)
+    , m_close(close)
+    , m_separator(separator)
+    , m_contents(contents)
+    , m_padToBucket(padToBucket)
+{
+}
+
+QVariantList ForEachSqlNode::collection(const DynamicContext& context) const
+{
+    QVariant value;
+    if (!context.lookup(m_collection, value)) {
+        return QVariantList();
+    }
+
+    if (value.typeId() == QMetaType::QVariantList || value.typeId() == QMetaType::QStringList) {
+        return value.toList();
+    }
+    return QVariantList();
+}
+
+qsizetype ForEachSqlNode::iterationCount(qsizetype size) const
+{
+    if (!m_padToBucket || size <= 1) {
+        return size;
+    }
+
+    // 补齐到不小于size的2的幂
+    qsizetype bucket = 1;
+    while (bucket < size) {
+        bucket <<= 1;
+    }
+    return bucket;
+}
+
+void ForEachSqlNode::appendShape(DynamicContext& context, SqlShape& shape) const
+{
+    const QVariantList items = collection(context);
+    const qsizetype count = iterationCount(items.size());
+    shape.addCount(count);
+    for (qsizetype i = 0; i < count; ++i) {
+        context.bindItem(m_item, QString(), items.at(qMin(i, items.size() - 1)));
+        m_contents->appendShape(context, shape);
+        context.unbindItem();
+    }
+}
+
+void ForEachSqlNode::apply(DynamicContext& context) const
+{
+    const QVariantList items = collection(context);
+    const qsizetype count = iterationCount(items.size());
+    if (count == 0) {
+        return;
+    }
+
+    // 占位符名与ParameterHandler的解析规则一致：集合名_下标，超出长度的下标取最后一个元素
+    context.appendSql(m_open);
+    bool first = true;
+    for (qsizetype i = 0; i < count; ++i) {
+        // 元素内容为空（如被<if>过滤）时不输出分隔符
+        const qsizetype mark = context.sql().size();
+        if (!first) {
+            context.appendSql(m_separator);
+        }
+        const qsizetype contentStart = context.sql().size();
+        context.bindItem(m_item, m_placeholderPrefix + QString::number(i), items.at(qMin(i, items.size() - 1)));
+        m_contents->apply(context);
+        context.unbindItem();
+        if (context.sql().size() == contentStart) {
+            context.truncateSql(mark);
+        } else {
+            first = false;
+        }
+    }
+    context.appendSql(m_close);
+}
+
+// ---------------------------------------------------------------------------
+// TrimSqlNode
+
+TrimSqlNode::TrimSqlNode(SqlNodePtr contents,
+                         const QString& prefix, const QStringList& prefixOverrides,
+                         const QString& suffix, const QStringList& suffixOverrides)
+    : m_contents(contents)
+    , m_prefix(prefix)
+    , m_prefixOverrides(prefixOverrides)
+    , m_suffix(suffix)
+    , m_suffixOverrides(suffixOverrides)
+{
+}
+
+QSharedPointer<TrimSqlNode> TrimSqlNode::where(SqlNodePtr contents)
+{
+    static const QStringList prefixOverrides = {
+        QStringLiteral("AND "), QStringLiteral("OR "),
+        QStringLiteral("AND\n"), QStringLiteral("OR\n"),
+        QStringLiteral("AND\r"), QStringLiteral("OR\r"),
+        QStringLiteral("AND\t"), QStringLiteral("OR\t")
+    };
+    return QSharedPointer<TrimSqlNode>::create(contents, QStringLiteral("WHERE"), prefixOverrides,
+                                               QString(), QStringList());
+}
+
+QSharedPointer<TrimSqlNode> TrimSqlNode::set(SqlNodePtr contents)
+{
+    static const QStringList overrides = {QStringLiteral(",")};
+    return QSharedPointer<TrimSqlNode>::create(contents, QStringLiteral("SET"), overrides,
+                                               QString(), overrides);
+}
+
+void TrimSqlNode::apply(DynamicContext& context) const
+{
+    DynamicContext inner = context.nested();
+    m_contents->apply(inner);
+
+    QString body = inner.sql().trimmed();
+    if (body.isEmpty()) {
+        return;
+    }
+
+    for (const QString& override : m_prefixOverrides) {
+        if (body.startsWith(override, Qt::CaseInsensitive)) {
+            body = body.mid(override.size()).trimmed();
+            break;
+        }
+    }
+
+    for (const QString& override : m_suffixOverrides) {
+        if (body.endsWith(override, Qt::CaseInsensitive)) {
+            body.chop(override.size());
+            body = body.trimmed();
+            break;
+        }
+    }
+
+    if (body.isEmpty()) {
+        return;
+    }
+
+    // 与前文之间保留一个空格
+    const QString& current = context.sql();
+    if (!m_prefix.isEmpty() && !current.isEmpty() && !current.back().isSpace()) {
+        context.appendSql(QStringLiteral(" "));
+    }
+
+    if (!m_prefix.isEmpty()) {
+        context.appendSql(m_prefix + QStringLiteral(" "));
+    }
+    context.appendSql(body);
+    if (!m_suffix.isEmpty()) {
+        context.appendSql(QStringLiteral(" ") + m_suffix);
+    }
+}
+
+void TrimSqlNode::appendShape(DynamicContext& context, SqlShape& shape) const
+{
+    m_contents->appendShape(context, shape);
+}
+
+bool TrimSqlNode::isDynamic() const
+{
+    return m_contents->isDynamic();
+}
+
+// ---------------------------------------------------------------------------
+// SqlNodeBuilder
+
+SqlNodeBuilder::SqlNodeBuilder(const QString& sql)
+    : m_sql(sql)
+    , m_pos(0)
+{
+}
+
+SqlNodePtr SqlNodeBuilder::build(const QString& sql)
+{
+    SqlNodeBuilder builder(sql);
+    return toNode(builder.parseContents(QString()));
+}
+
+QVector<SqlNodeBuilder::ParsedNode> SqlNodeBuilder::parseContents(const QString& closingTag)
+{
+    QVector<ParsedNode> result;
+    int textStart = m_pos;
+
+    auto flushText = [&](int end) {
+        if (end > textStart) {
+            result.append(ParsedNode{QString(), SqlNodePtr(new TextSqlNode(m_sql.mid(textStart, end - textStart)))});
+        }
+    };
+
+    while (m_pos < m_sql.size()) {
+        const int lt = m_sql.indexOf(QLatin1Char('<'), m_pos);
+        if (lt < 0) {
+            m_pos = m_sql.size();
+            break;
+        }
+        m_pos = lt;
+
+        if (!closingTag.isEmpty() && matchClosingTag(closingTag)) {
+            flushText(lt);
+            return result;
+        }
+
+        QString tagName;
+        QHash<QString, QString> attributes;
+        bool selfClosing = false;
+        if (matchOpeningTag(tagName, attributes, selfClosing)) {
+            flushText(lt);
+            QVector<ParsedNode> contents;
+            if (!selfClosing) {
+                contents = parseContents(tagName);
+            }
+            result.append(buildElement(tagName, attributes, contents));
+            textStart = m_pos;
+            continue;
+        }
+
+        // 普通的小于号，作为SQL文本保留
+        m_pos = lt + 1;
+    }
+
+    // 未闭合的元素视为在文本末尾结束
+    flushText(m_sql.size());
+    return result;
+}
+
+bool SqlNodeBuilder::matchClosingTag(const QString& tagName)
+{
+    const QStringView sql(m_sql);
+    int pos = m_pos;
+
+    if (!sql.mid(pos).startsWith(QLatin1String("</"))) {
+        return false;
+    }
+    pos += 2;
+
+    if (!sql.mid(pos).startsWith(tagName)) {
+        return false;
+    }
+    pos += tagName.size();
+
+    while (pos < sql.size() && sql.at(pos).isSpace()) {
+        ++pos;
+    }
+    if (pos >= sql.size() || sql.at(pos) != QLatin1Char('>')) {
+        return false;
+    }
+
+    m_pos = pos + 1;
+    return true;
+}
+
+bool SqlNodeBuilder::matchOpeningTag(QString& tagName, QHash<QString, QString>& attributes, bool& selfClosing)
+{
+    const QStringView sql(m_sql);
+    const int length = sql.size();
+    int pos = m_pos + 1;
+
+    const int nameStart = pos;
+    while (pos < length && isTagNameChar(sql.at(pos))) {
+        ++pos;
+    }
+    const QStringView name = sql.mid(nameStart, pos - nameStart);
+    if (!isKnownTag(name) || pos >= length) {
+        return false;
+    }
+
+    const QChar next = sql.at(pos);
+    if (!next.isSpace() && next != QLatin1Char('>') && next != QLatin1Char('/')) {
+        return false;
+    }
+
+    // 解析属性 name="value" 或 name='value'
+    while (true) {
+        while (pos < length && sql.at(pos).isSpace()) {
+            ++pos;
+        }
+        if (pos >= length) {
+            return false;
+        }
+        if (sql.at(pos) == QLatin1Char('>')) {
+            ++pos;
+            break;
+        }
+        if (sql.at(pos) == QLatin1Char('/')) {
+            if (pos + 1 < length && sql.at(pos + 1) == QLatin1Char('>')) {
+                selfClosing = true;
+                pos += 2;
+                break;
+            }
+            return false;
+        }
+
+        const int attrStart = pos;
+        while (pos < length && !sql.at(pos).isSpace() && sql.at(pos) != QLatin1Char('=')
+               && sql.at(pos) != QLatin1Char('>') && sql.at(pos) != QLatin1Char('/')) {
+            ++pos;
+        }
+        const QString attrName = sql.mid(attrStart, pos - attrStart).toString();
+
+        while (pos < length && sql.at(pos).isSpace()) {
+            ++pos;
+        }
+        if (attrName.isEmpty() || pos >= length || sql.at(pos) != QLatin1Char('=')) {
+            return false;
+        }
+        ++pos;
+        while (pos < length && sql.at(pos).isSpace()) {
+            ++pos;
+        }
+        if (pos >= length || (sql.at(pos) != QLatin1Char('"') && sql.at(pos) != QLatin1Char('\''))) {
+            return false;
+        }
+
+        const QChar quote = sql.at(pos++);
+        const int valueEnd = m_sql.indexOf(quote, pos);
+        if (valueEnd < 0) {
+            return false;
+        }
+        attributes.insert(attrName, unescapeAttribute(m_sql.mid(pos, valueEnd - pos)));
+        pos = valueEnd + 1;
+    }
+
+    tagName = name.toString();
+    m_pos = pos;
+    return true;
+}
+
+SqlNodeBuilder::ParsedNode SqlNodeBuilder::buildElement(const QString& tagName,
+                                                        const QHash<QString, QString>& attributes,
+                                                        const QVector<ParsedNode>& contents)
+{
+    if (tagName == QLatin1String("if") || tagName == QLatin1String("when")) {
+        // test表达式在编译时解析，语法错误在加载映射文件时即报告
+        SqlExpression test = SqlExpression::parse(attributes.value(QStringLiteral("test")));
+        return {tagName, SqlNodePtr(new IfSqlNode(test, toNode(contents)))};
+    }
+
+    if (tagName == QLatin1String("choose")) {
+        QVector<QSharedPointer<const IfSqlNode>> whens;
+        SqlNodePtr otherwise;
+        for (const ParsedNode& child : contents) {
+            if (child.tag == QLatin1String("when")) {
+                whens.append(child.node.staticCast<const IfSqlNode>());
+            } else if (child.tag == QLatin1String("otherwise") && !otherwise) {
+                otherwise = child.node;
+            }
+        }
+        return {tagName, SqlNodePtr(new ChooseSqlNode(whens, otherwise))};
+    }
+
+    if (tagName == QLatin1String("foreach")) {
+        SqlNodePtr node(new ForEachSqlNode(
+            attributes.value(QStringLiteral("collection")),
+            attributes.value(QStringLiteral("item"), QStringLiteral("item")),
+            attributes.value(QStringLiteral("open")),
+            attributes.value(QStringLiteral("close")),
+            attributes.value(QStringLiteral("separator"), QStringLiteral(",")),
+            toNode(contents),
+            attributes.value(QStringLiteral("padToBucket")) == QLatin1String("true")));
+        return {tagName, node};
+    }
+
+    if (tagName == QLatin1String("where")) {
+        return {tagName, TrimSqlNode::where(toNode(contents))};
+    }
+
+    if (tagName == QLatin1String("set")) {
+        return {tagName, TrimSqlNode::set(toNode(contents))};
+    }
+
+    if (tagName == QLatin1String("trim")) {
+        SqlNodePtr node(new TrimSqlNode(
+            toNode(contents),
+            attributes.value(QStringLiteral("prefix")),
+            splitOverrides(attributes.value(QStringLiteral("prefixOverrides"))),
+            attributes.value(QStringLiteral("suffix")),
+            splitOverrides(attributes.value(QStringLiteral("suffixOverrides")))));
+        return {tagName, node};
+    }
+
+    // otherwise
+    return {tagName, toNode(contents)};
+}
+
+SqlNodePtr SqlNodeBuilder::toNode(const QVector<ParsedNode>& contents)
+{
+    if (contents.size() == 1) {
+        return contents.first().node;
+    }
+
+    QVector<SqlNodePtr> children;
+    children.reserve(contents.size());
+    for (const ParsedNode& child : contents) {
+        children.append(child.node);
+    }
+    return SqlNodePtr(new MixedSqlNode(children));
+}
+
+} // namespace QtMyBatisORM
@@ -0,0 +1,32 @@
+#include "QtMyBatisORM/statementhandle.h"
+
+#include <utility>
+
+namespace QtMyBatisORM {
+
+StatementHandle::StatementHandle(QSharedPointer<const CompiledStatement> statement)
+    : m_statement(std::move(statement))
+{
+}
+
+bool StatementHandle::isValid() const
+{
+    return !m_statement.isNull();
+}
+
+QString StatementHandle::id() const
+{
+    return m_statement ? m_statement->id : QString();
+}
+
+StatementType StatementHandle::type() const
+{
+    return m_statement ? m_statement->config.type : StatementType::SELECT;
+}
+
+const CompiledStatement* StatementHandle::compiled() const
+{
+    return m_statement.data();
+}
+
+} // namespace QtMyBatisORM
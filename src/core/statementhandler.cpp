@@ -1,5 +1,6 @@
 #include "QtMyBatisORM/statementhandler.h"
 #include "QtMyBatisORM/dynamicsqlprocessor.h"
+#include "QtMyBatisORM/preparedstatementcache.h"
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QRegularExpression>
@@ -13,9 +14,15 @@ StatementHandler::StatementHandler(QObject* parent)
     m_dynamicProcessor = new DynamicSqlProcessor(this);
 }
 
-QSqlQuery StatementHandler::prepare(const QString& sql, QSqlDatabase& db)
+QSqlQuery StatementHandler::prepare(const QString& sql, QSqlDatabase& db, bool forwardOnly)
 {
+    // 优先复用连接上已预编译的语句
+    if (m_statementCache) {
+        return m_statementCache->acquire(sql, db, forwardOnly);
+    }
+    
     QSqlQuery query(db);
+    query.setForwardOnly(forwardOnly);
     bool prepareResult = query.prepare(sql);
     if (!prepareResult) {
         qWarning() << "Failed to prepare SQL:" << sql << "-" << query.lastError().text();
@@ -23,6 +30,24 @@ QSqlQuery StatementHandler::prepare(const QString& sql, QSqlDatabase& db)
     return query;
 }
 
+void StatementHandler::release(const QString& sql, QSqlQuery& query)
+{
+    // 执行完成后将语句归还给连接的缓存
+    if (m_statementCache) {
+        m_statementCache->release(sql, query);
+    }
+}
+
+void StatementHandler::setPreparedStatementCache(QSharedPointer<PreparedStatementCache> cache)
+{
+    m_statementCache = cache;
+}
+
+QSharedPointer<PreparedStatementCache> StatementHandler::preparedStatementCache() const
+{
+    return m_statementCache;
+}
+
 void StatementHandler::setParameters(QSqlQuery& query, const QVariantMap& parameters)
 {
     for (auto it = parameters.begin(); it != parameters.end(); ++it) {
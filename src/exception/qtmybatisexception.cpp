@@ -111,6 +111,17 @@ SqlExecutionException* SqlExecutionException::clone() const
     return new SqlExecutionException(*this);
 }
 
+// TimeoutException
+TimeoutException::TimeoutException(const QString& message, const QString& code)
+    : SqlExecutionException(message, code)
+{
+}
+
+TimeoutException* TimeoutException::clone() const
+{
+    return new TimeoutException(*this);
+}
+
 // ConnectionException
 ConnectionException::ConnectionException(const QString& message, const QString& code)
     : QtMyBatisException(message, code)
@@ -119,6 +119,52 @@ QVariantList QtMyBatisHelper::selectList(const QString& statementId, const QVari
     return session->selectList(statementId, parameters);
 }
 
+PageResult QtMyBatisHelper::selectPage(const QString& statementId, const QVariantMap& parameters,
+                                       int page, int pageSize)
+{
+    checkInitialized();
+
+    SessionScope session;
+    return session->selectPage(statementId, parameters, page, pageSize);
+}
+
+QVariantList QtMyBatisHelper::selectByKeys(const QString& statementId, const QString& keyParam,
+                                           const QVariantList& keys, const QVariantMap& parameters)
+{
+    checkInitialized();
+
+    SessionScope session;
+    return session->selectByKeys(statementId, keyParam, keys, parameters);
+}
+
+QHash<QString, QVariantMap> QtMyBatisHelper::selectMapByKeys(const QString& statementId, const QString& keyParam,
+                                                             const QVariantList& keys, const QString& mapKey,
+                                                             const QVariantMap& parameters)
+{
+    checkInitialized();
+
+    SessionScope session;
+    return session->selectMapByKeys(statementId, keyParam, keys, mapKey, parameters);
+}
+
+ResultSet QtMyBatisHelper::selectResultSet(const QString& statementId, const QVariantMap& parameters)
+{
+    checkInitialized();
+
+    SessionScope session;
+    return session->selectResultSet(statementId, parameters);
+}
+
+int QtMyBatisHelper::selectCursor(const QString& statementId, const QVariantMap& parameters,
+                                  const RowCallback& callback)
+{
+    checkInitialized();
+
+    // 会话在整个遍历期间持有连接
+    SessionScope session;
+    return session->selectCursor(statementId, parameters, callback);
+}
+
 int QtMyBatisHelper::insert(const QString& statementId, const QVariantMap& parameters)
 {
     checkInitialized();
@@ -127,6 +173,14 @@ int QtMyBatisHelper::insert(const QString& statementId, const QVariantMap& param
     return session->insert(statementId, parameters);
 }
 
+QVariantList QtMyBatisHelper::insertWithKeys(const QString& statementId, const QVariantMap& parameters)
+{
+    checkInitialized();
+
+    SessionScope session;
+    return session->insertWithKeys(statementId, parameters);
+}
+
 int QtMyBatisHelper::update(const QString& statementId, const QVariantMap& parameters)
 {
     checkInitialized();
@@ -152,12 +206,13 @@ int QtMyBatisHelper::execute(const QString& sql, const QVariantMap& parameters)
     return session->execute(sql, parameters);
 }
 
-int QtMyBatisHelper::batchInsert(const QString& statementId, const QList<QVariantMap>& parametersList)
+int QtMyBatisHelper::batchInsert(const QString& statementId, const QList<QVariantMap>& parametersList,
+                                 BatchStrategy strategy)
 {
     checkInitialized();
     
     SessionScope session;
-    return session->batchInsert(statementId, parametersList);
+    return session->batchInsertWithResult(statementId, parametersList, strategy).totalAffected;
 }
 
 int QtMyBatisHelper::batchUpdate(const QString& statementId, const QList<QVariantMap>& parametersList)
@@ -169,6 +224,15 @@ int QtMyBatisHelper::batchUpdate(const QString& statementId, const QList<QVarian
     return session->batchUpdate(statementId, parametersList);
 }
 
+int QtMyBatisHelper::batchUpsert(const QString& statementId, const QList<QVariantMap>& rows,
+                                 const QStringList& conflictKeys, BatchStrategy strategy)
+{
+    checkInitialized();
+
+    SessionScope session;
+    return session->batchUpsert(statementId, rows, conflictKeys, strategy);
+}
+
 int QtMyBatisHelper::batchRemove(const QString& statementId, const QList<QVariantMap>& parametersList)
 {
     checkInitialized();
@@ -177,6 +241,42 @@ int QtMyBatisHelper::batchRemove(const QString& statementId, const QList<QVarian
     return session->batchRemove(statementId, parametersList);
 }
 
+QFuture<QVariant> QtMyBatisHelper::selectOneAsync(const QString& statementId, const QVariantMap& parameters)
+{
+    checkInitialized();
+    
+    return s_orm->getSessionFactory()->selectOneAsync(statementId, parameters);
+}
+
+QFuture<QVariantList> QtMyBatisHelper::selectListAsync(const QString& statementId, const QVariantMap& parameters)
+{
+    checkInitialized();
+    
+    return s_orm->getSessionFactory()->selectListAsync(statementId, parameters);
+}
+
+QFuture<int> QtMyBatisHelper::updateAsync(const QString& statementId, const QVariantMap& parameters)
+{
+    checkInitialized();
+    
+    return s_orm->getSessionFactory()->updateAsync(statementId, parameters);
+}
+
+QFuture<int> QtMyBatisHelper::batchInsertAsync(const QString& statementId, const QList<QVariantMap>& parametersList,
+                                               BatchStrategy strategy)
+{
+    checkInitialized();
+    
+    return s_orm->getSessionFactory()->batchInsertAsync(statementId, parametersList, strategy);
+}
+
+QList<QVariantList> QtMyBatisHelper::executeParallel(const QList<ParallelStatement>& statements, int maxParallelism)
+{
+    checkInitialized();
+    
+    return s_orm->getSessionFactory()->executeParallel(statements, maxParallelism);
+}
+
 bool QtMyBatisHelper::executeInTransaction(std::function<bool()> operation)
 {
     checkInitialized();
@@ -1,6 +1,7 @@
 #include "QtMyBatisORM/mapperregistry.h"
 #include "QtMyBatisORM/mapperproxy.h"
 #include "QtMyBatisORM/session.h"
+#include "QtMyBatisORM/executor.h"
 #include "QtMyBatisORM/qtmybatisexception.h"
 #include "QtMyBatisORM/configurationmanager.h"
 #include <QDebug>
@@ -118,6 +119,48 @@ MapperConfig MapperRegistry::getMapperConfig(const QString& mapperName) const
     return m_mappers[mapperName];
 }
 
+StatementConfig MapperRegistry::resolveStatement(const QString& statementId) const
+{
+    // 更高效的字符串解析
+    int dotPos = statementId.indexOf(QLatin1Char('.'));
+    if (dotPos <= 0 || dotPos == statementId.length() - 1) {
+        throw MappingException(
+            QStringLiteral("Invalid statement ID format: %1. Expected format: namespace.statementId")
+            .arg(statementId)
+        );
+    }
+    
+    const QString mapperName = statementId.left(dotPos);
+    const QString stmtId = statementId.mid(dotPos + 1);
+    
+    auto mapper = m_mappers.constFind(mapperName);
+    if (mapper == m_mappers.constEnd()) {
+        throw MappingException(
+            QStringLiteral("Mapper not found: %1").arg(mapperName)
+        );
+    }
+    
+    // 语句可按完整ID或短ID注册
+    const QHash<QString, StatementConfig>& statements = mapper->statements;
+    auto it = statements.constFind(statementId);
+    if (it == statements.constEnd()) {
+        it = statements.constFind(stmtId);
+    }
+    if (it == statements.constEnd()) {
+        throw MappingException(
+            QStringLiteral("Statement not found: %1 in mapper: %2")
+            .arg(stmtId).arg(mapperName)
+        );
+    }
+    
+    return it.value();
+}
+
+StatementHandle MapperRegistry::statement(const QString& statementId) const
+{
+    return StatementHandle(Executor::compileStatement(statementId, resolveStatement(statementId)));
+}
+
 bool MapperRegistry::hasMapper(const QString& mapperName) const
 {
     return m_mappers.contains(mapperName);
@@ -1,4 +1,5 @@
 #include "QtMyBatisORM/connectionpool.h"
+#include "QtMyBatisORM/preparedstatementcache.h"
 #include "QtMyBatisORM/qtmybatisexception.h"
 #include "QtMyBatisORM/logger.h"
 #include <QSqlDatabase>
@@ -208,6 +209,59 @@ void ConnectionPool::returnConnection(QSharedPointer<QSqlDatabase> connection)
     }
 }
 
+QSharedPointer<QSqlDatabase> ConnectionPool::getThreadConnection()
+{
+    QMutexLocker locker(&m_mutex);
+    
+    if (m_closed) {
+        throw ConnectionException("Connection pool is closed", "POOL_CLOSED");
+    }
+    
+    // 空闲连接同样占用容量；已满时直接失败，空闲连接属于创建它的线程，不能在这里关闭
+    if (m_usedConnections.size() + m_availableConnections.size() >= m_config.maxConnections) {
+        m_stats.connectionTimeouts++;
+        ConnectionException ex("Connection pool exhausted", "POOL_EXHAUSTED");
+        ex.setContext(QStringLiteral("maxConnections"), m_config.maxConnections);
+        ex.setContext(QStringLiteral("usedConnections"), m_stats.usedConnections);
+        throw ex;
+    }
+    
+    // 在调用线程中新建连接，QSqlDatabase只能在创建它的线程中使用
+    QSharedPointer<QSqlDatabase> connection;
+    try {
+        connection = createConnection();
+    } catch (const ConnectionException&) {
+        m_stats.connectionFailures++;
+        throw;
+    }
+    
+    m_usedConnections.insert(connection);
+    m_connectionInfoMap[connection] = ConnectionInfo(connection);
+    
+    m_stats.totalConnectionsCreated++;
+    m_stats.totalConnections++;
+    m_stats.usedConnections++;
+    m_stats.lastConnectionCreated = QDateTime::currentDateTime();
+    if (m_stats.usedConnections > m_stats.peakUsedConnections) {
+        m_stats.peakUsedConnections = m_stats.usedConnections;
+    }
+    
+    return connection;
+}
+
+void ConnectionPool::releaseThreadConnection(QSharedPointer<QSqlDatabase> connection)
+{
+    QMutexLocker locker(&m_mutex);
+    
+    if (!connection || !m_usedConnections.remove(connection)) {
+        return;
+    }
+    
+    // 线程独占连接不回到可用队列，直接在所属线程中关闭
+    removeConnection(connection);
+    m_stats.usedConnections--;
+}
+
 void ConnectionPool::close()
 {
     QMutexLocker locker(&m_mutex);
@@ -222,6 +276,12 @@ void ConnectionPool::close()
         m_cleanupTimer->stop();
     }
     
+    // 预编译语句必须在连接关闭前释放
+    for (const auto& cache : std::as_const(m_statementCaches)) {
+        cache->clear();
+    }
+    m_statementCaches.clear();
+    
     // 关闭所有连接
     while (!m_availableConnections.isEmpty()) {
         ConnectionInfo connInfo = m_availableConnections.dequeue();
@@ -252,6 +312,15 @@ int ConnectionPool::usedConnections() const
     return m_usedConnections.size();
 }
 
+int ConnectionPool::spareConnections() const
+{
+    QMutexLocker locker(const_cast<QMutex*>(&m_mutex));
+    if (m_closed) {
+        return 0;
+    }
+    return qMax(0, m_config.maxConnections - m_availableConnections.size() - m_usedConnections.size());
+}
+
 int ConnectionPool::totalConnections() const
 {
     QMutexLocker locker(const_cast<QMutex*>(&m_mutex));
@@ -396,6 +465,12 @@ bool ConnectionPool::isConnectionValid(QSharedPointer<QSqlDatabase> connection)
 
 void ConnectionPool::removeConnection(QSharedPointer<QSqlDatabase> connection)
 {
+    // 预编译语句必须在连接关闭前释放
+    QSharedPointer<PreparedStatementCache> statementCache = m_statementCaches.take(connection);
+    if (statementCache) {
+        statementCache->clear();
+    }
+    
     if (connection && connection->isOpen()) {
         QString connectionName = connection->connectionName();
         connection->close();
@@ -572,6 +647,40 @@ void ConnectionPool::performHealthCheck()
     }
 }
 
+QSharedPointer<PreparedStatementCache> ConnectionPool::getPreparedStatementCache(QSharedPointer<QSqlDatabase> connection)
+{
+    QMutexLocker locker(&m_mutex);
+    
+    if (!connection || m_closed || m_config.preparedStatementCacheSize <= 0) {
+        return QSharedPointer<PreparedStatementCache>();
+    }
+    
+    QSharedPointer<PreparedStatementCache>& cache = m_statementCaches[connection];
+    if (!cache) {
+        cache = QSharedPointer<PreparedStatementCache>::create(m_config.preparedStatementCacheSize);
+    }
+    return cache;
+}
+
+PreparedStatementStats ConnectionPool::getPreparedStatementStats() const
+{
+    QMutexLocker locker(const_cast<QMutex*>(&m_mutex));
+    
+    // 汇总所有连接的预编译语句缓存统计
+    PreparedStatementStats total;
+    for (const auto& cache : m_statementCaches) {
+        PreparedStatementStats stats = cache->getStats();
+        total.hitCount += stats.hitCount;
+        total.missCount += stats.missCount;
+        total.evictionCount += stats.evictionCount;
+        total.currentSize += stats.currentSize;
+        total.maxSize += stats.maxSize;
+    }
+    total.updateHitRate();
+    
+    return total;
+}
+
 void ConnectionPool::resetStats()
 {
     QMutexLocker locker(&m_mutex);
@@ -0,0 +1,111 @@
+#include "QtMyBatisORM/preparedstatementcache.h"
+#include <QMutexLocker>
+#include <QSqlError>
+#include <QDebug>
+#include <utility>
+
+namespace QtMyBatisORM {
+
+PreparedStatementCache::PreparedStatementCache(int maxSize)
+    : m_maxSize(qMax(0, maxSize))
+{
+    m_statements.setMaxCost(m_maxSize);
+    m_stats.maxSize = m_maxSize;
+}
+
+PreparedStatementCache::~PreparedStatementCache()
+{
+    clear();
+}
+
+QSqlQuery PreparedStatementCache::acquire(const QString& sql, QSqlDatabase& db, bool forwardOnly)
+{
+    if (m_maxSize > 0) {
+        QMutexLocker locker(&m_mutex);
+
+        // 命中：从缓存中取出语句，使用期间不再对其他调用者可见
+        QSqlQuery* cached = m_statements.take(StatementKey(sql, forwardOnly));
+        if (cached) {
+            QSqlQuery query(std::move(*cached));
+            delete cached;
+
+            m_stats.hitCount++;
+            m_stats.currentSize = m_statements.size();
+            m_stats.updateHitRate();
+            return query;
+        }
+
+        m_stats.missCount++;
+        m_stats.updateHitRate();
+    }
+
+    // 未命中：由驱动重新解析SQL；只进模式必须在prepare之前设置，之后不再修改
+    QSqlQuery query(db);
+    query.setForwardOnly(forwardOnly);
+    if (!query.prepare(sql)) {
+        qWarning() << "Failed to prepare SQL:" << sql << "-" << query.lastError().text();
+    }
+    return query;
+}
+
+void PreparedStatementCache::release(const QString& sql, QSqlQuery& query)
+{
+    if (m_maxSize <= 0 || query.lastError().isValid()) {
+        return;
+    }
+
+    // 重置语句，释放SQLite读锁等驱动端资源，保留预编译结果；
+    // 只进模式按prepare时的设置归入对应的缓存项
+    query.finish();
+    const StatementKey key(sql, query.isForwardOnly());
+
+    QMutexLocker locker(&m_mutex);
+
+    if (!m_statements.contains(key) && m_statements.size() >= m_maxSize) {
+        m_stats.evictionCount++;
+    }
+
+    m_statements.insert(key, new QSqlQuery(std::move(query)));
+    m_stats.currentSize = m_statements.size();
+}
+
+void PreparedStatementCache::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_statements.clear();
+    m_stats.currentSize = 0;
+}
+
+int PreparedStatementCache::size() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_statements.size();
+}
+
+int PreparedStatementCache::getMaxSize() const
+{
+    return m_maxSize;
+}
+
+bool PreparedStatementCache::isEnabled() const
+{
+    return m_maxSize > 0;
+}
+
+PreparedStatementStats PreparedStatementCache::getStats() const
+{
+    QMutexLocker locker(&m_mutex);
+    PreparedStatementStats stats = m_stats;
+    stats.currentSize = m_statements.size();
+    return stats;
+}
+
+void PreparedStatementCache::resetStats()
+{
+    QMutexLocker locker(&m_mutex);
+    m_stats = PreparedStatementStats();
+    m_stats.maxSize = m_maxSize;
+    m_stats.currentSize = m_statements.size();
+}
+
+} // namespace QtMyBatisORM
@@ -0,0 +1,156 @@
+#include <QCoreApplication>
+#include <QtTest>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QTemporaryDir>
+#include <QThread>
+#include "QtMyBatisORM/coro.h"
+
+using namespace QtMyBatisORM;
+
+namespace {
+
+struct Observed
+{
+    QThread* resumedOn = nullptr;
+    QThread* workerThread = nullptr;
+    QVariant value;
+    int affected = -1;
+    bool missingThrew = false;
+    bool finished = false;
+};
+
+Coro::Task<int> countRows(QSharedPointer<Coro::AsyncSession> session)
+{
+    QVariant count = co_await session->run<QVariant>([](Session& s) {
+        return QVariant(s.execute(QStringLiteral("UPDATE coro_table SET value = value")));
+    });
+    co_return count.toInt();
+}
+
+Coro::Task<> scenario(QSharedPointer<Coro::AsyncSession> session, Observed* observed)
+{
+    observed->workerThread = co_await session->run<QThread*>([](Session&) {
+        return QThread::currentThread();
+    });
+    observed->resumedOn = QThread::currentThread();
+
+    observed->affected = co_await countRows(session);
+
+    try {
+        co_await session->selectList(QStringLiteral("Missing.statement"));
+    } catch (const QtMyBatisException&) {
+        observed->missingThrew = true;
+    }
+
+    observed->finished = true;
+}
+
+} // namespace
+
+class TestCoro : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void testAwaitResumesOnCallerThread();
+    void testAwaitAfterFactoryClose();
+
+private:
+    DatabaseConfig createTestConfig();
+
+    QTemporaryDir* m_tempDir = nullptr;
+    QString m_dbPath;
+};
+
+void TestCoro::initTestCase()
+{
+    m_tempDir = new QTemporaryDir();
+    QVERIFY(m_tempDir->isValid());
+    m_dbPath = m_tempDir->path() + "/coro.db";
+
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "coro_setup");
+        db.setDatabaseName(m_dbPath);
+        QVERIFY(db.open());
+        QSqlQuery query(db);
+        QVERIFY(query.exec("CREATE TABLE coro_table (id INTEGER PRIMARY KEY, value INTEGER)"));
+        QVERIFY(query.exec("INSERT INTO coro_table (value) VALUES (1), (2), (3)"));
+        db.close();
+    }
+    QSqlDatabase::removeDatabase("coro_setup");
+}
+
+void TestCoro::cleanupTestCase()
+{
+    delete m_tempDir;
+}
+
+DatabaseConfig TestCoro::createTestConfig()
+{
+    DatabaseConfig config;
+    config.driverName = "QSQLITE";
+    config.databaseName = m_dbPath;
+    config.maxConnections = 5;
+    config.minConnections = 1;
+    config.asyncWorkerCount = 1;
+    return config;
+}
+
+void TestCoro::testAwaitResumesOnCallerThread()
+{
+    QSharedPointer<SessionFactory> factory = SessionFactory::create(createTestConfig());
+    QSharedPointer<Coro::AsyncSession> session = Coro::AsyncSession::create(factory);
+
+    Observed observed;
+    Coro::Task<> task = scenario(session, &observed);
+
+    // 协程在第一个co_await处挂起，结果通过事件循环送回
+    QVERIFY(!task.isDone());
+    QTRY_VERIFY_WITH_TIMEOUT(observed.finished, 5000);
+
+    QVERIFY(observed.workerThread != QThread::currentThread());
+    QCOMPARE(observed.resumedOn, QThread::currentThread());
+    QCOMPARE(observed.affected, 3);
+    QVERIFY(observed.missingThrew);
+    QVERIFY(task.isDone());
+
+    factory->close();
+}
+
+void TestCoro::testAwaitAfterFactoryClose()
+{
+    QSharedPointer<SessionFactory> factory = SessionFactory::create(createTestConfig());
+    QSharedPointer<Coro::AsyncSession> session = Coro::AsyncSession::create(factory);
+    factory->close();
+
+    bool threw = false;
+    bool finished = false;
+    auto body = [&]() -> Coro::Task<> {
+        try {
+            co_await session->selectOne(QStringLiteral("Missing.statement"));
+        } catch (const ConnectionException&) {
+            threw = true;
+        }
+        finished = true;
+    };
+    Coro::Task<> task = body();
+
+    QTRY_VERIFY_WITH_TIMEOUT(finished, 5000);
+    QVERIFY(threw);
+
+    QVERIFY_EXCEPTION_THROWN(Coro::AsyncSession::create(factory), ConfigurationException);
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    TestCoro test;
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "run_coro_test.moc"
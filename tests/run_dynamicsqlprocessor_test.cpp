@@ -2,6 +2,7 @@
 #include <QVariantMap>
 #include <QVariantList>
 #include "QtMyBatisORM/dynamicsqlprocessor.h"
+#include "QtMyBatisORM/qtmybatisexception.h"
 
 class TestDynamicSqlProcessor : public QObject
 {
@@ -17,6 +18,13 @@ private slots:
     void testChooseWhenOtherwise();
     void testWhereClause();
     void testSetClause();
+    void testNestedElements();
+    void testTrimElement();
+    void testLiteralLessThan();
+    void testCompiledTreeReuse();
+    void testShapeCache();
+    void testTestExpressions();
+    void testInvalidTestExpression();
 
 private:
     QtMyBatisORM::DynamicSqlProcessor* processor;
@@ -71,12 +79,30 @@ void TestDynamicSqlProcessor::testForeachLoop()
     QVariantList ids;
     ids << 1 << 2 << 3;
     params["ids"] = ids;
-    // 为了让参数替换工作，我们需要添加id参数
-    params["id"] = "placeholder";
     
+    // 每个元素绑定到带下标的占位符
     QString result = processor->process(sql, params);
-    QString expected = "SELECT * FROM users WHERE id IN (:id,:id,:id)";
+    QString expected = "SELECT * FROM users WHERE id IN (:ids_0,:ids_1,:ids_2)";
     QCOMPARE(result, expected);
+    
+    // 按2的幂补齐：3个元素与4个元素共用同一条语句
+    QString padded = "SELECT * FROM users WHERE id IN <foreach collection=\"ids\" item=\"id\" open=\"(\" close=\")\" "
+                     "separator=\",\" padToBucket=\"true\">#{id}</foreach>";
+    QCOMPARE(processor->process(padded, params),
+             QString("SELECT * FROM users WHERE id IN (:ids_0,:ids_1,:ids_2,:ids_3)"));
+    params["ids"] = QVariantList{1, 2, 3, 4};
+    QCOMPARE(processor->process(padded, params),
+             QString("SELECT * FROM users WHERE id IN (:ids_0,:ids_1,:ids_2,:ids_3)"));
+    params["ids"] = QVariantList{1};
+    QCOMPARE(processor->process(padded, params), QString("SELECT * FROM users WHERE id IN (:ids_0)"));
+    
+    // 带点的集合路径：占位符前缀中的点替换为下划线
+    QString dotted = "SELECT * FROM tags WHERE name IN <foreach collection=\"row.tags\" item=\"tag\" open=\"(\" "
+                     "close=\")\" separator=\",\">#{tag}</foreach>";
+    QVariantMap rowParams;
+    rowParams["row.tags"] = QVariantList{"a", "b"};
+    QCOMPARE(processor->process(dotted, rowParams),
+             QString("SELECT * FROM tags WHERE name IN (:row_tags_0,:row_tags_1)"));
 }
 
 void TestDynamicSqlProcessor::testChooseWhenOtherwise()
@@ -137,5 +163,167 @@ void TestDynamicSqlProcessor::testSetClause()
     QCOMPARE(result, expected);
 }
 
+void TestDynamicSqlProcessor::testNestedElements()
+{
+    QString sql = "SELECT * FROM users <where>"
+                  "<if test=\"name\">AND name = #{name} </if>"
+                  "<if test=\"ids\">AND id IN <foreach collection=\"ids\" item=\"id\" open=\"(\" close=\")\" separator=\",\">"
+                  "<if test=\"id\">#{id}</if></foreach></if>"
+                  "</where>";
+    
+    QVariantMap params;
+    QVariantList ids;
+    ids << 1 << 2;
+    params["ids"] = ids;
+    
+    QString result = processor->process(sql, params);
+    QString expected = "SELECT * FROM users WHERE id IN (:ids_0,:ids_1)";
+    QCOMPARE(result, expected);
+}
+
+void TestDynamicSqlProcessor::testTrimElement()
+{
+    QString sql = "SELECT * FROM users <trim prefix=\"WHERE\" prefixOverrides=\"AND |OR \">"
+                  "<if test=\"name\">OR name = #{name}</if></trim>";
+    
+    QVariantMap params;
+    params["name"] = "John";
+    QCOMPARE(processor->process(sql, params), QString("SELECT * FROM users WHERE name = :name"));
+    
+    params.clear();
+    QCOMPARE(processor->process(sql, params), QString("SELECT * FROM users"));
+}
+
+void TestDynamicSqlProcessor::testLiteralLessThan()
+{
+    // 普通的小于号和未知标签按SQL文本保留
+    QString sql = "SELECT * FROM users WHERE age <#{age} AND score < 10 <if test=\"name\">AND name = #{name}</if>";
+    
+    QVariantMap params;
+    params["age"] = 30;
+    params["name"] = "John";
+    
+    QString result = processor->process(sql, params);
+    QString expected = "SELECT * FROM users WHERE age <:age AND score < 10 AND name = :name";
+    QCOMPARE(result, expected);
+}
+
+void TestDynamicSqlProcessor::testCompiledTreeReuse()
+{
+    QString sql = "SELECT * FROM users WHERE 1=1 <if test=\"name\">AND name = #{name}</if>";
+    
+    QtMyBatisORM::SqlNodePtr first = QtMyBatisORM::DynamicSqlProcessor::compile(sql);
+    QtMyBatisORM::SqlNodePtr second = QtMyBatisORM::DynamicSqlProcessor::compile(sql);
+    QVERIFY(first);
+    QCOMPARE(first.data(), second.data());
+    QVERIFY(first->isDynamic());
+    
+    QVariantMap params;
+    params["name"] = "John";
+    QCOMPARE(QtMyBatisORM::DynamicSqlProcessor::process(first, params),
+             QString("SELECT * FROM users WHERE 1=1 AND name = :name"));
+    
+    QVERIFY(!QtMyBatisORM::DynamicSqlProcessor::compile("SELECT * FROM users")->isDynamic());
+}
+
+void TestDynamicSqlProcessor::testShapeCache()
+{
+    QString sql = "SELECT * FROM users <where><if test=\"name != null\">AND name = #{name}</if>"
+                  "<if test=\"ids != null\">AND id IN <foreach collection=\"ids\" item=\"id\" "
+                  "open=\"(\" separator=\",\" close=\")\">#{id}</foreach></if></where>";
+    QtMyBatisORM::SqlNodePtr root = QtMyBatisORM::DynamicSqlProcessor::compile(sql);
+    
+    auto shapeOf = [&root](const QVariantMap& params) {
+        QtMyBatisORM::DynamicContext context(params);
+        QtMyBatisORM::SqlShape shape;
+        root->appendShape(context, shape);
+        return shape.key();
+    };
+    
+    QVariantMap first;
+    first["name"] = "John";
+    first["ids"] = QVariantList{1, 2};
+    QVariantMap second;
+    second["name"] = "Jane";
+    second["ids"] = QVariantList{7, 8};
+    QVariantMap longer = second;
+    longer["ids"] = QVariantList{7, 8, 9};
+    QVariantMap withoutName;
+    withoutName["ids"] = QVariantList{1, 2};
+    
+    // 只有分支取值和集合长度参与签名
+    QCOMPARE(shapeOf(first), shapeOf(second));
+    QVERIFY(shapeOf(first) != shapeOf(longer));
+    QVERIFY(shapeOf(first) != shapeOf(withoutName));
+    
+    // 缓存结果与直接生成的SQL一致
+    for (const QVariantMap& params : {first, second, longer, withoutName, first}) {
+        QCOMPARE(QtMyBatisORM::DynamicSqlProcessor::processCached(sql, params),
+                 QtMyBatisORM::DynamicSqlProcessor::process(root, params));
+    }
+}
+
+void TestDynamicSqlProcessor::testTestExpressions()
+{
+    auto test = [](const QString& expression, const QVariantMap& params) {
+        QtMyBatisORM::DynamicContext context(params);
+        return QtMyBatisORM::SqlExpression::parse(expression).evaluate(context);
+    };
+    
+    QVariantMap params;
+    params["status"] = "ACTIVE";
+    params["grade"] = 3;
+    params["name"] = "";
+    params["score"] = 7.5;
+    params["ids"] = QVariantList{1, 2};
+    params["empty"] = QVariantList();
+    params["flag"] = false;
+    params["user"] = QVariantMap{{"address", QVariantMap{{"city", "Paris"}}}, {"age", 30}};
+    
+    // 比较与布尔运算
+    QVERIFY(test("status == 'ACTIVE' and grade > 2", params));
+    QVERIFY(!test("status == 'ACTIVE' and grade > 3", params));
+    QVERIFY(test("status != \"INACTIVE\" && grade >= 3", params));
+    QVERIFY(test("grade lt 4 or missing == null", params));
+    QVERIFY(test("score > 7 and score < 8 and score == 7.5", params));
+    QVERIFY(test("!(grade <= 2)", params));
+    QVERIFY(test("not flag", params));
+    QVERIFY(test("grade == '3'", params));
+    QVERIFY(test("grade > -1", params));
+    
+    // null与空字符串
+    QVERIFY(!test("name != null and name != ''", params));
+    QVERIFY(test("missing == null", params));
+    QVERIFY(!test("missing != null", params));
+    QVERIFY(!test("missing > 0", params));
+    QVERIFY(!test("missing", params));
+    QVERIFY(test("name", params));
+    
+    // 集合方法与属性路径
+    QVERIFY(test("ids.size() > 0", params));
+    QVERIFY(test("ids != null and !ids.isEmpty()", params));
+    QVERIFY(test("empty.isEmpty()", params));
+    QVERIFY(test("missing.isEmpty()", params));
+    QVERIFY(test("status.length() == 6 and status.trim() == 'ACTIVE'", params));
+    QVERIFY(test("user.address.city == 'Paris' and user.age >= 18", params));
+    QVERIFY(test("user.address.zip == null", params));
+    
+    // 在动态SQL中使用
+    QString sql = "SELECT * FROM users <where><if test=\"status == 'ACTIVE' and grade &gt; 2\">AND grade = #{grade} </if>"
+                  "<if test=\"ids.size() &gt; 0\">AND id IN <foreach collection=\"ids\" item=\"id\" open=\"(\" "
+                  "separator=\",\" close=\")\"><if test=\"id != 1\">#{id}</if></foreach></if></where>";
+    QCOMPARE(processor->process(sql, params), QString("SELECT * FROM users WHERE grade = :grade AND id IN (:ids_1)"));
+}
+
+void TestDynamicSqlProcessor::testInvalidTestExpression()
+{
+    QVERIFY_EXCEPTION_THROWN(QtMyBatisORM::SqlExpression::parse("grade >"), QtMyBatisORM::MappingException);
+    QVERIFY_EXCEPTION_THROWN(QtMyBatisORM::SqlExpression::parse("name == 'open"), QtMyBatisORM::MappingException);
+    QVERIFY_EXCEPTION_THROWN(QtMyBatisORM::SqlExpression::parse("ids.contains(1)"), QtMyBatisORM::MappingException);
+    QVERIFY_EXCEPTION_THROWN(QtMyBatisORM::SqlExpression::parse(""), QtMyBatisORM::MappingException);
+    QVERIFY_EXCEPTION_THROWN(QtMyBatisORM::DynamicSqlProcessor::compile("SELECT 1 <if test=\"a ==\">x</if>"),
+                             QtMyBatisORM::MappingException);
+}
+
 QTEST_MAIN(TestDynamicSqlProcessor)
 #include "run_dynamicsqlprocessor_test.moc"
\ No newline at end of file
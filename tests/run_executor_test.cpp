@@ -6,11 +6,49 @@
 #include <QSharedPointer>
 #include "QtMyBatisORM/executor.h"
 #include "QtMyBatisORM/cachemanager.h"
+#include "QtMyBatisORM/preparedstatementcache.h"
 #include "QtMyBatisORM/qtmybatisexception.h"
 #include "QtMyBatisORM/datamodels.h"
 
 using namespace QtMyBatisORM;
 
+class RecordingInterceptor : public Interceptor
+{
+public:
+    bool intercept(Invocation& invocation) override
+    {
+        phases.append(invocation.phase());
+        return invocation.proceed();
+    }
+    
+    QList<InterceptPhase> phases;
+};
+
+// 多租户式过滤：改写查询并补充参数
+class MinAgeInterceptor : public Interceptor
+{
+public:
+    bool intercept(Invocation& invocation) override
+    {
+        if (invocation.phase() == InterceptPhase::Prepare && invocation.sql().startsWith("SELECT")) {
+            invocation.sql() += QStringLiteral(" AND age >= :minAge");
+        } else if (invocation.phase() == InterceptPhase::Parameterize && invocation.sql().contains(":minAge")) {
+            invocation.parameters().insert("minAge", 30);
+        }
+        return invocation.proceed();
+    }
+};
+
+class ReadOnlyInterceptor : public Interceptor
+{
+public:
+    bool intercept(Invocation& invocation) override
+    {
+        // 不调用proceed即跳过该阶段
+        return invocation.phase() == InterceptPhase::Update ? false : invocation.proceed();
+    }
+};
+
 class TestExecutor : public QObject
 {
     Q_OBJECT
@@ -33,6 +71,11 @@ private slots:
     void testInvalidConnection();
     void testSqlExecutionError();
     void testCacheKeyGeneration();
+    void testPreparedStatementCache();
+    void testUpdateBatch();
+    void testMultiRowInsert();
+    void testQueryCursor();
+    void testInterceptors();
 
 private:
     void setupTestDatabase();
@@ -286,6 +329,17 @@ void TestExecutor::testQueryListWithCache()
     QVariantMap firstRecord1 = result1[0].toMap();
     QVariantMap firstRecord2 = result2[0].toMap();
     QCOMPARE(firstRecord1["name"].toString(), firstRecord2["name"].toString());
+    
+    // 命中时返回缓存中隐式共享的列表，不重新构造行
+    QVariantList result3 = m_executor->queryListWithCache(statementId, sql, parameters);
+    QVERIFY(result3.constData() == result2.constData());
+    
+    // ResultSet形式单独缓存，不影响列表缓存
+    ResultSet compact = m_executor->queryResultSetWithCache(statementId, sql, parameters);
+    QCOMPARE(compact.rowCount(), 3);
+    QCOMPARE(m_executor->queryResultSetWithCache(statementId, sql, parameters).cells().constData(),
+             compact.cells().constData());
+    QVERIFY(m_executor->queryListWithCache(statementId, sql, parameters).constData() == result2.constData());
 }
 
 void TestExecutor::testInvalidConnection()
@@ -338,6 +392,235 @@ void TestExecutor::testCacheKeyGeneration()
     QVERIFY(!result2.isNull());
 }
 
+void TestExecutor::testPreparedStatementCache()
+{
+    QSharedPointer<PreparedStatementCache> statementCache = QSharedPointer<PreparedStatementCache>::create(2);
+    m_executor->setPreparedStatementCache(statementCache);
+    
+    QString sql = "SELECT * FROM test_users WHERE name = :name";
+    QVariantMap parameters;
+    parameters["name"] = "Alice";
+    
+    // 第一次执行需要预编译，第二次复用已缓存的语句
+    QCOMPARE(m_executor->query(sql, parameters).toMap()["age"].toInt(), 25);
+    parameters["name"] = "Bob";
+    QCOMPARE(m_executor->query(sql, parameters).toMap()["age"].toInt(), 30);
+    
+    PreparedStatementStats stats = m_executor->getPreparedStatementStats();
+    QCOMPARE(stats.missCount, 1);
+    QCOMPARE(stats.hitCount, 1);
+    QCOMPARE(stats.currentSize, 1);
+    
+    // 另一个Executor共享同一连接的缓存时同样命中
+    QSharedPointer<Executor> otherExecutor = QSharedPointer<Executor>::create(m_connection, m_cacheManager);
+    otherExecutor->setPreparedStatementCache(statementCache);
+    QVERIFY(!otherExecutor->query(sql, parameters).isNull());
+    QCOMPARE(statementCache->getStats().hitCount, 2);
+    
+    // 超出容量时按LRU驱逐
+    m_executor->query("SELECT COUNT(*) FROM test_users");
+    m_executor->query("SELECT MAX(age) FROM test_users");
+    stats = statementCache->getStats();
+    QCOMPARE(stats.currentSize, 2);
+    QCOMPARE(stats.evictionCount, 1);
+    
+    // 只进模式在prepare时确定，两种模式的语句分别缓存，归还后不再修改
+    const QString ageSql = "SELECT name FROM test_users WHERE age >= :age";
+    QSqlDatabase db = *m_connection;
+    QSqlQuery forwardOnly = statementCache->acquire(ageSql, db, true);
+    QVERIFY(forwardOnly.isForwardOnly());
+    forwardOnly.bindValue(":age", 0);
+    QVERIFY(forwardOnly.exec());
+    statementCache->release(ageSql, forwardOnly);
+    QSqlQuery scrollable = statementCache->acquire(ageSql, db);
+    QVERIFY(!scrollable.isForwardOnly());
+    statementCache->release(ageSql, scrollable);
+    const int hitsBefore = statementCache->getStats().hitCount;
+    QSqlQuery reused = statementCache->acquire(ageSql, db, true);
+    QVERIFY(reused.isForwardOnly());
+    QCOMPARE(statementCache->getStats().hitCount, hitsBefore + 1);
+    statementCache->release(ageSql, reused);
+    
+    int streamed = 0;
+    m_executor->queryCursor(ageSql, {{"age", 0}}, [&streamed](const QVariantMap&) { ++streamed; return true; });
+    QCOMPARE(m_executor->queryList(ageSql, {{"age", 0}}).size(), streamed);
+    
+    statementCache->clear();
+}
+
+void TestExecutor::testUpdateBatch()
+{
+    // 静态SQL：整批一次执行
+    QString insertSql = "INSERT INTO test_users (name, email, age) VALUES (:name, :email, :age)";
+    QList<QVariantMap> rows;
+    for (int i = 0; i < 5; ++i) {
+        QVariantMap row;
+        row["name"] = QString("Batch%1").arg(i);
+        row["email"] = QString("batch%1@example.com").arg(i);
+        row["age"] = 40 + i;
+        rows.append(row);
+    }
+    
+    QCOMPARE(m_executor->updateBatch("User.insert", insertSql, rows).totalAffected, 5);
+    QCOMPARE(m_executor->query("SELECT COUNT(*) AS cnt FROM test_users WHERE name LIKE 'Batch%'").toInt(), 5);
+    
+    // 动态SQL：不同分支的行分别执行，受影响行数累加
+    QString updateSql = "UPDATE test_users <set><if test=\"age\">age = #{age},</if>"
+                        "<if test=\"email\">email = #{email},</if></set> WHERE name = #{name}";
+    QList<QVariantMap> updates;
+    QVariantMap ageOnly;
+    ageOnly["name"] = "Batch0";
+    ageOnly["age"] = 60;
+    QVariantMap emailOnly;
+    emailOnly["name"] = "Batch1";
+    emailOnly["email"] = "changed@example.com";
+    QVariantMap noMatch;
+    noMatch["name"] = "Nobody";
+    noMatch["age"] = 1;
+    updates << ageOnly << emailOnly << noMatch;
+    
+    BatchResult updateResult = m_executor->updateBatch("User.update", updateSql, updates);
+    QCOMPARE(updateResult.totalAffected, 2);
+    QCOMPARE(updateResult.chunkAffectedRows, QList<int>({1, 1, 0}));
+    QVariantMap params;
+    params["name"] = "Batch0";
+    QCOMPARE(m_executor->query("SELECT age FROM test_users WHERE name = :name", params).toInt(), 60);
+    
+    // 缺少参数的行使整批失败
+    QVariantMap incomplete;
+    incomplete["name"] = "Broken";
+    QList<QVariantMap> broken = rows.mid(0, 1);
+    broken.append(incomplete);
+    QVERIFY_EXCEPTION_THROWN(m_executor->updateBatch("User.insert", insertSql, broken), QtMyBatisException);
+    
+    QCOMPARE(m_executor->updateBatch("User.insert", insertSql, QList<QVariantMap>()).totalAffected, 0);
+}
+
+void TestExecutor::testMultiRowInsert()
+{
+    QString insertSql = "INSERT INTO test_users (name, email, age) VALUES (#{name}, #{email}, #{age})";
+    QList<QVariantMap> rows;
+    for (int i = 0; i < 2500; ++i) {
+        QVariantMap row;
+        row["name"] = QString("Multi%1").arg(i);
+        row["email"] = QString("multi%1@example.com").arg(i);
+        row["age"] = i % 100;
+        rows.append(row);
+    }
+    
+    // 每块最多1000行，2500行分为3块
+    BatchResult result = m_executor->updateBatch("User.insert", insertSql, rows, BatchStrategy::MultiRowValues);
+    QCOMPARE(result.totalAffected, 2500);
+    QCOMPARE(result.chunkAffectedRows, QList<int>({1000, 1000, 500}));
+    QCOMPARE(m_executor->query("SELECT COUNT(*) FROM test_users WHERE name LIKE 'Multi%'").toInt(), 2500);
+    
+    QVariantMap params;
+    params["name"] = "Multi1234";
+    QCOMPARE(m_executor->query("SELECT age FROM test_users WHERE name = :name", params).toInt(), 34);
+    
+    // 非INSERT语句回退到execBatch
+    QList<QVariantMap> deletes;
+    deletes << params;
+    result = m_executor->updateBatch("User.delete", "DELETE FROM test_users WHERE name = #{name}",
+                                     deletes, BatchStrategy::MultiRowValues);
+    QCOMPARE(result.totalAffected, 1);
+    QCOMPARE(result.chunkAffectedRows.size(), 1);
+}
+
+void TestExecutor::testQueryCursor()
+{
+    QString insertSql = "INSERT INTO test_users (name, email, age) VALUES (#{name}, #{email}, #{age})";
+    QList<QVariantMap> rows;
+    for (int i = 0; i < 12000; ++i) {
+        QVariantMap row;
+        row["name"] = QString("Cursor%1").arg(i);
+        row["email"] = QString("cursor%1@example.com").arg(i);
+        row["age"] = 20;
+        rows.append(row);
+    }
+    QCOMPARE(m_executor->updateBatch("User.insert", insertSql, rows, BatchStrategy::MultiRowValues).totalAffected, 12000);
+    
+    // 超过原10000行上限的结果集完整返回
+    QString selectSql = "SELECT id, name FROM test_users WHERE age = #{age} ORDER BY id";
+    QVariantMap params;
+    params["age"] = 20;
+    QCOMPARE(m_executor->queryList(selectSql, params).size(), 12000);
+    
+    // 逐行回调遍历
+    int visited = 0;
+    QString lastName;
+    int count = m_executor->queryCursor(selectSql, params, [&](const QVariantMap& row) {
+        ++visited;
+        lastName = row["name"].toString();
+        return true;
+    });
+    QCOMPARE(count, 12000);
+    QCOMPARE(visited, 12000);
+    QCOMPARE(lastName, QString("Cursor11999"));
+    
+    // 回调返回false提前结束
+    count = m_executor->queryCursor(selectSql, params, [](const QVariantMap&) {
+        return false;
+    });
+    QCOMPARE(count, 1);
+    
+    // 回调抛出异常后连接仍可用
+    QVERIFY_EXCEPTION_THROWN(
+        m_executor->queryCursor(selectSql, params, [](const QVariantMap&) -> bool {
+            throw SqlExecutionException("stop");
+        }),
+        QtMyBatisException);
+    QCOMPARE(m_executor->update("DELETE FROM test_users WHERE age = :age", params), 12000);
+}
+
+void TestExecutor::testInterceptors()
+{
+    QVERIFY(!m_executor->hasInterceptors());
+    
+    auto recorder = QSharedPointer<RecordingInterceptor>::create();
+    m_executor->setInterceptors({recorder, QSharedPointer<MinAgeInterceptor>::create()});
+    QVERIFY(m_executor->hasInterceptors());
+    
+    // 查询依次经过Prepare、Parameterize、Query三个阶段
+    QVariantList results = m_executor->queryList("SELECT * FROM test_users WHERE 1 = 1");
+    QCOMPARE(recorder->phases, QList<InterceptPhase>({InterceptPhase::Prepare, InterceptPhase::Parameterize,
+                                                      InterceptPhase::Query}));
+    QCOMPARE(results.size(), 2);
+    
+    recorder->phases.clear();
+    QCOMPARE(m_executor->update("UPDATE test_users SET age = age + 1 WHERE name = :name", {{"name", "Alice"}}), 1);
+    QCOMPARE(recorder->phases.last(), InterceptPhase::Update);
+    
+    // 有拦截器时不读写结果缓存：改写后的SQL不在缓存键中，换一条链必须重新执行
+    const QString allSql = QStringLiteral("SELECT * FROM test_users WHERE 1 = 1");
+    QCOMPARE(m_executor->queryListWithCache("User.tenantScoped", allSql).size(), 2);
+    m_executor->setInterceptors({recorder});
+    recorder->phases.clear();
+    QCOMPARE(m_executor->queryListWithCache("User.tenantScoped", allSql).size(), 3);
+    QCOMPARE(recorder->phases.last(), InterceptPhase::Query);
+    
+    // 批量写操作逐行经过拦截器链，多行VALUES策略也不例外
+    const QString insertSql = QStringLiteral("INSERT INTO test_users (name, age) VALUES (#{name}, #{age})");
+    const QList<QVariantMap> rows = {{{"name", "Dave"}, {"age", 40}}, {{"name", "Erin"}, {"age", 41}}};
+    for (BatchStrategy strategy : {BatchStrategy::ExecBatch, BatchStrategy::MultiRowValues}) {
+        recorder->phases.clear();
+        QCOMPARE(m_executor->updateBatch("User.insert", insertSql, rows, strategy).totalAffected, 2);
+        QCOMPARE(recorder->phases.count(InterceptPhase::Prepare), 2);
+        QCOMPARE(recorder->phases.count(InterceptPhase::Update), 2);
+    }
+    QCOMPARE(m_executor->update("DELETE FROM test_users WHERE age >= 40", {}), 4);
+    
+    // 拦截器可以跳过执行
+    m_executor->setInterceptors({QSharedPointer<ReadOnlyInterceptor>::create()});
+    QVERIFY_EXCEPTION_THROWN(m_executor->update("DELETE FROM test_users", {}), SqlExecutionException);
+    QCOMPARE(m_executor->query("SELECT COUNT(*) AS total FROM test_users").toMap().value("total").toInt(), 3);
+    
+    // 空链恢复为无拦截器
+    m_executor->setInterceptors({});
+    QVERIFY(!m_executor->hasInterceptors());
+    QCOMPARE(m_executor->queryList("SELECT * FROM test_users").size(), 3);
+}
+
 int main(int argc, char *argv[])
 {
     QCoreApplication app(argc, argv);
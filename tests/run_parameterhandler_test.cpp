@@ -40,6 +40,9 @@ private slots:
     void testJsonConversion();
     void testParameterValidation();
     void testErrorHandling();
+    void testBindingPlan();
+    void testBindingPlanExecution();
+    void testForeachItemBinding();
 
 private:
     void setupTestDatabase();
@@ -367,6 +370,112 @@ void TestParameterHandler::testErrorHandling()
     QVERIFY_EXCEPTION_THROWN(m_handler->setParameters(query, parameters), MappingException);
 }
 
+void TestParameterHandler::testBindingPlan()
+{
+    // 命名占位符：重复名称只记录一次，引号内和 :: 类型转换不是占位符
+    BindingPlan plan = BindingPlan::build(
+        "SELECT * FROM users WHERE id = :id AND note <> ':skip' AND parent = :id AND age::text = :age");
+    QCOMPARE(plan.mode, BindingPlan::Mode::Named);
+    QCOMPARE(plan.names, QStringList({"id", "age"}));
+    QCOMPARE(plan.placeholders, QStringList({":id", ":age"}));
+    QCOMPARE(plan.positions, QVector<int>({0, 0, 1}));
+    QVERIFY(plan.hasDuplicateNames);
+    
+    // 位置占位符
+    plan = BindingPlan::build("SELECT * FROM users WHERE name = ? AND note = '?' AND age = ?");
+    QCOMPARE(plan.mode, BindingPlan::Mode::Positional);
+    QCOMPARE(plan.positionalCount, 2);
+    
+    // 无占位符
+    plan = BindingPlan::build("SELECT COUNT(*) FROM users");
+    QCOMPARE(plan.mode, BindingPlan::Mode::None);
+    
+    // 同一SQL共享同一个计划
+    QString sql = "SELECT * FROM users WHERE name = :name";
+    QCOMPARE(ParameterHandler::bindingPlan(sql).data(), ParameterHandler::bindingPlan(sql).data());
+}
+
+void TestParameterHandler::testBindingPlanExecution()
+{
+    QSqlQuery setup(*m_connection);
+    QVERIFY(setup.exec("CREATE TABLE plan_users (id INTEGER, parent INTEGER, name TEXT)"));
+    QVERIFY(setup.exec("INSERT INTO plan_users VALUES (1, 1, 'Alice'), (2, 1, 'Bob'), (3, 3, 'Carol')"));
+    
+    // 不重复的命名占位符按位置绑定
+    QSqlQuery query(*m_connection);
+    QVERIFY(query.prepare("SELECT name FROM plan_users WHERE id = :id AND name = :name"));
+    QVariantMap parameters;
+    parameters["name"] = "Bob";
+    parameters["id"] = 2;
+    m_handler->setParameters(query, parameters);
+    QVERIFY2(query.exec(), qPrintable(query.lastError().text()));
+    QVERIFY(query.next());
+    QCOMPARE(query.value(0).toString(), QString("Bob"));
+    
+    // 重复的命名占位符
+    QSqlQuery duplicate(*m_connection);
+    QVERIFY(duplicate.prepare("SELECT name FROM plan_users WHERE id = :id AND parent = :id"));
+    parameters.clear();
+    parameters["id"] = 3;
+    m_handler->setParameters(duplicate, parameters);
+    QVERIFY2(duplicate.exec(), qPrintable(duplicate.lastError().text()));
+    QVERIFY(duplicate.next());
+    QCOMPARE(duplicate.value(0).toString(), QString("Carol"));
+    
+    QVERIFY(setup.exec("DROP TABLE plan_users"));
+}
+
+void TestParameterHandler::testForeachItemBinding()
+{
+    QSqlQuery setup(*m_connection);
+    QVERIFY(setup.exec("CREATE TABLE foreach_users (id INTEGER, name TEXT)"));
+    QVERIFY(setup.exec("INSERT INTO foreach_users VALUES (1, 'Alice'), (2, 'Bob'), (3, 'Carol'), (4, 'Dave')"));
+    
+    // 集合名_下标 绑定到集合元素，补齐的下标重复最后一个元素
+    QSqlQuery query(*m_connection);
+    QVERIFY(query.prepare("SELECT name FROM foreach_users WHERE id IN (:ids_0,:ids_1,:ids_2,:ids_3) ORDER BY id"));
+    QVariantMap parameters;
+    parameters["ids"] = QVariantList{2, 3, 1};
+    m_handler->setParameters(query, parameters);
+    QVERIFY2(query.exec(), qPrintable(query.lastError().text()));
+    QStringList names;
+    while (query.next()) {
+        names.append(query.value(0).toString());
+    }
+    QCOMPARE(names, QStringList({"Alice", "Bob", "Carol"}));
+    
+    // 普通参数优先于集合元素
+    QSqlQuery explicitParam(*m_connection);
+    QVERIFY(explicitParam.prepare("SELECT name FROM foreach_users WHERE id = :ids_0"));
+    parameters["ids_0"] = 4;
+    m_handler->setParameters(explicitParam, parameters);
+    QVERIFY(explicitParam.exec());
+    QVERIFY(explicitParam.next());
+    QCOMPARE(explicitParam.value(0).toString(), QString("Dave"));
+    
+    // 带点的集合名以下划线形式出现在占位符中，同样解析到集合元素
+    QSqlQuery dotted(*m_connection);
+    QVERIFY(dotted.prepare("SELECT name FROM foreach_users WHERE id IN (:row_ids_0,:row_ids_1) ORDER BY id"));
+    parameters.clear();
+    parameters["row.ids"] = QVariantList{4, 1};
+    m_handler->setParameters(dotted, parameters);
+    QVERIFY2(dotted.exec(), qPrintable(dotted.lastError().text()));
+    names.clear();
+    while (dotted.next()) {
+        names.append(dotted.value(0).toString());
+    }
+    QCOMPARE(names, QStringList({"Alice", "Dave"}));
+    
+    // 空集合不能解析占位符
+    QSqlQuery empty(*m_connection);
+    QVERIFY(empty.prepare("SELECT name FROM foreach_users WHERE id IN (:names_0)"));
+    parameters.clear();
+    parameters["names"] = QVariantList();
+    QVERIFY_EXCEPTION_THROWN(m_handler->setParameters(empty, parameters), MappingException);
+    
+    QVERIFY(setup.exec("DROP TABLE foreach_users"));
+}
+
 int main(int argc, char *argv[])
 {
     QCoreApplication app(argc, argv);
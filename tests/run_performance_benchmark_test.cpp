@@ -1,11 +1,25 @@
 #include <QtTest/QtTest>
 #include <QElapsedTimer>
 #include <QDebug>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <algorithm>
 
 #include "QtMyBatisORM/logger.h"
+#include "QtMyBatisORM/executor.h"
+#include "QtMyBatisORM/interceptor.h"
 
 using namespace QtMyBatisORM;
 
+class PassThroughInterceptor : public Interceptor
+{
+public:
+    bool intercept(Invocation& invocation) override
+    {
+        return invocation.proceed();
+    }
+};
+
 class TestPerformanceBenchmark : public QObject
 {
     Q_OBJECT
@@ -17,6 +31,7 @@ private slots:
     // 简化的性能测试
     void testLoggerPerformance();
     void testBasicPerformance();
+    void testEmptyInterceptorChainOverhead();
 
 private:
     QElapsedTimer m_timer;
@@ -68,6 +83,86 @@ void TestPerformanceBenchmark::testBasicPerformance()
     QVERIFY(sum > 0);
 }
 
+void TestPerformanceBenchmark::testEmptyInterceptorChainOverhead()
+{
+    const QString connectionName = QStringLiteral("benchmark_interceptor_connection");
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), connectionName);
+        db.setDatabaseName(QStringLiteral(":memory:"));
+        QVERIFY(db.open());
+        QSqlQuery setup(db);
+        QVERIFY(setup.exec(QStringLiteral("CREATE TABLE bench (id INTEGER PRIMARY KEY, name TEXT)")));
+        QVERIFY(setup.exec(QStringLiteral("INSERT INTO bench (id, name) VALUES (1, 'one')")));
+    }
+    
+    {
+        auto connection = QSharedPointer<QSqlDatabase>::create(QSqlDatabase::database(connectionName));
+        Executor plain(connection, nullptr);
+        Executor intercepted(connection, nullptr);
+        intercepted.setInterceptors({QSharedPointer<PassThroughInterceptor>::create()});
+        
+        // 基线：直接使用QSqlQuery执行同一条预编译语句
+        QSqlQuery raw(*connection);
+        QVERIFY(raw.prepare(QStringLiteral("SELECT name FROM bench WHERE id = :id")));
+        
+        const QString sql = QStringLiteral("SELECT name FROM bench WHERE id = :id");
+        const QVariantMap params = {{QStringLiteral("id"), 1}};
+        const int iterations = 5000;
+        const int rounds = 9;
+        
+        // 交替执行多轮并取每种方式的中位数，降低调度噪声的影响
+        QList<qint64> rawRounds;
+        QList<qint64> emptyRounds;
+        QList<qint64> chainRounds;
+        for (int round = 0; round < rounds; ++round) {
+            m_timer.start();
+            for (int i = 0; i < iterations; ++i) {
+                raw.bindValue(QStringLiteral(":id"), 1);
+                raw.exec();
+                raw.next();
+            }
+            rawRounds.append(m_timer.nsecsElapsed());
+        
+            m_timer.start();
+            for (int i = 0; i < iterations; ++i) {
+                plain.queryValue(sql, params);
+            }
+            emptyRounds.append(m_timer.nsecsElapsed());
+        
+            m_timer.start();
+            for (int i = 0; i < iterations; ++i) {
+                intercepted.queryValue(sql, params);
+            }
+            chainRounds.append(m_timer.nsecsElapsed());
+        }
+        raw.finish();
+        
+        const auto median = [](QList<qint64> samples) {
+            std::sort(samples.begin(), samples.end());
+            return samples.at(samples.size() / 2);
+        };
+        const qint64 rawNs = median(rawRounds);
+        const qint64 emptyNs = median(emptyRounds);
+        const qint64 chainNs = median(chainRounds);
+        
+        qDebug() << "Per query (ns, median of" << rounds << "rounds): raw QSqlQuery" << rawNs / iterations
+                 << "| executor, empty chain" << emptyNs / iterations
+                 << "| executor, one pass-through interceptor" << chainNs / iterations;
+        
+        // 空链不构建Invocation，只有每个阶段一次指针判断
+        QVERIFY(!plain.hasInterceptors());
+        QVERIFY(intercepted.hasInterceptors());
+        
+        // 空链执行的工作是空转拦截器链的子集；留出25%的余量吸收噪声，
+        // 只有空链路径引入了额外开销时才会失败
+        QVERIFY2(emptyNs <= chainNs + chainNs / 4,
+                 qPrintable(QStringLiteral("empty chain %1 ns vs pass-through chain %2 ns per query")
+                            .arg(emptyNs / iterations).arg(chainNs / iterations)));
+        QCOMPARE(plain.queryValue(sql, params), intercepted.queryValue(sql, params));
+    }
+    QSqlDatabase::removeDatabase(connectionName);
+}
+
 void TestPerformanceBenchmark::reportPerformance(const QString& testName, qint64 elapsedMs, int iterations)
 {
     qDebug() << "Performance:" << testName 
@@ -77,6 +172,8 @@ void TestPerformanceBenchmark::reportPerformance(const QString& testName, qint64
 
 int main(int argc, char *argv[])
 {
+    QCoreApplication app(argc, argv);
+    
     TestPerformanceBenchmark test;
     return QTest::qExec(&test, argc, argv);
 }
@@ -27,6 +27,7 @@ private slots:
     void testHandleSingleResultEmpty();
     void testHandleListResult();
     void testHandleListResultEmpty();
+    void testHandleResultSet();
     void testRecordToMap();
     void testConvertFromSqlType();
     void testConvertFromSqlTypeWithTargetTypes();
@@ -183,6 +184,48 @@ void TestResultHandler::testHandleListResultEmpty()
     QVERIFY(results.isEmpty());
 }
 
+void TestResultHandler::testHandleResultSet()
+{
+    QSqlQuery query(*m_connection);
+    query.exec("SELECT name, age FROM test_data ORDER BY id");
+    
+    ResultSet results = m_handler->handleResultSet(query);
+    QCOMPARE(results.rowCount(), 3);
+    QCOMPARE(results.columnCount(), 2);
+    QCOMPARE(results.columnNames(), QStringList({"name", "age"}));
+    QCOMPARE(results.cells().size(), 6);
+    
+    // 按下标和列名访问
+    QCOMPARE(results.columnIndex("age"), 1);
+    QCOMPARE(results.columnIndex("missing"), -1);
+    QCOMPARE(results.value(0, 0).toString(), QString("Alice"));
+    QCOMPARE(results.value(1, "age").toInt(), 30);
+    QVERIFY(results.value(2, "age").isNull());
+    QVERIFY(!results.value(3, 0).isValid());
+    QVERIFY(!results.value(0, "missing").isValid());
+    
+    // 副本共享列头
+    ResultSet copy = results;
+    QVERIFY(&copy.columnNames() == &results.columnNames());
+    
+    // 转换为旧的QVariantList形式
+    QVariantList legacy = results.toVariantList();
+    QCOMPARE(legacy.size(), 3);
+    QCOMPARE(legacy[1].toMap()["name"].toString(), QString("Bob"));
+    QCOMPARE(legacy[1].toMap(), results.rowMap(1));
+    
+    // 可以作为QVariant存入缓存
+    QVariant stored = QVariant::fromValue(results);
+    QCOMPARE(stored.value<ResultSet>().rowCount(), 3);
+    
+    QSqlQuery empty(*m_connection);
+    empty.exec("SELECT name FROM test_data WHERE 1 = 0");
+    ResultSet emptyResults = m_handler->handleResultSet(empty);
+    QVERIFY(emptyResults.isEmpty());
+    QCOMPARE(emptyResults.rowCount(), 0);
+    QCOMPARE(emptyResults.columnCount(), 1);
+}
+
 void TestResultHandler::testRecordToMap()
 {
     QSqlQuery query(*m_connection);
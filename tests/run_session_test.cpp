@@ -7,10 +7,38 @@
 #include "QtMyBatisORM/executor.h"
 #include "QtMyBatisORM/mapperregistry.h"
 #include "QtMyBatisORM/cachemanager.h"
+#include "QtMyBatisORM/batchloader.h"
 #include "QtMyBatisORM/qtmybatisexception.h"
+#include <thread>
 
 using namespace QtMyBatisORM;
 
+struct TestUserRow
+{
+    Q_GADGET
+    Q_PROPERTY(int id MEMBER id)
+    Q_PROPERTY(QString name MEMBER name)
+    Q_PROPERTY(QString emailAddress MEMBER emailAddress)
+
+public:
+    int id = 0;
+    QString name;
+    QString emailAddress;
+};
+
+class TestUserObject : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(int id MEMBER m_id)
+    Q_PROPERTY(QString name MEMBER m_name)
+
+public:
+    explicit TestUserObject(QObject* parent = nullptr) : QObject(parent) {}
+
+    int m_id = 0;
+    QString m_name;
+};
+
 class TestSession : public QObject
 {
     Q_OBJECT
@@ -27,6 +55,16 @@ private slots:
     void testSessionClosure();
     void testErrorHandling();
     void testStatementIdParsing();
+    void testTypedSelect();
+    void testStatementOptions();
+    void testSelectByKeys();
+    void testBatchLoader();
+    void testBatchExecutor();
+    void testBatchUpsert();
+    void testSelectPage();
+    void testQueryTimeoutAndCancellation();
+    void testGeneratedKeys();
+    void testStatementHandles();
 
 private:
     void setupTestDatabase();
@@ -140,6 +178,18 @@ void TestSession::setupTestMappers()
     deleteUser.parameterType = "int";
     userMapper.statements["delete"] = deleteUser;
     
+    StatementConfig selectAliased;
+    selectAliased.id = "selectAliased";
+    selectAliased.sql = "SELECT id, name, email AS email_address FROM users ORDER BY id";
+    selectAliased.type = StatementType::SELECT;
+    userMapper.statements["selectAliased"] = selectAliased;
+    
+    StatementConfig countUsers;
+    countUsers.id = "count";
+    countUsers.sql = "SELECT COUNT(*) FROM users";
+    countUsers.type = StatementType::SELECT;
+    userMapper.statements["count"] = countUsers;
+    
     m_mapperRegistry->registerMapper("UserMapper", userMapper);
 }
 
@@ -290,5 +340,838 @@ void TestSession::testStatementIdParsing()
     );
 }
 
+void TestSession::testTypedSelect()
+{
+    auto session = createTestSession();
+    
+    QVariantList expected = session->selectList("UserMapper.selectAliased");
+    QVERIFY(!expected.isEmpty());
+    
+    // Q_GADGET：列名按snake_case匹配camelCase属性
+    QList<TestUserRow> rows = session->selectList<TestUserRow>("UserMapper.selectAliased");
+    QCOMPARE(rows.size(), expected.size());
+    for (int i = 0; i < rows.size(); ++i) {
+        QVariantMap row = expected[i].toMap();
+        QCOMPARE(rows[i].id, row["id"].toInt());
+        QCOMPARE(rows[i].name, row["name"].toString());
+        QCOMPARE(rows[i].emailAddress, row["email_address"].toString());
+    }
+    
+    QVariantMap params;
+    params["id"] = rows.first().id;
+    std::optional<TestUserRow> one = session->selectOne<TestUserRow>("UserMapper.selectById", params);
+    QVERIFY(one.has_value());
+    QCOMPARE(one->name, rows.first().name);
+    
+    params["id"] = -1;
+    QVERIFY(!session->selectOne<TestUserRow>("UserMapper.selectById", params).has_value());
+    
+    // QObject派生类型
+    QList<QSharedPointer<TestUserObject>> objects = session->selectList<TestUserObject>("UserMapper.selectAliased");
+    QCOMPARE(objects.size(), rows.size());
+    QCOMPARE(objects.first()->m_id, rows.first().id);
+    QCOMPARE(objects.first()->m_name, rows.first().name);
+    
+    // 标量快速路径
+    QCOMPARE(session->selectValue<int>("UserMapper.count"), expected.size());
+    QVERIFY_EXCEPTION_THROWN(session->selectValue<int>("UserMapper.nonExistentStatement"), QtMyBatisException);
+}
+
+void TestSession::testStatementOptions()
+{
+    QSqlQuery setup(m_db);
+    QVERIFY(setup.exec("CREATE TABLE option_items (id INTEGER PRIMARY KEY, label TEXT)"));
+    QVERIFY(setup.exec("INSERT INTO option_items (label) VALUES ('a'), ('b'), ('c')"));
+    
+    MapperConfig optionMapper;
+    optionMapper.namespace_ = "OptionMapper";
+    optionMapper.xmlPath = "test_option_mapper.xml";
+    
+    StatementConfig cached;
+    cached.id = "cached";
+    cached.sql = "SELECT id, label FROM option_items ORDER BY id";
+    cached.type = StatementType::SELECT;
+    cached.useCache = true;
+    optionMapper.statements["cached"] = cached;
+    
+    StatementConfig uncached = cached;
+    uncached.id = "uncached";
+    uncached.useCache = false;
+    optionMapper.statements["uncached"] = uncached;
+    
+    StatementConfig limited = uncached;
+    limited.id = "limited";
+    limited.fetchSize = 1;
+    limited.maxRows = 2;
+    optionMapper.statements["limited"] = limited;
+    
+    StatementConfig quietInsert;
+    quietInsert.id = "quietInsert";
+    quietInsert.sql = "INSERT INTO option_items (label) VALUES (:label)";
+    quietInsert.type = StatementType::INSERT;
+    quietInsert.flushCache = false;
+    optionMapper.statements["quietInsert"] = quietInsert;
+    
+    // 未显式设置时，增删改语句默认刷新缓存
+    StatementConfig flushingInsert = quietInsert;
+    flushingInsert.id = "flushingInsert";
+    flushingInsert.flushCache.reset();
+    optionMapper.statements["flushingInsert"] = flushingInsert;
+    
+    m_mapperRegistry->registerMapper("OptionMapper", optionMapper);
+    
+    auto session = createTestSession();
+    m_cacheManager->clear();
+    m_cacheManager->resetStats();
+    
+    // useCache=false：不生成缓存键，也不访问CacheManager
+    QCOMPARE(session->selectList("OptionMapper.uncached").size(), 3);
+    QCOMPARE(session->selectOne("OptionMapper.uncached").toMap().value("label").toString(), QString("a"));
+    QCOMPARE(m_cacheManager->getStats().totalRequests, 0);
+    QCOMPARE(m_cacheManager->size(), 0);
+    
+    // useCache=true：结果写入缓存，第二次命中
+    const QString cacheKey = m_executor->generateCacheKey("OptionMapper.cached", QVariantMap());
+    QCOMPARE(session->selectList("OptionMapper.cached").size(), 3);
+    QVERIFY(m_cacheManager->contains(cacheKey));
+    QCOMPARE(session->selectList("OptionMapper.cached").size(), 3);
+    QCOMPARE(m_cacheManager->getStats().hitCount, 1);
+    
+    // flushCache=false的写操作保留缓存
+    QVariantMap params;
+    params["label"] = "d";
+    QCOMPARE(session->insert("OptionMapper.quietInsert", params), 1);
+    QVERIFY(m_cacheManager->contains(cacheKey));
+    QCOMPARE(session->selectList("OptionMapper.cached").size(), 3);
+    QCOMPARE(session->selectList("OptionMapper.uncached").size(), 4);
+    
+    // 默认刷新缓存的写操作清除缓存
+    params["label"] = "e";
+    QCOMPARE(session->insert("OptionMapper.flushingInsert", params), 1);
+    QVERIFY(!m_cacheManager->contains(cacheKey));
+    QCOMPARE(session->selectList("OptionMapper.cached").size(), 5);
+    
+    // maxRows限制读取的行数，fetchSize/maxRows均为只进读取
+    QCOMPARE(session->selectList("OptionMapper.limited").size(), 2);
+    QCOMPARE(session->selectResultSet("OptionMapper.limited").rowCount(), 2);
+    int streamed = 0;
+    session->selectCursor("OptionMapper.limited", QVariantMap(), [&](const QVariantMap&) {
+        ++streamed;
+        return true;
+    });
+    QCOMPARE(streamed, 2);
+    QCOMPARE(session->selectList("OptionMapper.limited").first().toMap().value("label").toString(), QString("a"));
+}
+
+void TestSession::testSelectByKeys()
+{
+    QSqlQuery setup(m_db);
+    QVERIFY(setup.exec("CREATE TABLE key_items (id INTEGER PRIMARY KEY, label TEXT)"));
+    QVERIFY(m_db.transaction());
+    QVERIFY(setup.prepare("INSERT INTO key_items (id, label) VALUES (?, ?)"));
+    for (int id = 1; id <= 1500; ++id) {
+        setup.addBindValue(id);
+        setup.addBindValue(QString("item%1").arg(id));
+        QVERIFY(setup.exec());
+    }
+    QVERIFY(m_db.commit());
+    
+    MapperConfig keyMapper;
+    keyMapper.namespace_ = "KeyMapper";
+    keyMapper.xmlPath = "test_key_mapper.xml";
+    
+    StatementConfig findByIds;
+    findByIds.id = "findByIds";
+    findByIds.sql = "SELECT id, label FROM key_items WHERE id IN "
+                    "<foreach collection=\"ids\" item=\"id\" open=\"(\" close=\")\" separator=\",\" "
+                    "padToBucket=\"true\">#{id}</foreach> ORDER BY id";
+    findByIds.type = StatementType::SELECT;
+    keyMapper.statements["findByIds"] = findByIds;
+    m_mapperRegistry->registerMapper("KeyMapper", keyMapper);
+    
+    auto session = createTestSession();
+    
+    QVariantList keys;
+    for (int id = 1; id <= 1500; ++id) {
+        keys.append(id);
+    }
+    keys.append(QVariant());
+    keys.append(7);
+    
+    // 去重、去空后按2的幂分块
+    const QList<QVariantList> chunks = session->splitKeys(keys);
+    QVERIFY(chunks.size() >= 2);
+    const int chunkSize = chunks.first().size();
+    QCOMPARE(chunkSize & (chunkSize - 1), 0);
+    int chunkedKeys = 0;
+    for (int i = 0; i < chunks.size(); ++i) {
+        QVERIFY(i == chunks.size() - 1 ? chunks.at(i).size() <= chunkSize : chunks.at(i).size() == chunkSize);
+        chunkedKeys += chunks.at(i).size();
+    }
+    QCOMPARE(chunkedKeys, 1500);
+    QCOMPARE(chunks.first().first().toInt(), 1);
+    
+    // 空串键照常去重，没有字符串形式的键按值去重
+    const QVariantMap firstComposite{{"id", 1}};
+    const QVariantMap secondComposite{{"id", 2}};
+    const QList<QVariantList> opaqueChunks = session->splitKeys(
+        {QString(""), QString(""), firstComposite, secondComposite, firstComposite});
+    QCOMPARE(opaqueChunks.size(), 1);
+    QCOMPARE(opaqueChunks.first(), QVariantList({QString(""), firstComposite, secondComposite}));
+    
+    QVariantList rows = session->selectByKeys("KeyMapper.findByIds", "ids", keys);
+    QCOMPARE(rows.size(), 1500);
+    QCOMPARE(rows.first().toMap().value("id").toInt(), 1);
+    QCOMPARE(rows.last().toMap().value("id").toInt(), 1500);
+    
+    // 以id为键的结果，缺失的键不出现
+    QHash<QString, QVariantMap> byId = session->selectMapByKeys("KeyMapper.findByIds", "ids",
+                                                                {3, 42, 9999}, "id");
+    QCOMPARE(byId.size(), 2);
+    QCOMPARE(byId.value("42").value("label").toString(), QString("item42"));
+    QVERIFY(!byId.contains("9999"));
+    
+    QVERIFY(session->selectByKeys("KeyMapper.findByIds", "ids", {}).isEmpty());
+    QVERIFY_EXCEPTION_THROWN(session->selectMapByKeys("KeyMapper.findByIds", "ids", {1}, "missing_column"),
+                             SessionException);
+}
+
+void TestSession::testBatchLoader()
+{
+    QSqlQuery setup(m_db);
+    QVERIFY(setup.exec("CREATE TABLE loader_items (id INTEGER PRIMARY KEY, label TEXT)"));
+    QVERIFY(setup.exec("INSERT INTO loader_items (id, label) VALUES (1, 'one'), (2, 'two'), (3, 'three')"));
+    
+    MapperConfig loaderMapper;
+    loaderMapper.namespace_ = "LoaderMapper";
+    loaderMapper.xmlPath = "test_loader_mapper.xml";
+    
+    StatementConfig findByIds;
+    findByIds.id = "findByIds";
+    findByIds.sql = "SELECT id, label FROM loader_items WHERE id IN "
+                    "<foreach collection=\"ids\" item=\"id\" open=\"(\" close=\")\" separator=\",\">#{id}</foreach>";
+    findByIds.type = StatementType::SELECT;
+    loaderMapper.statements["findByIds"] = findByIds;
+    m_mapperRegistry->registerMapper("LoaderMapper", loaderMapper);
+    
+    auto session = createTestSession();
+    BatchLoader* loader = session->loader("LoaderMapper.findByIds", "ids", "id");
+    QCOMPARE(session->loader("LoaderMapper.findByIds", "ids", "id"), loader);
+    
+    // 同一轮事件循环内的查询合并为一次IN查询
+    LoaderResult first = loader->load(1);
+    LoaderResult second = loader->load(2);
+    LoaderResult again = loader->load(1);
+    LoaderResult missing = loader->load(99);
+    QCOMPARE(loader->pendingCount(), 3);
+    QVERIFY(!first.isReady());
+    QTRY_VERIFY(first.isReady());
+    QCOMPARE(loader->dispatchCount(), 1);
+    QCOMPARE(first.value().toMap().value("label").toString(), QString("one"));
+    QCOMPARE(second.value().toMap().value("label").toString(), QString("two"));
+    QCOMPARE(again.value(), first.value());
+    QVERIFY(missing.value().isNull());
+    
+    // 作用域内记忆：已加载的键不再查询
+    QVERIFY(loader->load(2).isReady());
+    QCOMPARE(loader->dispatchCount(), 1);
+    
+    // 读取尚未加载的值时立即执行查询
+    QCOMPARE(loader->load(3).value().toMap().value("label").toString(), QString("three"));
+    QCOMPARE(loader->dispatchCount(), 2);
+    
+    QCOMPARE(loader->loadMany({1, 2, 3}).size(), 3);
+    QCOMPARE(loader->dispatchCount(), 2);
+    
+    // 通过同一Session的写操作清除记忆
+    QCOMPARE(session->execute("UPDATE loader_items SET label = 'uno' WHERE id = 1"), 1);
+    LoaderResult updated = loader->load(1);
+    QVERIFY(!updated.isReady());
+    QCOMPARE(updated.value().toMap().value("label").toString(), QString("uno"));
+    QCOMPARE(loader->dispatchCount(), 3);
+    
+    // 回滚撤销的写操作不能留在记忆中
+    session->beginTransaction();
+    QCOMPARE(session->execute("UPDATE loader_items SET label = 'deux' WHERE id = 2"), 1);
+    QCOMPARE(loader->load(2).value().toMap().value("label").toString(), QString("deux"));
+    session->rollback();
+    LoaderResult rolledBack = loader->load(2);
+    QVERIFY(!rolledBack.isReady());
+    QCOMPARE(rolledBack.value().toMap().value("label").toString(), QString("two"));
+    
+    session->beginTransaction();
+    const QString savepoint = session->setSavepoint();
+    QCOMPARE(session->execute("UPDATE loader_items SET label = 'tres' WHERE id = 3"), 1);
+    QCOMPARE(loader->load(3).value().toMap().value("label").toString(), QString("tres"));
+    session->rollbackToSavepoint(savepoint);
+    QCOMPARE(loader->load(3).value().toMap().value("label").toString(), QString("three"));
+    session->rollback();
+    
+    // 查询失败时每个调用方都收到异常，失败的键不做记忆
+    BatchLoader* broken = session->loader("LoaderMapper.missingStatement", "ids", "id");
+    broken->setAutoDispatch(false);
+    LoaderResult failed = broken->load(1);
+    broken->dispatch();
+    QVERIFY(failed.isReady());
+    QVERIFY_EXCEPTION_THROWN(failed.value(), SessionException);
+    QVERIFY(!broken->load(1).isReady());
+}
+
+void TestSession::testBatchExecutor()
+{
+    QSqlQuery setup(m_db);
+    QVERIFY(setup.exec("CREATE TABLE batch_orders (id INTEGER PRIMARY KEY, customer TEXT)"));
+    QVERIFY(setup.exec("CREATE TABLE batch_order_lines (order_id INTEGER, sku TEXT)"));
+    
+    MapperConfig batchMapper;
+    batchMapper.namespace_ = "BatchMapper";
+    batchMapper.xmlPath = "test_batch_mapper.xml";
+    
+    StatementConfig insertOrder;
+    insertOrder.id = "insertOrder";
+    insertOrder.sql = "INSERT INTO batch_orders (id, customer) VALUES (#{id}, #{customer})";
+    insertOrder.type = StatementType::INSERT;
+    batchMapper.statements["insertOrder"] = insertOrder;
+    
+    StatementConfig insertLine;
+    insertLine.id = "insertLine";
+    insertLine.sql = "INSERT INTO batch_order_lines (order_id, sku) VALUES (#{orderId}, #{sku})";
+    insertLine.type = StatementType::INSERT;
+    batchMapper.statements["insertLine"] = insertLine;
+    
+    StatementConfig renameOrder;
+    renameOrder.id = "renameOrder";
+    renameOrder.sql = "UPDATE batch_orders SET customer = #{customer} WHERE id = #{id}";
+    renameOrder.type = StatementType::UPDATE;
+    batchMapper.statements["renameOrder"] = renameOrder;
+    
+    StatementConfig countOrders;
+    countOrders.id = "countOrders";
+    countOrders.sql = "SELECT COUNT(*) FROM batch_orders";
+    countOrders.type = StatementType::SELECT;
+    countOrders.useCache = false;
+    batchMapper.statements["countOrders"] = countOrders;
+    m_mapperRegistry->registerMapper("BatchMapper", batchMapper);
+    
+    auto session = createTestSession();
+    session->setExecutorType(ExecutorType::Batch);
+    QCOMPARE(session->executorType(), ExecutorType::Batch);
+    
+    auto countRows = [this](const QString& table) {
+        QSqlQuery query(m_db);
+        return query.exec("SELECT COUNT(*) FROM " + table) && query.next() ? query.value(0).toInt() : -1;
+    };
+    
+    // 交错的写操作先排队，返回0
+    for (int id = 1; id <= 3; ++id) {
+        QCOMPARE(session->insert("BatchMapper.insertOrder", {{"id", id}, {"customer", QString("c%1").arg(id)}}), 0);
+        QCOMPARE(session->insert("BatchMapper.insertLine", {{"orderId", id}, {"sku", "a"}}), 0);
+        QCOMPARE(session->insert("BatchMapper.insertLine", {{"orderId", id}, {"sku", "b"}}), 0);
+    }
+    QCOMPARE(session->pendingBatchRows(), 9);
+    QCOMPARE(countRows("batch_orders"), 0);
+    
+    // 连续的同一语句合并为一组，交错的语句按调用顺序各自成组
+    QList<BatchStatementResult> results = session->flushStatements();
+    QCOMPARE(results.size(), 6);
+    QCOMPARE(results[0].statementId, QString("BatchMapper.insertOrder"));
+    QCOMPARE(results[0].rowCount, 1);
+    QCOMPARE(results[0].affectedRows, 1);
+    QCOMPARE(results[1].statementId, QString("BatchMapper.insertLine"));
+    QCOMPARE(results[1].rowCount, 2);
+    QCOMPARE(results[1].affectedRows, 2);
+    QCOMPARE(session->pendingBatchRows(), 0);
+    QCOMPARE(countRows("batch_order_lines"), 6);
+    QVERIFY(session->flushStatements().isEmpty());
+    
+    // 查询前先执行排队的写操作
+    session->insert("BatchMapper.insertOrder", {{"id", 4}, {"customer", "c4"}});
+    QCOMPARE(session->selectOne("BatchMapper.countOrders").toInt(), 4);
+    QCOMPARE(session->pendingBatchRows(), 0);
+    QCOMPARE(session->flushStatements().size(), 1);
+    
+    // 达到阈值时自动执行
+    session->setBatchFlushThreshold(2);
+    session->insert("BatchMapper.insertOrder", {{"id", 5}, {"customer", "c5"}});
+    QCOMPARE(session->pendingBatchRows(), 1);
+    session->insert("BatchMapper.insertOrder", {{"id", 6}, {"customer", "c6"}});
+    QCOMPARE(session->pendingBatchRows(), 0);
+    QCOMPARE(countRows("batch_orders"), 6);
+    session->flushStatements();
+    session->setBatchFlushThreshold(0);
+    
+    // 提交时执行，回滚时丢弃
+    session->beginTransaction();
+    session->insert("BatchMapper.insertOrder", {{"id", 7}, {"customer", "c7"}});
+    session->commit();
+    QCOMPARE(countRows("batch_orders"), 7);
+    
+    session->beginTransaction();
+    session->insert("BatchMapper.insertOrder", {{"id", 8}, {"customer", "c8"}});
+    session->rollback();
+    QCOMPARE(session->pendingBatchRows(), 0);
+    QCOMPARE(countRows("batch_orders"), 7);
+    
+    // 执行失败时整批回滚
+    session->insert("BatchMapper.insertOrder", {{"id", 9}, {"customer", "c9"}});
+    session->insert("BatchMapper.insertOrder", {{"id", 1}, {"customer", "duplicate"}});
+    QVERIFY_EXCEPTION_THROWN(session->flushStatements(), SessionException);
+    QVERIFY(!session->isInTransaction());
+    QCOMPARE(countRows("batch_orders"), 7);
+    
+    // 后面的写操作不会并入更早的分组而越过中间的写操作
+    session->update("BatchMapper.renameOrder", {{"id", 11}, {"customer", "early"}});
+    session->insert("BatchMapper.insertOrder", {{"id", 11}, {"customer", "c11"}});
+    session->update("BatchMapper.renameOrder", {{"id", 11}, {"customer", "late"}});
+    results = session->flushStatements();
+    QCOMPARE(results.size(), 3);
+    QCOMPARE(results[0].affectedRows, 0);
+    QCOMPARE(results[1].affectedRows, 1);
+    QCOMPARE(results[2].affectedRows, 1);
+    QSqlQuery customer(m_db);
+    QVERIFY(customer.exec("SELECT customer FROM batch_orders WHERE id = 11") && customer.next());
+    QCOMPARE(customer.value(0).toString(), QString("late"));
+    
+    session->setExecutorType(ExecutorType::Simple);
+    QCOMPARE(session->insert("BatchMapper.insertOrder", {{"id", 10}, {"customer", "c10"}}), 1);
+}
+
+void TestSession::testBatchUpsert()
+{
+    QSqlQuery setup(m_db);
+    QVERIFY(setup.exec("CREATE TABLE upsert_items (id INTEGER PRIMARY KEY, name TEXT, qty INTEGER)"));
+    QVERIFY(setup.exec("INSERT INTO upsert_items (id, name, qty) VALUES (1, 'one', 1), (2, 'two', 2)"));
+    
+    MapperConfig upsertMapper;
+    upsertMapper.namespace_ = "UpsertMapper";
+    upsertMapper.xmlPath = "test_upsert_mapper.xml";
+    
+    StatementConfig insertItem;
+    insertItem.id = "insertItem";
+    insertItem.sql = "INSERT INTO upsert_items (id, name, qty) VALUES (#{id}, #{name}, #{qty})";
+    insertItem.type = StatementType::INSERT;
+    upsertMapper.statements["insertItem"] = insertItem;
+    
+    StatementConfig findAll;
+    findAll.id = "findAll";
+    findAll.sql = "SELECT id, name, qty FROM upsert_items ORDER BY id";
+    findAll.type = StatementType::SELECT;
+    findAll.useCache = true;
+    upsertMapper.statements["findAll"] = findAll;
+    
+    StatementConfig renameItem;
+    renameItem.id = "renameItem";
+    renameItem.sql = "UPDATE upsert_items SET name = #{name} WHERE id = #{id}";
+    renameItem.type = StatementType::UPDATE;
+    upsertMapper.statements["renameItem"] = renameItem;
+    
+    StatementConfig insertQuiet = insertItem;
+    insertQuiet.id = "insertQuiet";
+    insertQuiet.flushCache = false;
+    upsertMapper.statements["insertQuiet"] = insertQuiet;
+    m_mapperRegistry->registerMapper("UpsertMapper", upsertMapper);
+    
+    auto session = createTestSession();
+    QCOMPARE(session->selectList("UpsertMapper.findAll").size(), 2);
+    
+    // 已有的行被更新，新行被插入
+    QList<QVariantMap> rows = {
+        {{"id", 1}, {"name", "uno"}, {"qty", 10}},
+        {{"id", 2}, {"name", "dos"}, {"qty", 20}},
+        {{"id", 3}, {"name", "tres"}, {"qty", 30}}
+    };
+    QCOMPARE(session->batchUpsert("UpsertMapper.insertItem", rows, {"id"}), 3);
+    
+    // 整批失效一次缓存，读取到新数据
+    QVariantList items = session->selectList("UpsertMapper.findAll");
+    QCOMPARE(items.size(), 3);
+    QCOMPARE(items[0].toMap().value("name").toString(), QString("uno"));
+    QCOMPARE(items[1].toMap().value("qty").toInt(), 20);
+    QCOMPARE(items[2].toMap().value("name").toString(), QString("tres"));
+    
+    // execBatch策略得到相同结果
+    rows = {
+        {{"id", 3}, {"name", "three"}, {"qty", 33}},
+        {{"id", 4}, {"name", "four"}, {"qty", 4}}
+    };
+    QCOMPARE(session->batchUpsert("UpsertMapper.insertItem", rows, {"id"}, BatchStrategy::ExecBatch), 2);
+    items = session->selectList("UpsertMapper.findAll");
+    QCOMPARE(items.size(), 4);
+    QCOMPARE(items[2].toMap().value("qty").toInt(), 33);
+    
+    // 多行VALUES中冲突键重复的行只保留最后一行
+    rows = {
+        {{"id", 5}, {"name", "five"}, {"qty", 5}},
+        {{"id", 4}, {"name", "cuatro"}, {"qty", 40}},
+        {{"id", 5}, {"name", "cinco"}, {"qty", 50}}
+    };
+    QCOMPARE(session->batchUpsert("UpsertMapper.insertItem", rows, {"id"}), 2);
+    items = session->selectList("UpsertMapper.findAll");
+    QCOMPARE(items.size(), 5);
+    QCOMPARE(items[3].toMap().value("name").toString(), QString("cuatro"));
+    QCOMPARE(items[4].toMap().value("name").toString(), QString("cinco"));
+    QCOMPARE(items[4].toMap().value("qty").toInt(), 50);
+    
+    // 没有冲突键或语句不是INSERT ... VALUES时报错
+    QVERIFY_EXCEPTION_THROWN(session->batchUpsert("UpsertMapper.insertItem", rows, {}), SessionException);
+    QVERIFY_EXCEPTION_THROWN(session->batchUpsert("UpsertMapper.renameItem", rows, {"id"}), SessionException);
+    QVERIFY(!session->isInTransaction());
+    
+    // 批量写入中途失败：已写入的行随外层事务提交，缓存在抛出前已失效
+    session->beginTransaction();
+    rows = {
+        {{"id", 6}, {"name", "six"}, {"qty", 6}},
+        {{"id", 1}, {"name", "duplicate"}, {"qty", 0}}
+    };
+    QVERIFY_EXCEPTION_THROWN(session->batchInsert("UpsertMapper.insertItem", rows), SessionException);
+    session->commit();
+    QCOMPARE(session->selectList("UpsertMapper.findAll").size(), 6);
+    
+    // flushCache=false的语句批量写入后不失效缓存
+    QCOMPARE(session->batchInsert("UpsertMapper.insertQuiet", {{{"id", 7}, {"name", "seven"}, {"qty", 7}}}), 1);
+    QCOMPARE(session->selectList("UpsertMapper.findAll").size(), 6);
+}
+
+void TestSession::testSelectPage()
+{
+    QSqlQuery setup(m_db);
+    QVERIFY(setup.exec("CREATE TABLE page_items (id INTEGER PRIMARY KEY, qty INTEGER)"));
+    for (int id = 1; id <= 30; ++id) {
+        QVERIFY(setup.exec(QString("INSERT INTO page_items (id, qty) VALUES (%1, %1)").arg(id)));
+    }
+    
+    MapperConfig pageMapper;
+    pageMapper.namespace_ = "PageMapper";
+    pageMapper.xmlPath = "test_page_mapper.xml";
+    
+    StatementConfig findByMinQty;
+    findByMinQty.id = "findByMinQty";
+    findByMinQty.sql = "SELECT id, qty FROM page_items WHERE qty >= #{minQty} ORDER BY id";
+    findByMinQty.type = StatementType::SELECT;
+    findByMinQty.useCache = true;
+    pageMapper.statements["findByMinQty"] = findByMinQty;
+    
+    StatementConfig insertItem;
+    insertItem.id = "insertItem";
+    insertItem.sql = "INSERT INTO page_items (id, qty) VALUES (#{id}, #{qty})";
+    insertItem.type = StatementType::INSERT;
+    pageMapper.statements["insertItem"] = insertItem;
+    
+    StatementConfig topFive;
+    topFive.id = "topFive";
+    topFive.sql = "SELECT id FROM page_items ORDER BY qty DESC LIMIT 5";
+    topFive.type = StatementType::SELECT;
+    pageMapper.statements["topFive"] = topFive;
+    m_mapperRegistry->registerMapper("PageMapper", pageMapper);
+    
+    auto session = createTestSession();
+    const QVariantMap params = {{"minQty", 6}};
+    
+    // 总数25，每页10条
+    PageResult first = session->selectPage("PageMapper.findByMinQty", params, 1, 10);
+    QCOMPARE(first.total, qint64(25));
+    QCOMPARE(first.items.size(), 10);
+    QCOMPARE(first.items.first().toMap().value("id").toInt(), 6);
+    QCOMPARE(first.pageCount(), 3);
+    QVERIFY(first.hasNext());
+    
+    PageResult last = session->selectPage("PageMapper.findByMinQty", params, 3, 10);
+    QCOMPARE(last.items.size(), 5);
+    QCOMPARE(last.items.last().toMap().value("id").toInt(), 30);
+    QVERIFY(!last.hasNext());
+    
+    PageResult beyond = session->selectPage("PageMapper.findByMinQty", params, 4, 10);
+    QCOMPARE(beyond.total, qint64(25));
+    QVERIFY(beyond.items.isEmpty());
+    
+    // 绕过ORM的写入不改变表版本，翻页复用缓存的总数
+    QVERIFY(setup.exec("INSERT INTO page_items (id, qty) VALUES (31, 31)"));
+    QCOMPARE(session->selectPage("PageMapper.findByMinQty", params, 2, 10).total, qint64(25));
+    
+    // 通过ORM写入后表版本变化，重新计数
+    QCOMPARE(session->insert("PageMapper.insertItem", {{"id", 32}, {"qty", 32}}), 1);
+    PageResult recounted = session->selectPage("PageMapper.findByMinQty", params, 3, 10);
+    QCOMPARE(recounted.total, qint64(27));
+    QCOMPARE(recounted.items.size(), 7);
+    
+    QVERIFY_EXCEPTION_THROWN(session->selectPage("PageMapper.findByMinQty", params, 0, 10), SessionException);
+    QVERIFY_EXCEPTION_THROWN(session->selectPage("PageMapper.findByMinQty", params, 1, 0), SessionException);
+    
+    // SQL Server的OFFSET/FETCH需要ORDER BY，子查询中的排序不算
+    QCOMPARE(Executor::pageSql("SELECT id FROM page_items", QSqlDriver::MSSqlServer),
+             QString("SELECT id FROM page_items ORDER BY (SELECT NULL) "
+                     "OFFSET #{_pageOffset} ROWS FETCH NEXT #{_pageLimit} ROWS ONLY"));
+    QCOMPARE(Executor::pageSql("SELECT id FROM (SELECT TOP 5 id FROM page_items ORDER BY qty) t",
+                               QSqlDriver::MSSqlServer),
+             QString("SELECT id FROM (SELECT TOP 5 id FROM page_items ORDER BY qty) t ORDER BY (SELECT NULL) "
+                     "OFFSET #{_pageOffset} ROWS FETCH NEXT #{_pageLimit} ROWS ONLY"));
+    QCOMPARE(Executor::pageSql("SELECT id FROM page_items ORDER BY id", QSqlDriver::MSSqlServer),
+             QString("SELECT id FROM page_items ORDER BY id "
+                     "OFFSET #{_pageOffset} ROWS FETCH NEXT #{_pageLimit} ROWS ONLY"));
+    QCOMPARE(Executor::pageSql("SELECT id FROM page_items", QSqlDriver::SQLite),
+             QString("SELECT id FROM page_items LIMIT #{_pageLimit} OFFSET #{_pageOffset}"));
+    
+    // 语句自带的行数限制与分页冲突，直接拒绝；子查询中的限制和名为limit的参数不受影响
+    QVERIFY_EXCEPTION_THROWN(Executor::pageSql("SELECT id FROM page_items ORDER BY id LIMIT 5", QSqlDriver::SQLite),
+                             SqlExecutionException);
+    QVERIFY_EXCEPTION_THROWN(Executor::pageSql("SELECT id FROM page_items ORDER BY id "
+                                               "OFFSET 0 ROWS FETCH NEXT 5 ROWS ONLY", QSqlDriver::MSSqlServer),
+                             SqlExecutionException);
+    QCOMPARE(Executor::pageSql("SELECT id FROM (SELECT id FROM page_items ORDER BY id LIMIT 5) t",
+                               QSqlDriver::SQLite),
+             QString("SELECT id FROM (SELECT id FROM page_items ORDER BY id LIMIT 5) t "
+                     "LIMIT #{_pageLimit} OFFSET #{_pageOffset}"));
+    QCOMPARE(Executor::pageSql("SELECT id FROM page_items WHERE qty < #{limit}", QSqlDriver::SQLite),
+             QString("SELECT id FROM page_items WHERE qty < #{limit} LIMIT #{_pageLimit} OFFSET #{_pageOffset}"));
+    QVERIFY_EXCEPTION_THROWN(session->selectPage("PageMapper.topFive", {}, 1, 2), SessionException);
+}
+
+void TestSession::testQueryTimeoutAndCancellation()
+{
+    MapperConfig slowMapper;
+    slowMapper.namespace_ = "SlowMapper";
+    slowMapper.xmlPath = "test_slow_mapper.xml";
+    
+    StatementConfig countTo;
+    countTo.id = "countTo";
+    countTo.sql = "WITH RECURSIVE n(x) AS (SELECT 1 UNION ALL SELECT x + 1 FROM n WHERE x < #{limit}) "
+                  "SELECT COUNT(*) AS total FROM n";
+    countTo.type = StatementType::SELECT;
+    slowMapper.statements["countTo"] = countTo;
+    
+    StatementConfig insertUser;
+    insertUser.id = "insertUser";
+    insertUser.sql = "INSERT INTO users (id, name, email) VALUES (#{id}, #{name}, #{email})";
+    insertUser.type = StatementType::INSERT;
+    slowMapper.statements["insertUser"] = insertUser;
+    m_mapperRegistry->registerMapper("SlowMapper", slowMapper);
+    
+    auto session = createTestSession();
+    const QVariantMap small = {{"limit", 10}};
+    const QVariantMap large = {{"limit", 20000000}};
+    
+    // 已取消的令牌：语句不会开始执行
+    CancellationToken token = CancellationToken::create();
+    token.cancel();
+    session->setCancellationToken(token);
+    try {
+        session->selectOne("SlowMapper.countTo", small);
+        QFAIL("Expected TimeoutException");
+    } catch (const TimeoutException& e) {
+        QCOMPARE(e.code(), QString("QUERY_CANCELLED"));
+    }
+    
+    // 批量写入同样受令牌约束，一行都不会写入
+    const QList<QVariantMap> rows = {
+        {{"id", 901}, {"name", "Batch A"}, {"email", "a@example.com"}},
+        {{"id", 902}, {"name", "Batch B"}, {"email", "b@example.com"}}
+    };
+    try {
+        session->batchInsert("SlowMapper.insertUser", rows);
+        QFAIL("Expected TimeoutException");
+    } catch (const TimeoutException& e) {
+        QCOMPARE(e.code(), QString("QUERY_CANCELLED"));
+    }
+    QSqlQuery countUsers(m_db);
+    QVERIFY(countUsers.exec("SELECT COUNT(*) FROM users WHERE id >= 901"));
+    QVERIFY(countUsers.next());
+    QCOMPARE(countUsers.value(0).toInt(), 0);
+    
+    // 清除令牌后会话照常可用
+    session->setCancellationToken(CancellationToken());
+    QCOMPARE(session->selectOne("SlowMapper.countTo", small).toMap().value("total").toInt(), 10);
+    
+    // 超时：只有链接了SQLite库（WITH_SQLITE_INTERRUPT）时语句才会被中断
+    session->setQueryTimeout(50);
+    QCOMPARE(session->queryTimeout(), 50);
+    bool interrupted = false;
+    try {
+        session->selectOne("SlowMapper.countTo", large);
+    } catch (const TimeoutException& e) {
+        QCOMPARE(e.code(), QString("QUERY_TIMEOUT"));
+        interrupted = true;
+    }
+    session->setQueryTimeout(0);
+    if (!interrupted) {
+        QSKIP("SQLite interrupt support is not compiled in");
+    }
+    
+    // 超时后连接仍可使用
+    QCOMPARE(session->selectOne("SlowMapper.countTo", small).toMap().value("total").toInt(), 10);
+    
+    // 从另一个线程取消正在执行的语句
+    CancellationToken running = CancellationToken::create();
+    session->setCancellationToken(running);
+    std::thread canceller([running]() mutable {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        running.cancel();
+    });
+    try {
+        session->selectOne("SlowMapper.countTo", large);
+        canceller.join();
+        QFAIL("Expected TimeoutException");
+    } catch (const TimeoutException& e) {
+        canceller.join();
+        QCOMPARE(e.code(), QString("QUERY_CANCELLED"));
+    }
+    session->setCancellationToken(CancellationToken());
+    QCOMPARE(session->selectOne("SlowMapper.countTo", small).toMap().value("total").toInt(), 10);
+}
+
+void TestSession::testGeneratedKeys()
+{
+    QSqlQuery setup(m_db);
+    QVERIFY(setup.exec("CREATE TABLE keyed_items (id INTEGER PRIMARY KEY AUTOINCREMENT, name TEXT)"));
+    
+    MapperConfig keyedMapper;
+    keyedMapper.namespace_ = "KeyedMapper";
+    keyedMapper.xmlPath = "test_keyed_mapper.xml";
+    
+    StatementConfig insertItem;
+    insertItem.id = "insertItem";
+    insertItem.sql = "INSERT INTO keyed_items (name) VALUES (#{name})";
+    insertItem.type = StatementType::INSERT;
+    insertItem.useGeneratedKeys = true;
+    insertItem.keyProperty = "id";
+    keyedMapper.statements["insertItem"] = insertItem;
+    
+    StatementConfig plainInsert = insertItem;
+    plainInsert.id = "plainInsert";
+    plainInsert.useGeneratedKeys = false;
+    keyedMapper.statements["plainInsert"] = plainInsert;
+    m_mapperRegistry->registerMapper("KeyedMapper", keyedMapper);
+    
+    auto session = createTestSession();
+    
+    // 单行插入：lastInsertId
+    QVariantList keys = session->insertWithKeys("KeyedMapper.insertItem", {{"name", "first"}});
+    QCOMPARE(keys.size(), 1);
+    QCOMPARE(keys.first().toLongLong(), qint64(1));
+    
+    // 批量插入：execBatch逐行，多行VALUES在SQLite 3.35+上使用RETURNING
+    const QList<QVariantMap> rows = {{{"name", "a"}}, {{"name", "b"}}, {{"name", "c"}}};
+    BatchResult execBatch = session->batchInsertWithResult("KeyedMapper.insertItem", rows, BatchStrategy::ExecBatch);
+    QCOMPARE(execBatch.totalAffected, 3);
+    QCOMPARE(execBatch.generatedKeys.size(), 3);
+    QCOMPARE(execBatch.generatedKeys.first().toLongLong(), qint64(2));
+    QCOMPARE(execBatch.generatedKeys.last().toLongLong(), qint64(4));
+    
+    BatchResult multiRow = session->batchInsertWithResult("KeyedMapper.insertItem", rows,
+                                                          BatchStrategy::MultiRowValues);
+    QCOMPARE(multiRow.totalAffected, 3);
+    QCOMPARE(multiRow.generatedKeys.size(), 3);
+    for (int i = 0; i < 3; ++i) {
+        QCOMPARE(multiRow.generatedKeys.at(i).toLongLong(), qint64(5 + i));
+    }
+    
+    // 未开启useGeneratedKeys的语句不返回批量键
+    BatchResult plain = session->batchInsertWithResult("KeyedMapper.plainInsert", rows);
+    QCOMPARE(plain.totalAffected, 3);
+    QVERIFY(plain.generatedKeys.isEmpty());
+}
+
+void TestSession::testStatementHandles()
+{
+    QSqlQuery setup(m_db);
+    QVERIFY(setup.exec("CREATE TABLE handle_items (id INTEGER PRIMARY KEY, name TEXT, qty INTEGER)"));
+    
+    MapperConfig handleMapper;
+    handleMapper.namespace_ = "HandleMapper";
+    handleMapper.xmlPath = "test_handle_mapper.xml";
+    
+    StatementConfig findById;
+    findById.id = "findById";
+    findById.sql = "SELECT id, name, qty FROM handle_items WHERE id = #{id}";
+    findById.type = StatementType::SELECT;
+    handleMapper.statements["findById"] = findById;
+    
+    StatementConfig findAll;
+    findAll.id = "findAll";
+    findAll.sql = "SELECT id, name, qty FROM handle_items ORDER BY id";
+    findAll.type = StatementType::SELECT;
+    findAll.useCache = true;
+    handleMapper.statements["findAll"] = findAll;
+    
+    StatementConfig findFiltered;
+    findFiltered.id = "findFiltered";
+    findFiltered.sql = "SELECT id FROM handle_items <where><if test=\"minQty\">qty >= #{minQty}</if></where> ORDER BY id";
+    findFiltered.type = StatementType::SELECT;
+    handleMapper.statements["findFiltered"] = findFiltered;
+    
+    StatementConfig insertItem;
+    insertItem.id = "insertItem";
+    insertItem.sql = "INSERT INTO handle_items (id, name, qty) VALUES (#{id}, #{name}, #{qty})";
+    insertItem.type = StatementType::INSERT;
+    handleMapper.statements["insertItem"] = insertItem;
+    
+    StatementConfig updateQty;
+    updateQty.id = "updateQty";
+    updateQty.sql = "UPDATE handle_items SET qty = #{qty} WHERE id = #{id}";
+    updateQty.type = StatementType::UPDATE;
+    handleMapper.statements["updateQty"] = updateQty;
+    
+    StatementConfig deleteItem;
+    deleteItem.id = "deleteItem";
+    deleteItem.sql = "DELETE FROM handle_items WHERE id = #{id}";
+    deleteItem.type = StatementType::DELETE;
+    handleMapper.statements["deleteItem"] = deleteItem;
+    m_mapperRegistry->registerMapper("HandleMapper", handleMapper);
+    
+    // 解析一次：静态语句预先渲染并带有绑定计划与表集合
+    const StatementHandle byId = m_mapperRegistry->statement("HandleMapper.findById");
+    QVERIFY(byId.isValid());
+    QCOMPARE(byId.id(), QString("HandleMapper.findById"));
+    QCOMPARE(byId.type(), StatementType::SELECT);
+    QVERIFY(!byId.compiled()->dynamic);
+    QCOMPARE(byId.compiled()->processedSql, QString("SELECT id, name, qty FROM handle_items WHERE id = :id"));
+    QVERIFY(byId.compiled()->bindingPlan);
+    QVERIFY(byId.compiled()->tables.contains("handle_items", Qt::CaseInsensitive));
+    
+    const StatementHandle all = m_mapperRegistry->statement("HandleMapper.findAll");
+    const StatementHandle filtered = m_mapperRegistry->statement("HandleMapper.findFiltered");
+    const StatementHandle insertHandle = m_mapperRegistry->statement("HandleMapper.insertItem");
+    const StatementHandle updateHandle = m_mapperRegistry->statement("HandleMapper.updateQty");
+    const StatementHandle deleteHandle = m_mapperRegistry->statement("HandleMapper.deleteItem");
+    QVERIFY(filtered.compiled()->dynamic);
+    
+    QVERIFY_EXCEPTION_THROWN(m_mapperRegistry->statement("HandleMapper.missing"), MappingException);
+    QVERIFY_EXCEPTION_THROWN(m_mapperRegistry->statement("NoSuchMapper.findById"), MappingException);
+    
+    auto session = createTestSession();
+    
+    QCOMPARE(session->insert(insertHandle, {{"id", 1}, {"name", "a"}, {"qty", 5}}), 1);
+    QCOMPARE(session->insert(insertHandle, {{"id", 2}, {"name", "b"}, {"qty", 15}}), 1);
+    
+    // 与按ID调用结果一致
+    const QVariantMap row = session->selectOne(byId, {{"id", 2}}).toMap();
+    QCOMPARE(row.value("name").toString(), QString("b"));
+    QCOMPARE(session->selectOne(byId, {{"id", 2}}), session->selectOne("HandleMapper.findById", {{"id", 2}}));
+    
+    // 动态语句每次按参数渲染
+    QCOMPARE(session->selectList(filtered, {{"minQty", 10}}).size(), 1);
+    QCOMPARE(session->selectList(filtered).size(), 2);
+    
+    // 缓存的查询在句柄写操作后失效
+    QCOMPARE(session->selectList(all).size(), 2);
+    QCOMPARE(session->insert(insertHandle, {{"id", 3}, {"name", "c"}, {"qty", 25}}), 1);
+    QCOMPARE(session->selectList(all).size(), 3);
+    QCOMPARE(session->update(updateHandle, {{"id", 3}, {"qty", 30}}), 1);
+    QCOMPARE(session->selectList(all).last().toMap().value("qty").toInt(), 30);
+    QCOMPARE(session->remove(deleteHandle, {{"id", 3}}), 1);
+    QCOMPARE(session->selectList(all).size(), 2);
+    
+    // 静态语句要求提供所有 #{param}
+    QVERIFY_EXCEPTION_THROWN(session->selectOne(byId), SessionException);
+    QVERIFY_EXCEPTION_THROWN(session->selectOne(StatementHandle(), {{"id", 1}}), SessionException);
+    
+    // BATCH模式下句柄写操作同样进入队列
+    session->setExecutorType(ExecutorType::Batch);
+    QCOMPARE(session->insert(insertHandle, {{"id", 4}, {"name", "d"}, {"qty", 1}}), 0);
+    QCOMPARE(session->pendingBatchRows(), 1);
+    session->flushStatements();
+    session->setExecutorType(ExecutorType::Simple);
+    QCOMPARE(session->selectList(all).size(), 3);
+}
+
 QTEST_MAIN(TestSession)
 #include "run_session_test.moc"
\ No newline at end of file
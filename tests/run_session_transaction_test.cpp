@@ -433,6 +433,14 @@ void TestSessionTransactionStandalone::testSavepointErrors()
     // 释放不存在的保存点
     QVERIFY_EXCEPTION_THROWN(m_session->releaseSavepoint("nonexistent"), SqlExecutionException);
     
+    // 错误消息中的占位符已被替换
+    try {
+        m_session->releaseSavepoint("nonexistent");
+        QFAIL("Expected SqlExecutionException");
+    } catch (const SqlExecutionException& e) {
+        QCOMPARE(e.message(), QString("Savepoint 'nonexistent' not found"));
+    }
+    
     m_session->commit();
 }
 
@@ -8,6 +8,13 @@
 #include "QtMyBatisORM/session.h"
 #include "QtMyBatisORM/qtmybatisexception.h"
 #include "QtMyBatisORM/configurationmanager.h"
+#include "QtMyBatisORM/asyncexecutor.h"
+#include "QtMyBatisORM/connectionpool.h"
+#include "QtMyBatisORM/cachemanager.h"
+#include "QtMyBatisORM/mapperregistry.h"
+#include "QtMyBatisORM/keysetiterator.h"
+#include <QThread>
+#include <QSemaphore>
 
 using namespace QtMyBatisORM;
 
@@ -31,6 +38,10 @@ private slots:
     void testGetMapper();
     void testCloseFactory();
     void testActiveSessionCount();
+    void testAsyncExecutor();
+    void testAsyncApi();
+    void testExecuteParallel();
+    void testKeysetIterator();
 
 private:
     DatabaseConfig createTestConfig();
@@ -264,6 +275,233 @@ void TestSessionFactory::testActiveSessionCount()
     factory->close();
 }
 
+void TestSessionFactory::testAsyncExecutor()
+{
+    DatabaseConfig config = createTestConfig();
+    QSharedPointer<ConnectionPool> pool = QSharedPointer<ConnectionPool>::create(config);
+    const int idleConnections = pool->availableConnections();
+    AsyncExecutor executor(pool, QSharedPointer<CacheManager>::create(config),
+                           QSharedPointer<MapperRegistry>::create(), 1);
+    
+    // 任务在固定的工作线程上执行，不占用调用线程
+    QFuture<QThread*> first = executor.submit<QThread*>([](Session&) { return QThread::currentThread(); });
+    QFuture<int> inserted = executor.submit<int>([](Session& session) {
+        return session.execute("INSERT INTO test_table (name, value) VALUES ('async', 300)");
+    });
+    QFuture<QThread*> second = executor.submit<QThread*>([](Session&) { return QThread::currentThread(); });
+    
+    QVERIFY(first.result() != QThread::currentThread());
+    QCOMPARE(second.result(), first.result());
+    QCOMPARE(inserted.result(), 1);
+    
+    // 工作线程独占一个新连接，不取用共享队列中的连接
+    QCOMPARE(pool->usedConnections(), 1);
+    QCOMPARE(pool->availableConnections(), idleConnections);
+    
+    // 异常通过QFuture传回调用方
+    QFuture<int> failing = executor.submit<int>([](Session& session) {
+        return session.execute("INSERT INTO missing_table (id) VALUES (1)");
+    });
+    QVERIFY_EXCEPTION_THROWN(failing.waitForFinished(), QtMyBatisException);
+    
+    // 关闭后连接被释放，新任务直接失败
+    executor.shutdown();
+    QCOMPARE(pool->usedConnections(), 0);
+    QFuture<int> rejected = executor.submit<int>([](Session&) { return 1; });
+    QVERIFY_EXCEPTION_THROWN(rejected.waitForFinished(), ConnectionException);
+    
+    pool->close();
+}
+
+void TestSessionFactory::testAsyncApi()
+{
+    DatabaseConfig config = createTestConfig();
+    QSharedPointer<SessionFactory> factory = SessionFactory::create(config);
+    
+    QFuture<QVariantList> missing = factory->selectListAsync("Missing.statement");
+    QVERIFY_EXCEPTION_THROWN(missing.waitForFinished(), QtMyBatisException);
+    
+    factory->close();
+    QVERIFY_EXCEPTION_THROWN(factory->selectOneAsync("Missing.statement"), ConfigurationException);
+}
+
+void TestSessionFactory::testExecuteParallel()
+{
+    DatabaseConfig config = createTestConfig();
+    QSharedPointer<ConnectionPool> pool = QSharedPointer<ConnectionPool>::create(config);
+    AsyncExecutor executor(pool, QSharedPointer<CacheManager>::create(config),
+                           QSharedPointer<MapperRegistry>::create(), 1);
+    
+    // 扩容后的工作线程同时运行，每个线程独占一个连接
+    executor.ensureWorkers(3);
+    QCOMPARE(executor.workerCount(), 3);
+    QSemaphore arrived;
+    QSemaphore proceed;
+    QList<QFuture<QThread*>> futures;
+    for (int i = 0; i < 3; ++i) {
+        futures.append(executor.submit<QThread*>([&arrived, &proceed](Session&) {
+            arrived.release();
+            proceed.acquire();
+            return QThread::currentThread();
+        }));
+    }
+    QVERIFY(arrived.tryAcquire(3, 5000));
+    proceed.release(3);
+    QSet<QThread*> threads;
+    for (QFuture<QThread*>& future : futures) {
+        threads.insert(future.result());
+    }
+    QCOMPARE(threads.size(), 3);
+    
+    // 队列清空后扩容出的线程退出，连接归还，只剩核心工作线程
+    QTRY_COMPARE(pool->usedConnections(), 1);
+    QCOMPARE(executor.workerCount(), 1);
+    QCOMPARE(pool->spareConnections(), config.maxConnections - pool->totalConnections());
+    executor.shutdown();
+    pool->close();
+    
+    // 空闲连接占满容量时不再新建线程连接，也不关闭其他线程的空闲连接
+    DatabaseConfig fullConfig = createTestConfig();
+    fullConfig.maxConnections = 1;
+    fullConfig.minConnections = 1;
+    QSharedPointer<ConnectionPool> fullPool = QSharedPointer<ConnectionPool>::create(fullConfig);
+    QCOMPARE(fullPool->spareConnections(), 0);
+    QVERIFY_EXCEPTION_THROWN(fullPool->getThreadConnection(), ConnectionException);
+    QCOMPARE(fullPool->availableConnections(), 1);
+    fullPool->close();
+    
+    QSharedPointer<SessionFactory> factory = SessionFactory::create(config);
+    QVERIFY(factory->executeParallel({}).isEmpty());
+    QVERIFY_EXCEPTION_THROWN(factory->executeParallel({ {"Missing.first", {}}, {"Missing.second", {}} }),
+                             QtMyBatisException);
+    factory->close();
+    QVERIFY_EXCEPTION_THROWN(factory->executeParallel({ {"Missing.first", {}} }), ConfigurationException);
+}
+
+void TestSessionFactory::testKeysetIterator()
+{
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "keyset_setup");
+        db.setDatabaseName(m_dbPath);
+        QVERIFY(db.open());
+        QSqlQuery query(db);
+        QVERIFY(query.exec("CREATE TABLE keyset_items (grp INTEGER, seq INTEGER, PRIMARY KEY (grp, seq))"));
+        QVERIFY(db.transaction());
+        QVERIFY(query.prepare("INSERT INTO keyset_items (grp, seq) VALUES (?, ?)"));
+        for (int i = 0; i < 2500; ++i) {
+            query.bindValue(0, i % 7);
+            query.bindValue(1, i);
+            QVERIFY(query.exec());
+        }
+        QVERIFY(db.commit());
+        query.finish();
+        db.close();
+    }
+    QSqlDatabase::removeDatabase("keyset_setup");
+    
+    DatabaseConfig config = createTestConfig();
+    QSharedPointer<ConnectionPool> pool = QSharedPointer<ConnectionPool>::create(config);
+    QSharedPointer<MapperRegistry> registry = QSharedPointer<MapperRegistry>::create();
+    
+    MapperConfig keysetMapper;
+    keysetMapper.namespace_ = "Keyset";
+    keysetMapper.xmlPath = "test_keyset_mapper.xml";
+    StatementConfig findFrom;
+    findFrom.id = "findFrom";
+    findFrom.sql = "SELECT grp, seq FROM keyset_items WHERE seq >= #{minSeq} ORDER BY grp, seq";
+    findFrom.type = StatementType::SELECT;
+    keysetMapper.statements["findFrom"] = findFrom;
+    
+    StatementConfig findLate;
+    findLate.id = "findLate";
+    findLate.sql = "SELECT id FROM late_items ORDER BY id";
+    findLate.type = StatementType::SELECT;
+    keysetMapper.statements["findLate"] = findLate;
+    registry->registerMapper("Keyset", keysetMapper);
+    
+    QSharedPointer<AsyncExecutor> executor = QSharedPointer<AsyncExecutor>::create(
+        pool, QSharedPointer<CacheManager>::create(config), registry, 1);
+    
+    // 复合键：每页从上一页最后一行的键之后继续
+    {
+        KeysetIterator iterator(executor, "Keyset.findFrom", {"grp", "seq"}, {{"minSeq", 100}}, 1000);
+        QCOMPARE(iterator.pagesRequested(), 1);
+        
+        QList<int> pageSizes;
+        QPair<int, int> previous(-1, -1);
+        int rows = 0;
+        while (iterator.hasNext()) {
+            const QVariantList page = iterator.next();
+            // 交出当前页时下一页已经在后台读取
+            if (pageSizes.isEmpty()) {
+                QCOMPARE(iterator.pagesRequested(), 2);
+            }
+            pageSizes.append(page.size());
+            for (const QVariant& row : page) {
+                const QVariantMap map = row.toMap();
+                const QPair<int, int> key(map.value("grp").toInt(), map.value("seq").toInt());
+                QVERIFY(key > previous);
+                QVERIFY(key.second >= 100);
+                previous = key;
+                ++rows;
+            }
+        }
+        QCOMPARE(rows, 2400);
+        QCOMPARE(pageSizes, QList<int>({1000, 1000, 400}));
+        QVERIFY(iterator.next().isEmpty());
+    }
+    
+    // 单列键，最后一页恰好满页时多读一次空页结束
+    {
+        KeysetIterator iterator(executor, "Keyset.findFrom", {"seq"}, {{"minSeq", 0}}, 500);
+        int rows = 0;
+        int lastSeq = -1;
+        while (iterator.hasNext()) {
+            for (const QVariant& row : iterator.next()) {
+                const int seq = row.toMap().value("seq").toInt();
+                QVERIFY(seq > lastSeq);
+                lastSeq = seq;
+                ++rows;
+            }
+        }
+        QCOMPARE(rows, 2500);
+        QCOMPARE(iterator.pagesRequested(), 6);
+    }
+    
+    KeysetIterator missing(executor, "Keyset.missing", {"seq"});
+    QVERIFY_EXCEPTION_THROWN(missing.hasNext(), QtMyBatisException);
+    // 失败的页不会被当作扫描结束，再次调用重新读取同一页
+    QVERIFY_EXCEPTION_THROWN(missing.hasNext(), QtMyBatisException);
+    QCOMPARE(missing.pagesRequested(), 2);
+    
+    // 读取失败的原因消除后，重试从同一个键继续
+    {
+        KeysetIterator late(executor, "Keyset.findLate", {"id"}, {}, 2);
+        QVERIFY_EXCEPTION_THROWN(late.hasNext(), QtMyBatisException);
+        {
+            QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "keyset_late");
+            db.setDatabaseName(m_dbPath);
+            QVERIFY(db.open());
+            QSqlQuery query(db);
+            QVERIFY(query.exec("CREATE TABLE late_items (id INTEGER PRIMARY KEY)"));
+            QVERIFY(query.exec("INSERT INTO late_items (id) VALUES (1), (2), (3)"));
+            query.finish();
+            db.close();
+        }
+        QSqlDatabase::removeDatabase("keyset_late");
+        
+        int rows = 0;
+        while (late.hasNext()) {
+            rows += late.next().size();
+        }
+        QCOMPARE(rows, 3);
+    }
+    QVERIFY_EXCEPTION_THROWN(KeysetIterator(executor, "Keyset.findFrom", {}), ConfigurationException);
+    
+    executor->shutdown();
+    pool->close();
+}
+
 int main(int argc, char *argv[])
 {
     QCoreApplication app(argc, argv);
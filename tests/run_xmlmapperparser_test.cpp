@@ -3,6 +3,7 @@
 #include <QDir>
 #include "QtMyBatisORM/xmlmapperparser.h"
 #include "QtMyBatisORM/qtmybatisexception.h"
+#include "QtMyBatisORM/dynamicsqlprocessor.h"
 
 using namespace QtMyBatisORM;
 
@@ -19,6 +20,7 @@ private slots:
     void testDuplicateStatementIds();
     void testDynamicSqlElements();
     void testResultMapParsing();
+    void testStatementAttributes();
 
 private:
     XMLMapperParser m_parser;
@@ -212,6 +214,20 @@ void TestXMLMapperParser::testDynamicSqlElements()
         }
         QVERIFY(foundForeach);
         
+        // 语句在加载时已编译为语法树
+        QVERIFY(stmt1.sqlNode);
+        QVERIFY(stmt2.sqlNode);
+        
+        QVariantMap params;
+        params["name"] = "John";
+        QCOMPARE(DynamicSqlProcessor::process(stmt1.sqlNode, params).simplified(),
+                 QString("SELECT * FROM users WHERE 1=1 AND name = :name"));
+        
+        params.clear();
+        params["ids"] = QVariantList{1, 2};
+        QCOMPARE(DynamicSqlProcessor::process(stmt2.sqlNode, params).simplified(),
+                 QString("SELECT * FROM users WHERE id IN ( :ids_0 , :ids_1 )"));
+        
     } catch (const QtMyBatisException& e) {
         QFAIL(qPrintable(QString("Unexpected exception: %1").arg(e.message())));
     }
@@ -270,5 +286,59 @@ void TestXMLMapperParser::testResultMapParsing()
     }
 }
 
+void TestXMLMapperParser::testStatementAttributes()
+{
+    QString xml = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                  "<mapper namespace=\"com.example.UserMapper\">\n"
+                  "    <select id=\"selectDefault\">SELECT * FROM users</select>\n"
+                  "    <select id=\"selectTuned\" useCache=\"false\" flushCache=\"true\"\n"
+                  "            timeout=\"5\" fetchSize=\"100\" maxRows=\"50\">SELECT * FROM users</select>\n"
+                  "    <insert id=\"insertDefault\">INSERT INTO users (name) VALUES (#{name})</insert>\n"
+                  "    <update id=\"updateQuiet\" flushCache=\"false\">UPDATE users SET name = #{name}</update>\n"
+                  "    <insert id=\"insertKeyed\" useGeneratedKeys=\"true\" keyProperty=\"id\">"
+                  "INSERT INTO users (name) VALUES (#{name})</insert>\n"
+                  "</mapper>";
+    
+    QDomDocument doc;
+    QVERIFY(doc.setContent(xml));
+    
+    MapperConfig config = m_parser.parseMapperFromDocument(doc, "attributes.xml");
+    
+    // MyBatis默认值：查询使用缓存，增删改刷新缓存
+    const StatementConfig selectDefault = config.statements["selectDefault"];
+    QVERIFY(selectDefault.options().useCache);
+    QVERIFY(!selectDefault.options().flushCache);
+    QCOMPARE(selectDefault.timeout, 0);
+    QCOMPARE(selectDefault.fetchSize, 0);
+    QCOMPARE(selectDefault.maxRows, 0);
+    
+    const StatementOptions tuned = config.statements["selectTuned"].options();
+    QVERIFY(!tuned.useCache);
+    QVERIFY(tuned.flushCache);
+    QCOMPARE(tuned.timeout, 5);
+    QCOMPARE(tuned.fetchSize, 100);
+    QCOMPARE(tuned.maxRows, 50);
+    
+    QVERIFY(!config.statements["insertDefault"].options().useCache);
+    QVERIFY(config.statements["insertDefault"].options().flushCache);
+    QVERIFY(!config.statements["updateQuiet"].options().flushCache);
+    
+    // 生成键：keyColumn缺省时取keyProperty
+    QVERIFY(!config.statements["insertDefault"].useGeneratedKeys);
+    const StatementConfig keyed = config.statements["insertKeyed"];
+    QVERIFY(keyed.useGeneratedKeys);
+    QCOMPARE(keyed.keyProperty, QString("id"));
+    QCOMPARE(keyed.generatedKeyColumn(), QString("id"));
+    
+    // 非法数值在加载时报错
+    QString invalidXml = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                         "<mapper namespace=\"com.example.UserMapper\">\n"
+                         "    <select id=\"selectBad\" maxRows=\"-1\">SELECT * FROM users</select>\n"
+                         "</mapper>";
+    QDomDocument invalidDoc;
+    QVERIFY(invalidDoc.setContent(invalidXml));
+    QVERIFY_EXCEPTION_THROWN(m_parser.parseMapperFromDocument(invalidDoc, "invalid.xml"), ConfigurationException);
+}
+
 QTEST_MAIN(TestXMLMapperParser)
 #include "run_xmlmapperparser_test.moc"
\ No newline at end of file
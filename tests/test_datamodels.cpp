@@ -45,7 +45,8 @@ void TestDataModels::testStatementConfig()
     
     QCOMPARE(config.id, QString("selectUser"));
     QCOMPARE(config.type, StatementType::SELECT);
-    QVERIFY(!config.useCache); // 默认值
+    QVERIFY(!config.useCache.has_value()); // 默认值
+    QVERIFY(config.options().useCache);     // 未设置时查询使用缓存
 }
 
 void TestDataModels::testMapperConfig()